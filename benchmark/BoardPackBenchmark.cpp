@@ -0,0 +1,115 @@
+#include "QmsBoardPack.hpp"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QString>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/* Size and read throughput of a board pack: boards of a few sizes and mine densities are
+ * written with QmsBoardPack::saveToFile(), the file is opened again, and every board is read
+ * back in a shuffled order and checked against the one that was written */
+
+namespace {
+
+    struct PackShape {
+        int numberOfColumns;
+        int numberOfRows;
+        double mineRatio;
+    };
+
+    const PackShape PACK_SHAPES[]{{9, 9, 0.12}, {30, 16, 0.21}, {100, 100, 0.01}, {100, 100, 0.5}};
+    const size_t BOARD_COUNT{100000};
+
+    std::vector<QmsPackedBoard> randomBoards(const PackShape &packShape, std::mt19937 &generator) {
+        const int cellCount{packShape.numberOfColumns * packShape.numberOfRows};
+        const auto mineCount = static_cast<size_t>(cellCount * packShape.mineRatio);
+        std::vector<int> cells(static_cast<size_t>(cellCount));
+        for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+            cells[static_cast<size_t>(cellIndex)] = cellIndex;
+        }
+        std::vector<QmsPackedBoard> boards{};
+        boards.reserve(BOARD_COUNT);
+        for (size_t boardIndex = 0; boardIndex < BOARD_COUNT; boardIndex++) {
+            std::shuffle(cells.begin(), cells.end(), generator);
+            std::vector<int> mineCells{cells.begin(), cells.begin() + static_cast<std::ptrdiff_t>(mineCount)};
+            std::sort(mineCells.begin(), mineCells.end());
+            boards.push_back(QmsPackedBoard{packShape.numberOfColumns, packShape.numberOfRows, std::move(mineCells)});
+        }
+        return boards;
+    }
+
+    /* benchmarkPack() : Returns false if the pack could not be written or read,
+     * or if any board read back differs from the one that was written */
+    bool benchmarkPack(const PackShape &packShape, const QString &filePath, std::mt19937 &generator) {
+        const std::vector<QmsPackedBoard> boards{randomBoards(packShape, generator)};
+        const auto saveResult = QmsBoardPack::saveToFile(filePath, boards);
+        if (saveResult.first != SaveBoardPackResult::Success) {
+            std::fprintf(stderr, "%s\n", saveResult.second.c_str());
+            return false;
+        }
+        QmsBoardPack boardPack{};
+        const auto openResult = boardPack.open(filePath);
+        if (openResult.first != OpenBoardPackResult::Success) {
+            std::fprintf(stderr, "%s\n", openResult.second.c_str());
+            return false;
+        }
+        if (boardPack.boardCount() != boards.size()) {
+            std::fprintf(stderr, "%s holds %u boards instead of %zu\n", qPrintable(filePath), boardPack.boardCount(),
+                         boards.size());
+            return false;
+        }
+
+        std::vector<uint32_t> boardIndices(boards.size());
+        for (size_t boardIndex = 0; boardIndex < boardIndices.size(); boardIndex++) {
+            boardIndices[boardIndex] = static_cast<uint32_t>(boardIndex);
+        }
+        std::shuffle(boardIndices.begin(), boardIndices.end(), generator);
+        std::vector<QmsPackedBoard> readBoards(boards.size());
+        const auto startTime = std::chrono::steady_clock::now();
+        for (const auto &it : boardIndices) {
+            if (!boardPack.boardAt(it, readBoards[it])) {
+                std::fprintf(stderr, "Board %u of %s could not be read\n", it, qPrintable(filePath));
+                return false;
+            }
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - startTime};
+
+        for (size_t boardIndex = 0; boardIndex < boards.size(); boardIndex++) {
+            if ((readBoards[boardIndex].numberOfColumns != boards[boardIndex].numberOfColumns) ||
+                (readBoards[boardIndex].numberOfRows != boards[boardIndex].numberOfRows) ||
+                (readBoards[boardIndex].mineCells != boards[boardIndex].mineCells)) {
+                std::fprintf(stderr, "Board %zu of %s differs from the one that was written\n", boardIndex,
+                             qPrintable(filePath));
+                return false;
+            }
+        }
+        const double packSize{static_cast<double>(QFileInfo{filePath}.size())};
+        std::printf("%5dx%-5d %4.0f%% mines %10.2f bytes/board %10.2f ns/board %10.2f M boards/s\n",
+                    packShape.numberOfColumns, packShape.numberOfRows, packShape.mineRatio * 100,
+                    packSize / boards.size(), (elapsed.count() * 1e9) / boards.size(),
+                    (boards.size() / elapsed.count()) / 1e6);
+        std::fflush(stdout);
+        return true;
+    }
+}
+
+int main() {
+    QTemporaryDir temporaryDir{};
+    if (!temporaryDir.isValid()) {
+        std::fprintf(stderr, "Could not create a temporary directory\n");
+        return 1;
+    }
+    std::mt19937 generator{12345};
+    for (const auto &packShape : PACK_SHAPES) {
+        if (!benchmarkPack(packShape, QDir{temporaryDir.path()}.filePath("boards.qmsp"), generator)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "MineCoordinates.hpp"
+#include "MineCoordinateHash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/* Lookup throughput of the containers used to find a cell by its coordinates: a
+ * std::unordered_map like GameController's ButtonContainer, with the old xor hash and with
+ * MineCoordinateHash, and a flat vector indexed by y * columns + x like QmsCellGrid */
+
+namespace {
+
+    /* XorMineCoordinateHash : What MineCoordinateHash used to be, for comparison */
+    struct XorMineCoordinateHash {
+        std::size_t operator()(const MineCoordinates &mc) const {
+            return (std::hash<int>()(mc.X()) ^ (std::hash<int>()(mc.Y())));
+        }
+    };
+
+    struct BoardSize {
+        int numberOfColumns;
+        int numberOfRows;
+    };
+
+    const BoardSize BOARD_SIZES[]{{9, 9}, {30, 16}, {1000, 1000}};
+    const size_t LOOKUP_COUNT{2000000};
+
+    /* SLOW_LOOKUP_COUNT : For the xor hash on the largest board, where every lookup walks a
+     * chain of about a thousand cells, LOOKUP_COUNT lookups would take minutes (just filling
+     * that map, which has the same problem, already takes over a minute) */
+    const size_t SLOW_LOOKUP_COUNT{20000};
+
+    std::vector<MineCoordinates> shuffledCells(const BoardSize &boardSize) {
+        std::vector<MineCoordinates> cells{};
+        cells.reserve(static_cast<size_t>(boardSize.numberOfColumns) * static_cast<size_t>(boardSize.numberOfRows));
+        for (int rowIndex = 0; rowIndex < boardSize.numberOfRows; rowIndex++) {
+            for (int columnIndex = 0; columnIndex < boardSize.numberOfColumns; columnIndex++) {
+                cells.emplace_back(columnIndex, rowIndex);
+            }
+        }
+        std::shuffle(cells.begin(), cells.end(), std::mt19937{12345});
+        return cells;
+    }
+
+    void report(const char *containerName, const BoardSize &boardSize, size_t lookupCount, double elapsedSeconds,
+                long long checksum, size_t longestBucket) {
+        std::printf("%-28s %5dx%-5d %10.2f ns/lookup %10.2f M lookups/s  longest bucket %6zu  (checksum %lld)\n",
+                    containerName, boardSize.numberOfColumns, boardSize.numberOfRows, (elapsedSeconds * 1e9) / lookupCount,
+                    (lookupCount / elapsedSeconds) / 1e6, longestBucket, checksum);
+        std::fflush(stdout);
+    }
+
+    template<typename Hash>
+    void benchmarkMap(const char *containerName, const BoardSize &boardSize, const std::vector<MineCoordinates> &cells,
+                      size_t lookupCount) {
+        std::unordered_map<MineCoordinates, int, Hash> map{};
+        map.reserve(cells.size());
+        for (const auto &it : cells) {
+            map.emplace(it, (it.Y() * boardSize.numberOfColumns) + it.X());
+        }
+        size_t longestBucket{0};
+        for (size_t bucketIndex = 0; bucketIndex < map.bucket_count(); bucketIndex++) {
+            longestBucket = std::max(longestBucket, map.bucket_size(bucketIndex));
+        }
+        long long checksum{0};
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t lookupIndex = 0; lookupIndex < lookupCount; lookupIndex++) {
+            checksum += map.find(cells[lookupIndex % cells.size()])->second;
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - startTime};
+        report(containerName, boardSize, lookupCount, elapsed.count(), checksum, longestBucket);
+    }
+
+    void benchmarkFlatIndex(const BoardSize &boardSize, const std::vector<MineCoordinates> &cells) {
+        std::vector<int> grid(cells.size());
+        for (size_t cellIndex = 0; cellIndex < grid.size(); cellIndex++) {
+            grid[cellIndex] = static_cast<int>(cellIndex);
+        }
+        long long checksum{0};
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t lookupIndex = 0; lookupIndex < LOOKUP_COUNT; lookupIndex++) {
+            const MineCoordinates &coordinates = cells[lookupIndex % cells.size()];
+            checksum += grid[static_cast<size_t>((coordinates.Y() * boardSize.numberOfColumns) + coordinates.X())];
+        }
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - startTime};
+        report("y * columns + x", boardSize, LOOKUP_COUNT, elapsed.count(), checksum, 1);
+    }
+}
+
+int main() {
+    for (const auto &boardSize : BOARD_SIZES) {
+        const std::vector<MineCoordinates> cells{shuffledCells(boardSize)};
+        const bool isLargeBoard{cells.size() > 100000};
+        benchmarkMap<XorMineCoordinateHash>("unordered_map, xor hash", boardSize, cells,
+                                            isLargeBoard ? SLOW_LOOKUP_COUNT : LOOKUP_COUNT);
+        benchmarkMap<MineCoordinateHash>("unordered_map, packed key", boardSize, cells, LOOKUP_COUNT);
+        benchmarkFlatIndex(boardSize, cells);
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef QMINESWEEPER_COPYONWRITE_HPP
+#define QMINESWEEPER_COPYONWRITE_HPP
+
+#include <memory>
+#include <utility>
+
+/* CopyOnWrite : Value wrapper whose copies share a single instance of ValueType
+ * until one of them asks for write access, at which point that copy detaches
+ * with its own clone. Copying and moving are therefore always O(1) */
+template<typename ValueType>
+class CopyOnWrite {
+public:
+    CopyOnWrite() :
+            m_value{std::make_shared<ValueType>()} {
+
+    }
+
+    explicit CopyOnWrite(ValueType value) :
+            m_value{std::make_shared<ValueType>(std::move(value))} {
+
+    }
+
+    CopyOnWrite(const CopyOnWrite &rhs) = default;
+    CopyOnWrite(CopyOnWrite &&rhs) noexcept = default;
+    CopyOnWrite &operator=(const CopyOnWrite &rhs) = default;
+    CopyOnWrite &operator=(CopyOnWrite &&rhs) noexcept = default;
+    ~CopyOnWrite() = default;
+
+    inline const ValueType &read() const {
+        return *this->m_value;
+    }
+
+    inline const ValueType *operator->() const {
+        return this->m_value.get();
+    }
+
+    inline ValueType &write() {
+        if (this->m_value.use_count() != 1) {
+            this->m_value = std::make_shared<ValueType>(*this->m_value);
+        }
+        return *this->m_value;
+    }
+
+private:
+    std::shared_ptr<ValueType> m_value;
+};
+
+#endif //QMINESWEEPER_COPYONWRITE_HPP
@@ -9,6 +9,8 @@
 #include <list>
 #include <functional>
 
+#include "QmsFormat.hpp"
+
 class QmsGameState;
 
 struct TimePoint {
@@ -49,11 +51,6 @@ public:
 
     }
 
-    template<typename T>
-    static inline std::string toStdString(const T &item) {
-        return dynamic_cast<std::stringstream &>(std::stringstream{} << item).str();
-    }
-
     void start() {
         this->m_totalTime = 0;
         this->m_hours = 0;
@@ -145,26 +142,15 @@ public:
         if (!this->m_isPaused) {
             this->update();
         }
-        std::string returnString{""};
+        QmsFormatBuffer<4 * QmsFormat::INTEGER_CHARACTER_COUNT + 3> returnString{};
         if (this->m_hours != 0) {
-            returnString = toStdString(this->m_hours) + ':';
+            returnString.appendInteger(this->m_hours).append(':');
         }
-        returnString += toStdString(this->m_minutes)
-                        + ':'
-                        + toStdString(this->m_seconds)
-                        + '.';
-        long long int millisecond{this->m_milliseconds};
-        std::string millisecondsString{""};
-        if (millisecond < 10) {
-            millisecondsString = "00" + toStdString(millisecond);
-        } else if (millisecond < 100) {
-            millisecondsString = "0" + toStdString(millisecond);
-        } else {
-            millisecondsString = toStdString(millisecond);
-        }
-        returnString += millisecondsString.substr(0, millisecondDigits);
-
-        return returnString;
+        returnString.appendInteger(this->m_minutes).append(':').appendInteger(this->m_seconds).append('.');
+        const size_t millisecondsStart{returnString.length()};
+        returnString.appendInteger(this->m_milliseconds, 3);
+        returnString.truncate(millisecondsStart + millisecondDigits);
+        return returnString.toStdString();
     }
 
     long long int hours() {
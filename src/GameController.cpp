@@ -24,6 +24,7 @@
 #include <QMessageBox>
 
 #include <sstream>
+#include <algorithm>
 #include <QtCore/QCoreApplication>
 
 #include "QmsButton.hpp"
@@ -33,9 +34,11 @@
 #include "QmsUtilities.hpp"
 #include "QmsStrings.hpp"
 #include "GlobalDefinitions.hpp"
+#include "QmsInstrumentation.hpp"
+#include "QmsMetrics.hpp"
+#include "QmsFlightRecorder.hpp"
 
 const double GameController::s_DEFAULT_NUMBER_OF_MINES{81.0};
-const int GameController::s_GAME_TIMER_INTERVAL{100};
 const int GameController::s_NORMAL_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES{8};
 const int GameController::s_EDGE_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES{5};
 const int GameController::s_CORNER_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES{3};
@@ -50,8 +53,22 @@ GameController *gameController{nullptr};
 
 GameController::GameController(int columnCount, int rowCount) :
         m_qmsGameState{std::make_shared<QmsGameState>(columnCount, rowCount)},
-        m_mainWindow{nullptr} {
+        m_mineSweeperButtons{},
+        m_buttonPool{},
+        m_mainWindow{nullptr},
+        m_replayRecorder{},
+        m_boardSummary{},
+        m_boardSummaryChangePending{false},
+        m_presetMinePlacement{},
+        m_presetMinePlacementFirstClickSafe{true},
+        m_emptyMinesToCheck{},
+        m_checkingForEmptyMines{false},
+        m_replayPlaybackActive{false},
+        m_dispatchingReplayEvent{false},
+        m_boardInputBlocked{false} {
     this->connect(this, &GameController::gamePaused, this, &GameController::onGamePaused);
+    this->m_replayRecorder.beginRecording(columnCount, rowCount);
+    this->m_boardSummary.reset(columnCount, rowCount);
 }
 
 void GameController::initializeInstance(int columnCount, int rowCount) {
@@ -60,19 +77,6 @@ void GameController::initializeInstance(int columnCount, int rowCount) {
     }
 }
 
-void GameController::onMineSweeperButtonCreated(std::shared_ptr<QmsButton> msb) {
-    this->connect(msb.get(), &QmsButton::leftClicked, this, &GameController::onMineSweeperButtonLeftClicked);
-    this->connect(msb.get(), &QmsButton::rightClicked, this, &GameController::onMineSweeperButtonRightClicked);
-    this->connect(msb.get(), &QmsButton::leftClickReleased, this,
-                  &GameController::onMineSweeperButtonLeftClickReleased);
-    this->connect(msb.get(), &QmsButton::rightClickReleased, this,
-                  &GameController::onMineSweeperButtonRightClickReleased);
-    this->connect(msb.get(), &QmsButton::longLeftClickReleased, this,
-                  &GameController::onMineSweeperButtonLongLeftClickReleased);
-    this->connect(msb.get(), &QmsButton::longRightClickReleased, this,
-                  &GameController::onMineSweeperButtonLongLeftClickReleased);
-}
-
 int GameController::totalButtonCount() const {
     return this->m_qmsGameState->m_totalButtonCount;
 }
@@ -93,7 +97,7 @@ void GameController::setCustomMineRatio(float mineRatio) {
                 "setCustomMineRatio: mine ratio cannot be greater than or equal to 1 (" + toStdString(mineRatio) +
                 " >= 1)");
     }
-    this->m_qmsGameState->m_customMineRatio.reset(new float{mineRatio});
+    this->m_qmsGameState->m_customMineRatio = std::make_shared<float>(mineRatio);
     this->m_qmsGameState->m_numberOfMines = roundIntuitively(
             this->m_qmsGameState->m_numberOfColumns * this->m_qmsGameState->m_numberOfRows *
             (*this->m_qmsGameState->m_customMineRatio));
@@ -103,7 +107,10 @@ void GameController::setCustomMineRatio(float mineRatio) {
 }
 
 void GameController::onBoardResizeTriggered(int columns, int rows) {
+    QMS_INSTRUMENT_SCOPE("Board resize");
+    QmsFlightRecorder::record("Board resize");
     using namespace QmsUtilities;
+    this->finishReplayRecording();
     this->m_qmsGameState->m_numberOfColumns = columns;
     this->m_qmsGameState->m_numberOfRows = rows;
     if (this->m_qmsGameState->m_customMineRatio == nullptr) {
@@ -123,26 +130,36 @@ void GameController::onBoardResizeTriggered(int columns, int rows) {
                 (*this->m_qmsGameState->m_customMineRatio));
     }
     this->m_qmsGameState->m_userDisplayNumberOfMines = this->m_qmsGameState->m_numberOfMines;
-    this->m_qmsGameState->m_gameState = GameState::GameInactive;
-    this->m_qmsGameState->m_mineCoordinates.clear();
-    this->m_qmsGameState->m_mineSweeperButtons.clear();
+    this->setGameState(GameState::GameInactive);
+    this->m_qmsGameState->m_mineCoordinates = CopyOnWrite<std::set<MineCoordinates>>{};
+    this->m_qmsGameState->m_cells = QmsCellGrid{columns, rows};
+    this->m_boardSummary.reset(columns, rows);
+    this->scheduleBoardSummaryChanged();
+    this->m_presetMinePlacement.clear();
+    this->returnButtonsToPool();
+    this->m_boardInputBlocked = false;
     this->m_qmsGameState->m_initialClickFlag = true;
     this->m_qmsGameState->m_totalButtonCount =
             this->m_qmsGameState->m_numberOfColumns * this->m_qmsGameState->m_numberOfRows;
     this->m_qmsGameState->m_unopenedMineCount = this->m_qmsGameState->m_totalButtonCount;
+    this->publishCounterMetrics();
+    this->m_qmsGameState->m_stateHash.reset();
+    this->m_qmsGameState->m_filePath = "";
+    this->clearUndoHistory();
+    this->m_replayRecorder.beginRecording(columns, rows);
     emit(readyToBeginNewGame());
 }
 
 void GameController::onGamePaused() {
     if ((!this->m_qmsGameState->m_initialClickFlag) && (this->m_qmsGameState->m_gameState == GameState::GameActive)) {
-        this->m_qmsGameState->m_gameState = GameState::GamePaused;
+        this->setGameState(GameState::GamePaused);
         LOG_INFO() << "The game was paused";
     }
 }
 
 void GameController::onGameResumed() {
     if ((!this->m_qmsGameState->m_initialClickFlag) && (this->m_qmsGameState->m_gameState == GameState::GamePaused)) {
-        this->m_qmsGameState->m_gameState = GameState::GameActive;
+        this->setGameState(GameState::GameActive);
         LOG_INFO() << "The game was resumed";
     }
 }
@@ -152,10 +169,10 @@ int GameController::userDisplayNumberOfMines() const {
 }
 
 void GameController::onMineExplosionEventTriggered() {
-    this->m_qmsGameState->m_gameState = GameState::GameInactive;
-    for (auto &it : this->m_qmsGameState->m_mineSweeperButtons) {
-        it.second->setBlockClicks(true);
-    }
+    QmsMetrics::gamesLost.add();
+    QmsFlightRecorder::record("Game lost");
+    this->setGameState(GameState::GameInactive);
+    this->m_boardInputBlocked = true;
 }
 
 void GameController::setNumberOfMinesRemaining(int numberOfMinesRemaining) {
@@ -191,28 +208,73 @@ void GameController::setInitialClickFlag(bool initialClickFlag) {
     this->m_qmsGameState->m_initialClickFlag = initialClickFlag;
 }
 
-void GameController::addMineSweeperButton(int columnIndex, int rowIndex) {
+/* addMineSweeperButton() : Takes a button from the pool if there is one, and only creates
+ * a new one otherwise. Returns true if a new button was created, as only those still
+ * need their one-time setup (see MainWindow::populateMineField()) */
+bool GameController::addMineSweeperButton(int columnIndex, int rowIndex) {
     using namespace QmsUtilities;
     using namespace QmsStrings;
     try {
-        this->m_qmsGameState->m_mineSweeperButtons.emplace(std::make_pair(MineCoordinates(columnIndex, rowIndex),
-                                                                          std::make_shared<QmsButton>(columnIndex,
-                                                                                                      rowIndex,
-                                                                                                      nullptr)));
+        if (!this->m_buttonPool.empty()) {
+            std::shared_ptr<QmsButton> recycledButton{std::move(this->m_buttonPool.back())};
+            this->m_buttonPool.pop_back();
+            recycledButton->recycle(columnIndex, rowIndex);
+            this->m_mineSweeperButtons.emplace(MineCoordinates(columnIndex, rowIndex), std::move(recycledButton));
+            return false;
+        }
+        /* Buttons trimmed from the pool may still have events queued, so they are deleted
+         * from the event loop rather than as soon as the pool lets go of them */
+        this->m_mineSweeperButtons.emplace(MineCoordinates(columnIndex, rowIndex),
+                                           std::shared_ptr<QmsButton>{new QmsButton{columnIndex, rowIndex, nullptr},
+                                                                      [](QmsButton *button) { button->deleteLater(); }});
         LOG_DEBUG() << QString{"Added minesweeper button at (%1, %2)"}.arg(QS_NUMBER(columnIndex), QS_NUMBER(rowIndex));
+        return true;
     } catch (std::exception &e) {
         LOG_WARNING() << QString{
                 "std::exception caught in GameController::addMineSweeperButton(int, int), with first argument = %1, second argument = %2, and std::exception::what() = %3"}.arg(
                 QS_NUMBER(columnIndex), QS_NUMBER(rowIndex), e.what());
     }
+    return false;
+}
+
+/* spareMineSweeperButtons() : Buttons left in the pool once the board has been
+ * populated (the board shrank), which the MainWindow hides until they are needed */
+const std::vector<std::shared_ptr<QmsButton>> &GameController::spareMineSweeperButtons() const {
+    return this->m_buttonPool;
+}
+
+/* returnButtonsToPool() : Called when the board is resized. The buttons of the old board are
+ * sorted so that popping from the back of the pool hands them out in row-major order, so a
+ * board of the same size gets every button back at the coordinates (and layout cell) it had.
+ * The pool never keeps more buttons than the new board has cells; the rest are deleted */
+void GameController::returnButtonsToPool() {
+    const auto spareButtonCount = static_cast<std::ptrdiff_t>(this->m_buttonPool.size());
+    this->m_buttonPool.reserve(this->m_buttonPool.size() + this->m_mineSweeperButtons.size());
+    for (auto &it : this->m_mineSweeperButtons) {
+        this->m_buttonPool.push_back(std::move(it.second));
+    }
+    this->m_mineSweeperButtons.clear();
+    std::sort(this->m_buttonPool.begin() + spareButtonCount, this->m_buttonPool.end(),
+              [](const std::shared_ptr<QmsButton> &lhs, const std::shared_ptr<QmsButton> &rhs) {
+                  return ((lhs->rowIndex() > rhs->rowIndex()) ||
+                          ((lhs->rowIndex() == rhs->rowIndex()) && (lhs->columnIndex() > rhs->columnIndex())));
+              });
+    const auto excessButtonCount = static_cast<std::ptrdiff_t>(this->m_buttonPool.size()) -
+                                   (this->m_qmsGameState->m_numberOfColumns * this->m_qmsGameState->m_numberOfRows);
+    if (excessButtonCount > 0) {
+        for (auto it = this->m_buttonPool.begin(); it != this->m_buttonPool.begin() + excessButtonCount; ++it) {
+            (*it)->hide();
+        }
+        this->m_buttonPool.erase(this->m_buttonPool.begin(), this->m_buttonPool.begin() + excessButtonCount);
+    }
 }
 
 ButtonContainer &GameController::mineSweeperButtons() {
-    return this->m_qmsGameState->m_mineSweeperButtons;
+    return this->m_mineSweeperButtons;
 }
 
 const std::set<MineCoordinates> &GameController::mineCoordinates() {
-    return this->m_qmsGameState->m_mineCoordinates;
+    return this->m_qmsGameState->m_mineCoordinates.read();
 }
 
 const SteadyEventTimer &GameController::playTimer() const {
@@ -238,12 +300,13 @@ void GameController::pausePlayTimer() {
 
 std::shared_ptr<QmsButton> GameController::mineSweeperButtonAtIndex(const MineCoordinates &coordinates) const {
     using namespace QmsStrings;
-    if (this->mineInBounds(coordinates) && (this->m_qmsGameState->m_mineSweeperButtons.find(coordinates) !=
-                                            this->m_qmsGameState->m_mineSweeperButtons.end())) {
-        return this->m_qmsGameState->m_mineSweeperButtons.at(coordinates);
-    } else {
-        throw std::runtime_error(GENERIC_ERROR_MESSAGE);
+    if (this->mineInBounds(coordinates)) {
+        const auto foundButton = this->m_mineSweeperButtons.find(coordinates);
+        if (foundButton != this->m_mineSweeperButtons.end()) {
+            return foundButton->second;
+        }
     }
+    throw std::runtime_error(GENERIC_ERROR_MESSAGE);
 }
 
 std::shared_ptr<QmsButton> GameController::mineSweeperButtonAtIndex(int columnIndex, int rowIndex) const {
@@ -270,26 +333,129 @@ bool GameController::isEdgeButton(QmsButton *msbp) const {
             (msbp->rowIndex() == this->m_qmsGameState->m_numberOfRows - 1));
 }
 
+/* generateRandomMinePlacement() : Places the mines once the first click is known, so the first
+ * click is never a mine. A preset layout from a board pack is used as is, except that a mine
+ * under the first click is moved to the first free cell in row-major order, so a board is still
+ * the same for the same first click. A replay's layout already had that done when it was
+ * recorded, so it is used exactly as is */
 void GameController::generateRandomMinePlacement(QmsButton *msbp) {
     using namespace QmsUtilities;
+    if (!this->m_presetMinePlacement.empty()) {
+        std::set<MineCoordinates> &mineCoordinates = this->m_qmsGameState->m_mineCoordinates.write();
+        for (const auto &it : this->m_presetMinePlacement) {
+            if (mineCoordinates.emplace(it).second) {
+                this->m_qmsGameState->m_stateHash.toggleMine(this->cellIndex(it));
+            }
+        }
+        const MineCoordinates firstClick{*(msbp->mineCoordinates())};
+        if ((this->m_presetMinePlacementFirstClickSafe) && (mineCoordinates.count(firstClick) != 0)) {
+            for (int cellIndex = 0; cellIndex < this->m_qmsGameState->m_totalButtonCount; cellIndex++) {
+                const MineCoordinates freeCell{cellIndex % this->m_qmsGameState->m_numberOfColumns,
+                                               cellIndex / this->m_qmsGameState->m_numberOfColumns};
+                if ((!(freeCell == firstClick)) && (mineCoordinates.emplace(freeCell).second)) {
+                    mineCoordinates.erase(firstClick);
+                    this->m_qmsGameState->m_stateHash.toggleMine(this->cellIndex(firstClick));
+                    this->m_qmsGameState->m_stateHash.toggleMine(cellIndex);
+                    break;
+                }
+            }
+        }
+        return;
+    }
     MineCoordinates potentialMineCoordinates{0, 0};
-    while (this->m_qmsGameState->m_mineCoordinates.size() <
+    while (this->m_qmsGameState->m_mineCoordinates->size() <
            static_cast<unsigned int>(this->m_qmsGameState->m_numberOfMines)) {
         potentialMineCoordinates = MineCoordinates{randomBetween(0, this->m_qmsGameState->m_numberOfColumns - 1),
                                                    randomBetween(0, this->m_qmsGameState->m_numberOfRows - 1)};
         if (potentialMineCoordinates == *(msbp->mineCoordinates())) {
             continue;
-        } else {
-            this->m_qmsGameState->m_mineCoordinates.emplace(potentialMineCoordinates);
+        } else if (this->m_qmsGameState->m_mineCoordinates.write().emplace(potentialMineCoordinates).second) {
+            this->m_qmsGameState->m_stateHash.toggleMine(this->cellIndex(potentialMineCoordinates));
         }
     }
 }
 
 std::pair<SaveGameStateResult, std::string> GameController::saveGame(const QString &filePath) {
-    return this->m_qmsGameState->saveToFile(filePath);
+    QMS_INSTRUMENT_SCOPE("Save");
+    if ((filePath == this->m_qmsGameState->m_filePath) && (!this->stateChangedSinceLastSave())) {
+        LOG_DEBUG() << QString{"Game state is unchanged since it was last saved to %1, skipping save"}.arg(filePath);
+        return std::make_pair(SaveGameStateResult::Success, "");
+    }
+    auto result = this->m_qmsGameState->saveToFile(filePath);
+    if (result.first == SaveGameStateResult::Success) {
+        this->m_qmsGameState->m_savedStateHash = this->m_qmsGameState->m_stateHash.value();
+    } else {
+        //Nothing valid was written, so the next save to this path must not be skipped
+        this->m_qmsGameState->m_filePath = "";
+    }
+    return result;
+}
+
+uint64_t GameController::stateHash() const {
+    return this->m_qmsGameState->m_stateHash.value();
+}
+
+bool GameController::stateChangedSinceLastSave() const {
+    return (this->m_qmsGameState->m_filePath.isEmpty() ||
+            (this->m_qmsGameState->m_stateHash.value() != this->m_qmsGameState->m_savedStateHash));
+}
+
+/* notifyCellChanged() : Single entry point for every change to what the player can see on a cell
+ * (reveal, flag, question mark). Must be called right after the QmsButton has been updated, so the
+ * change can be copied into the cell grid and the state hash can be updated in O(1) */
+void GameController::notifyCellChanged(QmsButton *msbp) {
+    const int index{this->cellIndex(msbp)};
+    const QmsCellState previousState{this->m_qmsGameState->m_cells.at(index)};
+    QmsCellState newState{previousState};
+    newState.setHasFlag(msbp->hasFlag())
+            .setHasQuestionMark(msbp->hasQuestionMark())
+            .setIsRevealed(msbp->isRevealed());
+    if (newState == previousState) {
+        return;
+    }
+    this->m_qmsGameState->m_undoLog.recordCell(index, previousState);
+    this->m_qmsGameState->m_cells.set(index, newState);
+    this->m_qmsGameState->m_stateHash.changeCell(index, previousState.visibility(), newState.visibility());
+    this->m_boardSummary.changeCell(index, previousState.visibility(), newState.visibility());
+    this->scheduleBoardSummaryChanged();
+}
+
+const QmsBoardSummary &GameController::boardSummary() const {
+    return this->m_boardSummary;
+}
+
+/* scheduleBoardSummaryChanged() : A cascade changes many cells in one go, so
+ * boardSummaryChanged() is emitted once, from the event loop, for all of them */
+void GameController::scheduleBoardSummaryChanged() {
+    if (!this->m_boardSummaryChangePending) {
+        this->m_boardSummaryChangePending = true;
+        QMetaObject::invokeMethod(this, "notifyBoardSummaryChanged", Qt::QueuedConnection);
+    }
+}
+
+void GameController::notifyBoardSummaryChanged() {
+    this->m_boardSummaryChangePending = false;
+    emit(boardSummaryChanged());
+}
+
+QmsCellState GameController::cellState(const QmsButton *msbp) const {
+    return this->m_qmsGameState->m_cells.at(this->cellIndex(msbp));
+}
+
+int GameController::cellIndex(const QmsButton *msbp) const {
+    return this->cellIndex(msbp->columnIndex(), msbp->rowIndex());
+}
+
+int GameController::cellIndex(const MineCoordinates &coordinates) const {
+    return this->cellIndex(coordinates.X(), coordinates.Y());
+}
+
+int GameController::cellIndex(int columnIndex, int rowIndex) const {
+    return (rowIndex * this->m_qmsGameState->m_numberOfColumns) + columnIndex;
 }
 
 std::pair<LoadGameStateResult, std::string> GameController::loadGame(const QString &filePath) {
+    QMS_INSTRUMENT_SCOPE("Load");
     QmsGameState loadedState;
     const auto result = QmsGameState::loadFromFile(filePath, loadedState);
     if (result.first == LoadGameStateResult::Success) {
@@ -302,31 +468,48 @@ std::pair<LoadGameStateResult, std::string> GameController::loadGame(const QStri
 }
 
 void GameController::clearRandomMinePlacement() {
-    this->m_qmsGameState->m_mineCoordinates.clear();
+    this->m_qmsGameState->m_mineCoordinates = CopyOnWrite<std::set<MineCoordinates>>{};
 }
 
 void GameController::onGameReset() {
-    for (std::pair<const MineCoordinates, std::shared_ptr<QmsButton>> msbp : this->m_qmsGameState->m_mineSweeperButtons) {
+    QMS_INSTRUMENT_SCOPE("Game reset");
+    QmsFlightRecorder::record("Game reset");
+    this->finishReplayRecording();
+    for (std::pair<const MineCoordinates, std::shared_ptr<QmsButton>> msbp : this->m_mineSweeperButtons) {
         msbp.second->setHasFlag(false);
         msbp.second->setHasQuestionMark(false);
         msbp.second->setHasMine(false);
         msbp.second->setIsRevealed(false);
         msbp.second->setNumberOfSurroundingMines(0);
-        msbp.second->setBlockClicks(false);
     }
+    this->m_boardInputBlocked = false;
     clearRandomMinePlacement();
+    //A new game that was not started from a board pack gets a random placement again
+    this->clearPresetMinePlacement();
+    this->m_qmsGameState->m_cells.reset();
+    this->m_boardSummary.reset(this->m_qmsGameState->m_numberOfColumns, this->m_qmsGameState->m_numberOfRows);
+    this->scheduleBoardSummaryChanged();
     this->m_qmsGameState->m_initialClickFlag = true;
     this->m_qmsGameState->m_gameOver = false;
     this->m_qmsGameState->m_userDisplayNumberOfMines = this->m_qmsGameState->m_numberOfMines;
-    this->m_qmsGameState->m_gameState = GameState::GameInactive;
+    this->setGameState(GameState::GameInactive);
     this->m_qmsGameState->m_numberOfMovesMade = 0;
     this->m_qmsGameState->m_unopenedMineCount =
     this->m_qmsGameState->m_numberOfColumns * this->m_qmsGameState->m_numberOfRows;
+    this->publishCounterMetrics();
+    this->m_qmsGameState->m_stateHash.reset();
+    this->m_qmsGameState->m_filePath = "";
+    this->clearUndoHistory();
+    this->m_replayRecorder.beginRecording(this->m_qmsGameState->m_numberOfColumns, this->m_qmsGameState->m_numberOfRows);
 }
 
 void GameController::setGameOver(bool gameOver) {
-    this->m_qmsGameState->m_gameState = GameState::GameInactive;
+    this->setGameState(GameState::GameInactive);
     this->m_qmsGameState->m_gameOver = gameOver;
+    if (gameOver) {
+        this->finishReplayRecording();
+    }
+    emit(undoAvailabilityChanged(this->canUndo(), this->canRedo()));
 }
 
 bool GameController::gameOver() const {
@@ -334,7 +517,7 @@ bool GameController::gameOver() const {
 }
 
 bool GameController::coordinatePairExists(const MineCoordinates &coordinatesToCheck) const {
-    for (const auto &mc : this->m_qmsGameState->m_mineCoordinates) {
+    for (const auto &mc : this->m_qmsGameState->m_mineCoordinates.read()) {
         if (coordinatesToCheck == mc) {
             return true;
         }
@@ -344,34 +527,42 @@ bool GameController::coordinatePairExists(const MineCoordinates &coordinatesToCh
 
 void GameController::setNumberOfMovesMade(int numberOfMovesMade) {
     this->m_qmsGameState->m_numberOfMovesMade = numberOfMovesMade;
+    this->publishCounterMetrics();
 }
 
 void GameController::assignAllMines() {
     using namespace QmsStrings;
-    for (const auto &mc : this->m_qmsGameState->m_mineCoordinates) {
-        if (this->m_qmsGameState->m_mineSweeperButtons.find(mc) != this->m_qmsGameState->m_mineSweeperButtons.end()) {
-            this->m_qmsGameState->m_mineSweeperButtons.at(mc)->setHasMine(true);
+    for (const auto &mc : this->m_qmsGameState->m_mineCoordinates.read()) {
+        const auto foundButton = this->m_mineSweeperButtons.find(mc);
+        if (foundButton != this->m_mineSweeperButtons.end()) {
+            foundButton->second->setHasMine(true);
+            QmsCellState cellState{this->m_qmsGameState->m_cells.at(mc.X(), mc.Y())};
+            this->m_qmsGameState->m_cells.set(mc.X(), mc.Y(), cellState.setHasMine(true));
         } else {
             throw std::runtime_error(GENERIC_ERROR_MESSAGE);
         }
     }
 }
 
+/* determineNeighborMineCounts() : Counts are accumulated outwards from each mine on the cell grid,
+ * which only touches the neighbors of mines, then copied onto the QmsButtons in a single pass */
 void GameController::determineNeighborMineCounts() {
-    for (std::pair<MineCoordinates, std::shared_ptr<QmsButton> > msbp : this->m_qmsGameState->m_mineSweeperButtons) {
-        for (int columnI = msbp.second->columnIndex() - 1; columnI <= msbp.second->columnIndex() + 1; columnI++) {
-            for (int rowI = msbp.second->rowIndex() - 1; rowI <= msbp.second->rowIndex() + 1; rowI++) {
-                if ((columnI == msbp.second->columnIndex()) && (rowI == msbp.second->rowIndex())) {
+    QMS_INSTRUMENT_SCOPE("Neighbor counts");
+    QmsCellGrid &cells = this->m_qmsGameState->m_cells;
+    for (const auto &mc : this->m_qmsGameState->m_mineCoordinates.read()) {
+        for (int columnI = mc.X() - 1; columnI <= mc.X() + 1; columnI++) {
+            for (int rowI = mc.Y() - 1; rowI <= mc.Y() + 1; rowI++) {
+                if (((columnI == mc.X()) && (rowI == mc.Y())) || (!cells.inBounds(columnI, rowI))) {
                     continue;
-                } else if (mineInBounds(MineCoordinates{columnI, rowI})) {
-                    MineCoordinates minePairCheck{columnI, rowI};
-                    if (this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck)->hasMine()) {
-                        msbp.second->setNumberOfSurroundingMines(msbp.second->numberOfSurroundingMines() + 1);
-                    }
                 }
+                QmsCellState cellState{cells.at(columnI, rowI)};
+                cells.set(columnI, rowI, cellState.setNumberOfSurroundingMines(cellState.numberOfSurroundingMines() + 1));
             }
         }
     }
+    for (auto &it : this->m_mineSweeperButtons) {
+        it.second->setNumberOfSurroundingMines(cells.at(it.first.X(), it.first.Y()).numberOfSurroundingMines());
+    }
 }
 
 bool GameController::mineInBounds(const MineCoordinates &coordinatesToCheck) const {
@@ -387,22 +578,40 @@ bool GameController::mineInBounds(int columnIndex, int rowIndex) const {
     return mineInBounds(MineCoordinates{columnIndex, rowIndex});
 }
 
+/* checkForOtherEmptyMines() : Reveals the neighbors of an empty cell, and of every empty cell
+ * uncovered along the way. displayMineSquare() calls back in here for each of those, so instead
+ * of recursing, the cells still to be checked are kept on a stack and only the outermost call
+ * works through it, which keeps a cascade across a huge board from overflowing the call stack.
+ * Cells are checked for being revealed rather than checked, as the MainWindow may not have
+ * drawn them yet (see QmsProgressiveReveal) */
 void GameController::checkForOtherEmptyMines(QmsButton *msbp) {
-    for (int columnI = msbp->columnIndex() - 1; columnI <= msbp->columnIndex() + 1; columnI++) {
-        for (int rowI = msbp->rowIndex() - 1; rowI <= msbp->rowIndex() + 1; rowI++) {
-            if ((columnI == msbp->columnIndex()) && (rowI == msbp->rowIndex())) {
-                continue;
-            } else if (mineInBounds(columnI, rowI)) {
-                MineCoordinates minePairCheck{columnI, rowI};
-                if ((!this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck)->hasMine()) &&
-                    (!this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck)->isChecked()) &&
-                    (!this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck)->hasQuestionMark()) &&
-                    (!this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck)->hasFlag())) {
-                    this->m_mainWindow->displayMineSquare(this->m_qmsGameState->m_mineSweeperButtons.at(minePairCheck).get());
+    this->m_emptyMinesToCheck.push_back(msbp);
+    if (this->m_checkingForEmptyMines) {
+        return;
+    }
+    this->m_checkingForEmptyMines = true;
+    QMS_INSTRUMENT_SCOPE("Cascade");
+    //The cell the cascade starts from was already opened by displayMineSquare()
+    const int unopenedBeforeCascade{this->m_qmsGameState->m_unopenedMineCount + 1};
+    while (!this->m_emptyMinesToCheck.empty()) {
+        QmsButton *emptyMine{this->m_emptyMinesToCheck.back()};
+        this->m_emptyMinesToCheck.pop_back();
+        for (int columnI = emptyMine->columnIndex() - 1; columnI <= emptyMine->columnIndex() + 1; columnI++) {
+            for (int rowI = emptyMine->rowIndex() - 1; rowI <= emptyMine->rowIndex() + 1; rowI++) {
+                if ((columnI == emptyMine->columnIndex()) && (rowI == emptyMine->rowIndex())) {
+                    continue;
+                } else if (mineInBounds(columnI, rowI)) {
+                    QmsButton *neighbor{this->m_mineSweeperButtons.at(MineCoordinates{columnI, rowI}).get()};
+                    if ((!neighbor->hasMine()) && (!neighbor->isRevealed()) &&
+                        (!neighbor->hasQuestionMark()) && (!neighbor->hasFlag())) {
+                        this->m_mainWindow->displayMineSquare(neighbor);
+                    }
                 }
             }
         }
     }
+    this->m_checkingForEmptyMines = false;
+    QmsMetrics::cascadeSize.recordValue(static_cast<uint64_t>(std::max(0, unopenedBeforeCascade - this->m_qmsGameState->m_unopenedMineCount)));
 }
 
 void GameController::onMineSweeperButtonLeftClicked(QmsButton *msbp) {
@@ -417,13 +626,18 @@ void GameController::onMineSweeperButtonRightClicked(QmsButton *msbp) {
 
 void GameController::onMineSweeperButtonLeftClickReleased(QmsButton *msbp) {
     using namespace QmsStrings;
+    QMS_INSTRUMENT_SCOPE("Left click");
+    if (!this->acceptsPlayerInput()) {
+        return;
+    }
     if (this->m_qmsGameState->m_gameOver) {
         return;
     }
+    this->m_qmsGameState->m_undoLog.beginAction(this->currentCounters());
     if (this->m_qmsGameState->m_initialClickFlag) {
         this->generateRandomMinePlacement(msbp);
         this->m_qmsGameState->m_initialClickFlag = false;
-        this->m_qmsGameState->m_gameState = GameState::GameActive;
+        this->setGameState(GameState::GameActive);
         try {
             assignAllMines();
             determineNeighborMineCounts();
@@ -435,7 +649,9 @@ void GameController::onMineSweeperButtonLeftClickReleased(QmsButton *msbp) {
             QCoreApplication::exit(EXIT_FAILURE);
             _Exit(EXIT_FAILURE);
         }
-        this->m_qmsGameState->m_gameState = GameState::GameActive;
+        this->setGameState(GameState::GameActive);
+        QmsMetrics::gamesStarted.add();
+        QmsFlightRecorder::record("Game started", msbp->columnIndex(), msbp->rowIndex());
         emit(gameStarted());
     }
     if ((msbp->hasFlag()) || (msbp->hasQuestionMark())) {
@@ -457,15 +673,21 @@ void GameController::onMineSweeperButtonLeftClickReleased(QmsButton *msbp) {
                                       applicationIcons->FACE_ICON_WINKY);
         }
     }
+    this->commitUndoableAction();
     emit(userIsNoLongerIdle());
 }
 
 void GameController::onMineSweeperButtonRightClickReleased(QmsButton *msbp) {
     using namespace QmsUtilities;
     using namespace QmsStrings;
+    QMS_INSTRUMENT_SCOPE("Right click");
+    if (!this->acceptsPlayerInput()) {
+        return;
+    }
     if (this->m_qmsGameState->m_gameOver) {
         return;
     }
+    this->m_qmsGameState->m_undoLog.beginAction(this->currentCounters());
     if (this->m_qmsGameState->m_initialClickFlag) {
         this->generateRandomMinePlacement(msbp);
         try {
@@ -480,7 +702,9 @@ void GameController::onMineSweeperButtonRightClickReleased(QmsButton *msbp) {
             exit(EXIT_FAILURE);
         }
         this->m_qmsGameState->m_initialClickFlag = false;
-        this->m_qmsGameState->m_gameState = GameState::GameActive;
+        this->setGameState(GameState::GameActive);
+        QmsMetrics::gamesStarted.add();
+        QmsFlightRecorder::record("Game started", msbp->columnIndex(), msbp->rowIndex());
         emit(gameStarted());
     }
     if (msbp->isChecked() || msbp->isRevealed()) {
@@ -495,6 +719,8 @@ void GameController::onMineSweeperButtonRightClickReleased(QmsButton *msbp) {
         msbp->setHasFlag(true);
         decrementUserMineCount();
     }
+    this->notifyCellChanged(msbp);
+    this->commitUndoableAction();
     startResetIconTimer(static_cast<unsigned int>(this->s_DEFAULT_CRAZY_FACE_TIMEOUT),
                         applicationIcons->FACE_ICON_CRAZY);
     emit(this->userIsNoLongerIdle());
@@ -508,19 +734,263 @@ void GameController::onMineSweeperButtonLongRightClickReleased(QmsButton *msbp)
     return this->onMineSweeperButtonRightClickReleased(msbp);
 }
 
+const char *GameController::boardInputKindName(BoardInputKind kind) {
+    switch (kind) {
+        case BoardInputKind::LeftPressed:
+            return "Left pressed";
+        case BoardInputKind::RightPressed:
+            return "Right pressed";
+        case BoardInputKind::LeftReleased:
+            return "Left released";
+        case BoardInputKind::RightReleased:
+            return "Right released";
+        case BoardInputKind::LongLeftReleased:
+            return "Long left released";
+        case BoardInputKind::LongRightReleased:
+            return "Long right released";
+    }
+    return "Board input";
+}
+
+/* onBoardInput() : The single entry point for mouse input on the board, called by the
+ * QmsBoardInputDispatcher. Each input is recorded for the replay before it is acted on */
+void GameController::onBoardInput(BoardInputKind kind, QmsButton *msbp) {
+    QmsFlightRecorder::record(GameController::boardInputKindName(kind), msbp->columnIndex(), msbp->rowIndex());
+    QMS_INSTRUMENT_SCOPE("Board input");
+    const int cellIndex{this->cellIndex(msbp)};
+    switch (kind) {
+        case BoardInputKind::LeftPressed:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::LeftClicked, cellIndex);
+            this->onMineSweeperButtonLeftClicked(msbp);
+            break;
+        case BoardInputKind::RightPressed:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::RightClicked, cellIndex);
+            this->onMineSweeperButtonRightClicked(msbp);
+            break;
+        case BoardInputKind::LeftReleased:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::LeftClickReleased, cellIndex);
+            this->onMineSweeperButtonLeftClickReleased(msbp);
+            break;
+        case BoardInputKind::RightReleased:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::RightClickReleased, cellIndex);
+            this->onMineSweeperButtonRightClickReleased(msbp);
+            break;
+        case BoardInputKind::LongLeftReleased:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::LongLeftClickReleased, cellIndex);
+            this->onMineSweeperButtonLongLeftClickReleased(msbp);
+            break;
+        case BoardInputKind::LongRightReleased:
+            this->m_replayRecorder.recordEvent(ReplayEventKind::LongRightClickReleased, cellIndex);
+            this->onMineSweeperButtonLongRightClickReleased(msbp);
+            break;
+    }
+}
+
 void GameController::onMineDisplayed() {
-    if ((--this->m_qmsGameState->m_unopenedMineCount) == this->m_qmsGameState->m_numberOfMines) {
+    QmsMetrics::cellsRevealed.add();
+    const bool isWon{(--this->m_qmsGameState->m_unopenedMineCount) == this->m_qmsGameState->m_numberOfMines};
+    this->publishCounterMetrics();
+    if (isWon) {
         emit(winEvent());
     }
 }
 
 void GameController::onGameWon() {
-    this->m_qmsGameState->m_gameState = GameState::GameInactive;
+    QmsMetrics::gamesWon.add();
+    QmsFlightRecorder::record("Game won");
+    this->setGameState(GameState::GameInactive);
+}
+
+/* canUndo() : Moves can only be taken back while a game is in progress (active or
+ * paused by a menu), and never while a click is still being handled */
+bool GameController::canUndo() const {
+    return ((!this->m_qmsGameState->m_gameOver) && (!this->m_qmsGameState->m_initialClickFlag) &&
+            (!this->m_qmsGameState->m_undoLog.isRecording()) && this->m_qmsGameState->m_undoLog.canUndo());
+}
+
+bool GameController::canRedo() const {
+    return ((!this->m_qmsGameState->m_gameOver) && (!this->m_qmsGameState->m_initialClickFlag) &&
+            (!this->m_qmsGameState->m_undoLog.isRecording()) && this->m_qmsGameState->m_undoLog.canRedo());
+}
+
+/* onUndoRequested() : Puts every cell the last move touched (a whole cascade, if there was one)
+ * back into its previous state, along with the counters. The mine placement is kept, so the
+ * board stays the same game. The reverse of the move is pushed onto the redo stack */
+void GameController::onUndoRequested() {
+    QMS_INSTRUMENT_SCOPE("Undo");
+    if ((!this->acceptsPlayerInput()) || (!this->canUndo())) {
+        return;
+    }
+    this->m_replayRecorder.recordEvent(ReplayEventKind::Undo, 0);
+    QmsFlightRecorder::record("Undo");
+    QmsStateDelta delta{this->m_qmsGameState->m_undoLog.takeUndo()};
+    QmsStateDelta inverse{this->currentCounters()};
+    this->applyStateDelta(delta, inverse);
+    this->m_qmsGameState->m_undoLog.pushRedo(std::move(inverse));
+    LOG_DEBUG() << QString{"Undid a move that changed %1 cells"}.arg(QS_NUMBER(delta.cellCount()));
+    emit(undoAvailabilityChanged(this->canUndo(), this->canRedo()));
+    emit(userIsNoLongerIdle());
+}
+
+/* onRedoRequested() : Mirror image of onUndoRequested(), re-applying the last undone move */
+void GameController::onRedoRequested() {
+    QMS_INSTRUMENT_SCOPE("Redo");
+    if ((!this->acceptsPlayerInput()) || (!this->canRedo())) {
+        return;
+    }
+    this->m_replayRecorder.recordEvent(ReplayEventKind::Redo, 0);
+    QmsFlightRecorder::record("Redo");
+    QmsStateDelta delta{this->m_qmsGameState->m_undoLog.takeRedo()};
+    QmsStateDelta inverse{this->currentCounters()};
+    this->applyStateDelta(delta, inverse);
+    this->m_qmsGameState->m_undoLog.pushUndo(std::move(inverse));
+    LOG_DEBUG() << QString{"Redid a move that changed %1 cells"}.arg(QS_NUMBER(delta.cellCount()));
+    emit(undoAvailabilityChanged(this->canUndo(), this->canRedo()));
+    emit(userIsNoLongerIdle());
+}
+
+QmsGameCounters GameController::currentCounters() const {
+    return QmsGameCounters{this->m_qmsGameState->m_userDisplayNumberOfMines.value(),
+                           this->m_qmsGameState->m_numberOfMovesMade.value(),
+                           this->m_qmsGameState->m_unopenedMineCount};
+}
+
+/* applyStateDelta() : Writes each cell of delta into the grid, the state hash and the matching
+ * QmsButton, while recording the states being overwritten into inverse, then restores the counters */
+void GameController::applyStateDelta(const QmsStateDelta &delta, QmsStateDelta &inverse) {
+    QmsCellGrid &cells = this->m_qmsGameState->m_cells;
+    const int columns{cells.numberOfColumns()};
+    delta.forEachCell([this, &cells, &inverse, columns](int cellIndex, QmsCellState restoredState) {
+        const QmsCellState currentState{cells.at(cellIndex)};
+        inverse.appendCell(cellIndex, currentState);
+        cells.set(cellIndex, restoredState);
+        this->m_qmsGameState->m_stateHash.changeCell(cellIndex, currentState.visibility(), restoredState.visibility());
+        this->m_boardSummary.changeCell(cellIndex, currentState.visibility(), restoredState.visibility());
+        const auto foundButton = this->m_mineSweeperButtons.find(MineCoordinates{cellIndex % columns, cellIndex / columns});
+        if (foundButton != this->m_mineSweeperButtons.end()) {
+            this->m_mainWindow->restoreMineSquare(foundButton->second.get(), restoredState);
+        }
+    });
+    this->m_qmsGameState->m_userDisplayNumberOfMines = delta.counters().userDisplayNumberOfMines;
+    this->m_qmsGameState->m_numberOfMovesMade = delta.counters().numberOfMovesMade;
+    this->m_qmsGameState->m_unopenedMineCount = delta.counters().unopenedMineCount;
+    this->publishCounterMetrics();
+    this->scheduleBoardSummaryChanged();
+}
+
+void GameController::commitUndoableAction() {
+    if (this->m_qmsGameState->m_undoLog.commitAction()) {
+        emit(undoAvailabilityChanged(this->canUndo(), this->canRedo()));
+    }
+}
+
+void GameController::clearUndoHistory() {
+    this->m_qmsGameState->m_undoLog.clear();
+    emit(undoAvailabilityChanged(false, false));
+}
+
+/* setPresetMinePlacement() : Makes the next game on the current board use the passed in
+ * mines, given as row-major cell indices, instead of a random placement. Resizing the board,
+ * resetting the game or applying a saved one drops them again. Unless firstClickSafe is
+ * false (a replay), a mine under the first click is moved off of it */
+void GameController::setPresetMinePlacement(const std::vector<int> &mineCells, bool firstClickSafe) {
+    this->m_presetMinePlacement.clear();
+    this->m_presetMinePlacementFirstClickSafe = firstClickSafe;
+    for (const auto &it : mineCells) {
+        this->m_presetMinePlacement.emplace(it % this->m_qmsGameState->m_numberOfColumns,
+                                            it / this->m_qmsGameState->m_numberOfColumns);
+    }
+    this->m_qmsGameState->m_numberOfMines = static_cast<int>(this->m_presetMinePlacement.size());
+    this->m_qmsGameState->m_userDisplayNumberOfMines = this->m_qmsGameState->m_numberOfMines;
+}
+
+void GameController::clearPresetMinePlacement() {
+    this->m_presetMinePlacement.clear();
+}
+
+/* finishReplayRecording() : Ends the replay of the current game, saving it if the
+ * game got as far as placing mines. Safe to call when nothing is being recorded */
+void GameController::finishReplayRecording() {
+    if (!this->m_replayRecorder.isRecording()) {
+        return;
+    }
+    std::vector<int> mineCells{};
+    mineCells.reserve(this->m_qmsGameState->m_mineCoordinates->size());
+    for (const auto &it : this->m_qmsGameState->m_mineCoordinates.read()) {
+        mineCells.push_back(this->cellIndex(it));
+    }
+    this->m_replayRecorder.finishRecording(std::move(mineCells));
+}
+
+/* beginReplayPlayback() : Called once the board has been resized to the replay's dimensions.
+ * From here on, the first click places the recorded mines, nothing is recorded, and clicks
+ * on the board are ignored, so only dispatchReplayEvent() can change the game */
+void GameController::beginReplayPlayback(const QmsReplay &replay) {
+    this->m_replayRecorder.setEnabled(false);
+    this->setPresetMinePlacement(replay.mineCells(), false);
+    this->m_replayPlaybackActive = true;
+    LOG_INFO() << QString{"Beginning replay playback (%1x%2, %3 mines, %4 events)"}.arg(
+            QS_NUMBER(replay.numberOfColumns()), QS_NUMBER(replay.numberOfRows()),
+            QS_NUMBER(replay.mineCells().size()), QS_NUMBER(replay.events().size()));
+}
+
+/* endReplayPlayback() : The board should be set up for a new game afterwards,
+ * as the mine count of the replay may not match the board's usual mine count */
+void GameController::endReplayPlayback() {
+    this->clearPresetMinePlacement();
+    this->m_replayPlaybackActive = false;
+    this->m_replayRecorder.setEnabled(true);
+}
+
+bool GameController::isReplayPlaybackActive() const {
+    return this->m_replayPlaybackActive;
+}
+
+/* dispatchReplayEvent() : Routes a recorded event to the same handler onBoardInput()
+ * (or the Edit menu action) calls during play */
+void GameController::dispatchReplayEvent(const QmsReplayEvent &event) {
+    const auto foundButton = this->m_mineSweeperButtons.find(MineCoordinates{event.cellIndex % this->m_qmsGameState->m_numberOfColumns,
+                                                                             event.cellIndex / this->m_qmsGameState->m_numberOfColumns});
+    if (foundButton == this->m_mineSweeperButtons.end()) {
+        LOG_WARNING() << QString{"Replay event references cell %1, which is not on the board"}.arg(QS_NUMBER(event.cellIndex));
+        return;
+    }
+    QmsButton *msbp{foundButton->second.get()};
+    this->m_dispatchingReplayEvent = true;
+    switch (event.kind) {
+        case ReplayEventKind::LeftClicked:
+            this->onMineSweeperButtonLeftClicked(msbp);
+            break;
+        case ReplayEventKind::RightClicked:
+            this->onMineSweeperButtonRightClicked(msbp);
+            break;
+        case ReplayEventKind::LeftClickReleased:
+            this->onMineSweeperButtonLeftClickReleased(msbp);
+            break;
+        case ReplayEventKind::RightClickReleased:
+            this->onMineSweeperButtonRightClickReleased(msbp);
+            break;
+        case ReplayEventKind::LongLeftClickReleased:
+        case ReplayEventKind::LongRightClickReleased:
+            this->onMineSweeperButtonLongLeftClickReleased(msbp);
+            break;
+        case ReplayEventKind::Undo:
+            this->onUndoRequested();
+            break;
+        case ReplayEventKind::Redo:
+            this->onRedoRequested();
+            break;
+    }
+    this->m_dispatchingReplayEvent = false;
+}
+
+bool GameController::acceptsPlayerInput() const {
+    return ((!this->m_replayPlaybackActive) || this->m_dispatchingReplayEvent);
 }
 
 void GameController::onContextMenuActive() {
     if (this->m_qmsGameState->m_gameState == GameState::GameActive) {
-        this->m_qmsGameState->m_gameState = GameState::GamePaused;
+        this->setGameState(GameState::GamePaused);
         emit(gamePaused());
         this->gamePaused();
     }
@@ -529,7 +999,7 @@ void GameController::onContextMenuActive() {
 void GameController::onContextMenuInactive() {
     if ((this->m_qmsGameState->m_gameState == GameState::GamePaused) &&
         (!this->m_mainWindow->boardResizeDialogVisible())) {
-        this->m_qmsGameState->m_gameState = GameState::GameActive;
+        this->setGameState(GameState::GameActive);
         emit(gameResumed());
     }
 }
@@ -538,6 +1008,27 @@ GameState GameController::gameState() const {
     return this->m_qmsGameState->m_gameState;
 }
 
+/* setGameState() : Every change of the game state goes through here, so that
+ * pausedChanged() is emitted exactly when the game enters or leaves GamePaused,
+ * and gameStateChanged() exactly when the state is different from before */
+void GameController::setGameState(GameState gameState) {
+    const GameState previousGameState{this->m_qmsGameState->m_gameState};
+    const bool wasPaused{previousGameState == GameState::GamePaused};
+    this->m_qmsGameState->m_gameState = gameState;
+    if (wasPaused != (gameState == GameState::GamePaused)) {
+        emit(pausedChanged(!wasPaused));
+    }
+    if (previousGameState != gameState) {
+        emit(gameStateChanged(gameState));
+    }
+}
+
+/* isBoardInputBlocked() : Set once a mine explodes, so the whole board ignores
+ * clicks until the next game, by checking this one flag on every click */
+bool GameController::isBoardInputBlocked() const {
+    return this->m_boardInputBlocked;
+}
+
 void GameController::bindMainWindow(std::shared_ptr<MainWindow> mainWindow) {
     this->m_mainWindow.reset();
     this->m_mainWindow = mainWindow;
@@ -549,10 +1040,20 @@ int GameController::numberOfMovesMade() const {
 
 void GameController::incrementNumberOfMovesMade() {
     this->m_qmsGameState->m_numberOfMovesMade++;
+    QmsMetrics::movesMade.add();
+    this->publishCounterMetrics();
 }
 
 void GameController::decrementNumberOfMovesMade() {
     this->m_qmsGameState->m_numberOfMovesMade--;
+    this->publishCounterMetrics();
+}
+
+/* publishCounterMetrics() : Called wherever the moves made or the unopened cell count change,
+ * as the metrics snapshots are taken on another thread, which cannot read the game state */
+void GameController::publishCounterMetrics() const {
+    QmsMetrics::currentMovesMade.set(this->m_qmsGameState->m_numberOfMovesMade.value());
+    QmsMetrics::currentUnopenedCells.set(this->m_qmsGameState->m_unopenedMineCount);
 }
 
 void GameController::incrementUserMineCount() {
@@ -563,8 +1064,45 @@ void GameController::decrementUserMineCount() {
     this->m_qmsGameState->m_userDisplayNumberOfMines--;
 }
 
+/* applyGameState() : Adopts the passed in state in O(1), as the cells and mine
+ * placement are shared with it until either side writes to them. The counters keep
+ * their own event listeners (the LCDs), and only take on the new values. A custom mine
+ * ratio is a user preference rather than part of a game, so it is kept if the state has none */
 void GameController::applyGameState(const QmsGameState &state) {
+    QMS_INSTRUMENT_SCOPE("Apply game state");
+    if (&state == this->m_qmsGameState.get()) {
+        return;
+    }
+    //A loaded game did not start from an empty board, so it cannot be replayed
+    this->m_replayRecorder.cancelRecording();
+    this->clearPresetMinePlacement();
+    ChangeAwareInt userDisplayNumberOfMines{std::move(this->m_qmsGameState->m_userDisplayNumberOfMines)};
+    ChangeAwareInt numberOfMovesMade{std::move(this->m_qmsGameState->m_numberOfMovesMade)};
+    std::shared_ptr<const float> customMineRatio{this->m_qmsGameState->m_customMineRatio};
+    const bool wasPaused{this->m_qmsGameState->m_gameState == GameState::GamePaused};
     *this->m_qmsGameState = state;
+    this->m_boardInputBlocked = false;
+    if (!this->m_qmsGameState->m_customMineRatio) {
+        this->m_qmsGameState->m_customMineRatio = customMineRatio;
+    }
+    this->m_qmsGameState->m_userDisplayNumberOfMines = std::move(userDisplayNumberOfMines);
+    this->m_qmsGameState->m_numberOfMovesMade = std::move(numberOfMovesMade);
+    this->m_qmsGameState->m_userDisplayNumberOfMines = state.m_userDisplayNumberOfMines.value();
+    this->m_qmsGameState->m_numberOfMovesMade = state.m_numberOfMovesMade.value();
+    this->publishCounterMetrics();
+    this->m_boardSummary.rebuild(this->m_qmsGameState->m_cells);
+    this->scheduleBoardSummaryChanged();
+    emit(undoAvailabilityChanged(this->canUndo(), this->canRedo()));
+    if (wasPaused != (state.m_gameState == GameState::GamePaused)) {
+        emit(pausedChanged(!wasPaused));
+    }
+    emit(gameStateChanged(state.m_gameState));
+}
+
+/* gameStateSnapshot() : O(1) copy of the current game, suitable
+ * for saving, undoing or analysing without disturbing play */
+QmsGameState GameController::gameStateSnapshot() const {
+    return *this->m_qmsGameState;
 }
 
 ChangeAwareInt *GameController::userDisplayNumbersOfMinesDataSource() {
@@ -579,10 +1117,6 @@ double GameController::DEFAULT_NUMBER_OF_MINES() {
     return GameController::s_DEFAULT_NUMBER_OF_MINES;
 }
 
-int GameController::GAME_TIMER_INTERVAL() {
-    return GameController::s_GAME_TIMER_INTERVAL;
-}
-
 int GameController::NORMAL_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES() {
     return GameController::s_NORMAL_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES;
 }
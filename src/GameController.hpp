@@ -13,6 +13,10 @@
 #include "EventTimer.hpp"
 #include "QmsGameState.hpp"
 #include "MineCoordinateHash.hpp"
+#include "QmsCellState.hpp"
+#include "QmsReplay.hpp"
+#include "QmsReplayRecorder.hpp"
+#include "QmsBoardSummary.hpp"
 
 class QmsButton;
 class MineCoordinates;
@@ -20,6 +24,18 @@ class MainWindow;
 class QString;
 class QmsGameState;
 
+using ButtonContainer = std::unordered_map<MineCoordinates, std::shared_ptr<QmsButton>, MineCoordinateHash>;
+
+/* BoardInputKind : What the QmsBoardInputDispatcher saw happen on a cell */
+enum class BoardInputKind : uint8_t {
+    LeftPressed,
+    RightPressed,
+    LeftReleased,
+    RightReleased,
+    LongLeftReleased,
+    LongRightReleased
+};
+
 class GameController : public QObject {
 Q_OBJECT
 public:
@@ -51,7 +67,8 @@ public:
     void setNumberOfColumns(int numberOfColumns);
     void setNumberOfRows(int numberOfRows);
     void setInitialClickFlag(bool initialClickFlag);
-    void addMineSweeperButton(int columnIndex, int rowIndex);
+    bool addMineSweeperButton(int columnIndex, int rowIndex);
+    const std::vector<std::shared_ptr<QmsButton>> &spareMineSweeperButtons() const;
     void setGameOver(bool gameOver);
     int totalButtonCount() const;
     const SteadyEventTimer &playTimer() const;
@@ -75,18 +92,39 @@ public:
     bool isCornerButton(QmsButton *msb) const;
     bool isEdgeButton(QmsButton *msb) const;
     GameState gameState() const;
+    bool isBoardInputBlocked() const;
 
     void applyGameState(const QmsGameState &state);
+    QmsGameState gameStateSnapshot() const;
+    QmsCellState cellState(const QmsButton *msbp) const;
+    const QmsBoardSummary &boardSummary() const;
 
     void setCustomMineRatio(float mineRatio);
 
+    uint64_t stateHash() const;
+    bool stateChangedSinceLastSave() const;
+    void notifyCellChanged(QmsButton *msbp);
+    int cellIndex(const QmsButton *msbp) const;
+    int cellIndex(const MineCoordinates &coordinates) const;
+    int cellIndex(int columnIndex, int rowIndex) const;
+    bool canUndo() const;
+    bool canRedo() const;
+
+    void setPresetMinePlacement(const std::vector<int> &mineCells, bool firstClickSafe);
+    void clearPresetMinePlacement();
+    void finishReplayRecording();
+    void beginReplayPlayback(const QmsReplay &replay);
+    void endReplayPlayback();
+    bool isReplayPlaybackActive() const;
+    void dispatchReplayEvent(const QmsReplayEvent &event);
+    void onBoardInput(BoardInputKind kind, QmsButton *msbp);
+
     static void initializeInstance(int columnCount, int rowCount);
 
     std::pair<SaveGameStateResult, std::string> saveGame(const QString &filePath);
     std::pair<LoadGameStateResult, std::string> loadGame(const QString &filePath);
 
     static double DEFAULT_NUMBER_OF_MINES();
-    static int GAME_TIMER_INTERVAL();
     static int NORMAL_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES();
     static int EDGE_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES();
     static int CORNER_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES();
@@ -98,7 +136,6 @@ public:
     static int MILLISECOND_DELAY_DIGITS();
 
 public slots:
-    void onMineSweeperButtonCreated(std::shared_ptr<QmsButton> msbp);
     void onMineSweeperButtonLeftClicked(QmsButton *msbp);
     void onMineSweeperButtonRightClicked(QmsButton *msbp);
     void onMineSweeperButtonLeftClickReleased(QmsButton *msbp);
@@ -114,6 +151,8 @@ public slots:
     void onGameResumed();
     void onMineDisplayed();
     void onGameWon();
+    void onUndoRequested();
+    void onRedoRequested();
 
 signals:
     void gameStarted();
@@ -126,14 +165,32 @@ signals:
     void numberOfMinesRemainingChanged(int newNumber);
     void numberOfMovesMadeChanged(int newNumber);
     void customMineRatioSet(float mineRatio);
+    void undoAvailabilityChanged(bool canUndo, bool canRedo);
+    void pausedChanged(bool paused);
+    void gameStateChanged(GameState gameState);
     void loadGameCompleted(const std::pair<LoadGameStateResult, std::string> &loadResult, const QmsGameState &gameState);
+    void boardSummaryChanged();
+
+private slots:
+    void notifyBoardSummaryChanged();
 
 private:
     std::shared_ptr<QmsGameState> m_qmsGameState;
+    ButtonContainer m_mineSweeperButtons;
+    std::vector<std::shared_ptr<QmsButton>> m_buttonPool;
     std::shared_ptr<MainWindow> m_mainWindow;
+    QmsReplayRecorder m_replayRecorder;
+    QmsBoardSummary m_boardSummary;
+    bool m_boardSummaryChangePending;
+    std::set<MineCoordinates> m_presetMinePlacement;
+    bool m_presetMinePlacementFirstClickSafe;
+    std::vector<QmsButton *> m_emptyMinesToCheck;
+    bool m_checkingForEmptyMines;
+    bool m_replayPlaybackActive;
+    bool m_dispatchingReplayEvent;
+    bool m_boardInputBlocked;
 
     static const double s_DEFAULT_NUMBER_OF_MINES;
-    static const int s_GAME_TIMER_INTERVAL;
     static const int s_NORMAL_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES;
     static const int s_EDGE_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES;
     static const int s_CORNER_MINE_MAX_NUMBER_OF_NEIGHBOR_MINES;
@@ -144,6 +201,18 @@ private:
     static const int s_LONG_CLICK_THRESHOLD;
     static const int s_MILLISECOND_DISPLAY_DIGITS;
 
+    QmsGameCounters currentCounters() const;
+    void applyStateDelta(const QmsStateDelta &delta, QmsStateDelta &inverse);
+    void commitUndoableAction();
+    void clearUndoHistory();
+    bool acceptsPlayerInput() const;
+    void returnButtonsToPool();
+    void setGameState(GameState gameState);
+    void scheduleBoardSummaryChanged();
+    void publishCounterMetrics() const;
+
+    static const char *boardInputKindName(BoardInputKind kind);
+
     GameController(int columnCount, int rowCount);
     GameController(const GameController &other) = delete;
     GameController(GameController &&other) = delete;
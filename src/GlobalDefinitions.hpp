@@ -5,18 +5,28 @@
 #include <QString>
 #include <QtGlobal>
 
+#include "QmsLogLevel.hpp"
+
+/* QMS_LOG_IF : The level is checked before the stream expression, so a disabled LOG_DEBUG() does
+ * not build its QString at all. A level below QMS_COMPILED_LOG_LEVEL makes the condition a constant
+ * false, and the (still type checked) statement is removed by the compiler. Written as a loop that
+ * runs at most once, like Qt's own qCDebug(), so it is safe as the body of an if with an else */
+#define QMS_LOG_IF(logLevel, logStatement) \
+    for (bool qmsLogEnabled = ((static_cast<int>(logLevel) >= QMS_COMPILED_LOG_LEVEL) && QmsLogging::isEnabled(logLevel)); \
+         qmsLogEnabled; qmsLogEnabled = false) logStatement
+
 #if defined(USE_QT_LOG)
     #ifndef LOG_DEBUG
-    #    define LOG_DEBUG(x) qDebug(x)
+    #    define LOG_DEBUG(x) QMS_LOG_IF(QmsLogLevel::Debug, qDebug(x))
     #endif
     #ifndef LOG_INFO
-    #    define LOG_INFO(x) qInfo(x)
+    #    define LOG_INFO(x) QMS_LOG_IF(QmsLogLevel::Info, qInfo(x))
     #endif
     #ifndef LOG_WARNING
-    #    define LOG_WARNING(x) qWarning(x)
+    #    define LOG_WARNING(x) QMS_LOG_IF(QmsLogLevel::Warning, qWarning(x))
     #endif
     #ifndef LOG_CRITICAL
-    #    define LOG_CRITICAL(x) qCritical(x)
+    #    define LOG_CRITICAL(x) QMS_LOG_IF(QmsLogLevel::Critical, qCritical(x))
     #endif
     #ifndef LOG_FATAL
     #    define LOG_FATAL(x) qFatal(x)
@@ -27,16 +37,16 @@
     #endif
 #else
     #ifndef LOG_DEBUG
-    #    define LOG_DEBUG(x) Logger::createInstance(LogLevel::Debug, __FILE__, __LINE__, __func__)
+    #    define LOG_DEBUG(x) QMS_LOG_IF(QmsLogLevel::Debug, Logger::createInstance(LogLevel::Debug, __FILE__, __LINE__, __func__))
     #endif //LOG_FATAL
     #ifndef LOG_WARN
-    #    define LOG_WARN(x) Logger::createInstance(LogLevel::Warn, __FILE__, __LINE__, __func__)
+    #    define LOG_WARN(x) QMS_LOG_IF(QmsLogLevel::Warning, Logger::createInstance(LogLevel::Warn, __FILE__, __LINE__, __func__))
     #endif //LOG_WARN
     #ifndef LOG_CRITICAL
-    #    define LOG_CRITICAL(x) Logger::createInstance(LogLevel::Critical, __FILE__, __LINE__, __func__)
+    #    define LOG_CRITICAL(x) QMS_LOG_IF(QmsLogLevel::Critical, Logger::createInstance(LogLevel::Critical, __FILE__, __LINE__, __func__))
     #endif //LOG_CRITICAL
     #ifndef LOG_INFO
-    #    define LOG_INFO(x) Logger::createInstance(LogLevel::Info, __FILE__, __LINE__, __func__)
+    #    define LOG_INFO(x) QMS_LOG_IF(QmsLogLevel::Info, Logger::createInstance(LogLevel::Info, __FILE__, __LINE__, __func__))
     #endif //LOG_INFO
     #ifndef LOG_FATAL
     #    define LOG_FATAL(x) Logger::createInstance(LogLevel::Fatal, __FILE__, __LINE__, __func__)
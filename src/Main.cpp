@@ -25,6 +25,13 @@
 #include "GlobalDefinitions.hpp"
 #include "QmsApplicationSettings.hpp"
 #include "StaticLogger.hpp"
+#include "QmsLogSink.hpp"
+#include "QmsAllocationTracker.hpp"
+#include "QmsTraceRecorder.hpp"
+#include "QmsApplication.hpp"
+#include "QmsMetrics.hpp"
+#include "QmsEventLoopWatchdog.hpp"
+#include "QmsFlightRecorder.hpp"
 #include "ProgramOption.hpp"
 
 #include <getopt.h>
@@ -48,6 +55,12 @@ static const ProgramOption helpOption          {'h', "help", no_argument, "Displ
 static const ProgramOption versionOption       {'v', "version", no_argument, "Display version text and exit"};
 static const ProgramOption dimensionsOption    {'d', "dimensions", required_argument, "Specify startup game board size"};
 static const ProgramOption mineRatioOption     {'r', "ratio", required_argument, "Specify decimal ratio to use for mines (between 0 and 1)"};
+static const ProgramOption packOption          {'p', "pack", required_argument, "Play a board from the specified board pack"};
+static const ProgramOption packIndexOption     {'i', "pack-index", required_argument, "Specify which board of the board pack to play (default 0)"};
+static const ProgramOption traceOption         {'t', "trace", required_argument, "Record a Chrome trace to the specified file (written when the program quits, or on SIGUSR1)"};
+static const ProgramOption metricsFileOption   {'m', "metrics-file", required_argument, "Append a JSON snapshot of the game's metrics to the specified file every few seconds"};
+static const ProgramOption metricsIntervalOption {'s', "metrics-interval", required_argument, "Specify the number of seconds between metrics snapshots (default 10)"};
+static const ProgramOption stallThresholdOption {'w', "stall-threshold", required_argument, "Log a GUI thread stall after the specified number of milliseconds (default 250, 0 to disable)"};
 
 static struct option longOptions[]{
         verboseOption.toPosixOption(),
@@ -55,6 +68,12 @@ static struct option longOptions[]{
         versionOption.toPosixOption(),
         dimensionsOption.toPosixOption(),
         mineRatioOption.toPosixOption(),
+        packOption.toPosixOption(),
+        packIndexOption.toPosixOption(),
+        traceOption.toPosixOption(),
+        metricsFileOption.toPosixOption(),
+        metricsIntervalOption.toPosixOption(),
+        stallThresholdOption.toPosixOption(),
         {nullptr, 0, nullptr, 0}
 };
 
@@ -66,7 +85,13 @@ static const std::array<const ProgramOption *, PROGRAM_OPTION_COUNT> programOpti
         &helpOption,
         &versionOption,
         &dimensionsOption,
-        &mineRatioOption
+        &mineRatioOption,
+        &packOption,
+        &packIndexOption,
+        &traceOption,
+        &metricsFileOption,
+        &metricsIntervalOption,
+        &stallThresholdOption
 };
 
 void displayHelp();
@@ -76,9 +101,17 @@ void installSignalHandlers(void (*signalHandler)(int));
 void globalLogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
 std::pair<int, int> tryParseDimensions(std::string str);
 float tryParseMineRatio(std::string str);
+int tryParsePackIndex(std::string str);
+int tryParseMetricsInterval(std::string str);
+int tryParseStallThreshold(std::string str);
 
-static bool verboseLogging{false};
 static std::string initialGameStateFile{""};
+static std::string initialBoardPackFile{""};
+static int initialBoardPackIndex{0};
+static std::string traceFilePath{""};
+static std::string metricsFilePath{""};
+static int metricsInterval{QmsMetricsWriter::DEFAULT_INTERVAL_SECONDS()};
+static int stallThreshold{QmsEventLoopWatchdog::DEFAULT_STALL_THRESHOLD()};
 
 using namespace QmsStrings;
 using namespace QmsGlobalSettings;
@@ -95,6 +128,8 @@ int main(int argc, char *argv[]) {
     QCoreApplication::setApplicationName(LONG_PROGRAM_NAME);
 
     QmsUtilities::checkOrCreateProgramLogDirectory();
+    QmsLogSink::initializeInstance(QmsUtilities::getLogFilePath());
+    QmsFlightRecorder::initializeInstance(QmsUtilities::getLogFilePath() + ".flight.log");
     QmsUtilities::checkOrCreateProgramSettingsDirectory();
 
 
@@ -119,7 +154,7 @@ int main(int argc, char *argv[]) {
                 displayVersion();
                 exit(EXIT_SUCCESS);
             case 'e':
-                verboseLogging = true;
+                QmsLogging::setMinimumLevel(QmsLogLevel::Debug);
                 LOG_DEBUG() << "Enabling verbose logging due to command line switch";
                 break;
             case 'd':
@@ -130,6 +165,33 @@ int main(int argc, char *argv[]) {
             case 'r':
                 mineRatio = tryParseMineRatio(optarg);
                 break;
+            case 'p':
+                initialBoardPackFile = optarg;
+                if (QmsUtilities::startsWith(initialBoardPackFile, '=')) {
+                    initialBoardPackFile.erase(0, 1);
+                }
+                break;
+            case 'i':
+                initialBoardPackIndex = tryParsePackIndex(optarg);
+                break;
+            case 't':
+                traceFilePath = optarg;
+                if (QmsUtilities::startsWith(traceFilePath, '=')) {
+                    traceFilePath.erase(0, 1);
+                }
+                break;
+            case 'm':
+                metricsFilePath = optarg;
+                if (QmsUtilities::startsWith(metricsFilePath, '=')) {
+                    metricsFilePath.erase(0, 1);
+                }
+                break;
+            case 's':
+                metricsInterval = tryParseMetricsInterval(optarg);
+                break;
+            case 'w':
+                stallThreshold = tryParseStallThreshold(optarg);
+                break;
             default:
                 LOG_WARNING() << QString{R"(Invalid switch "%1" detected, ignoring option)"}.arg(static_cast<char>(currentOption));
                 break;
@@ -186,8 +248,16 @@ int main(int argc, char *argv[]) {
     //LOG_DEBUG() << QString{"Beginning game with dimensions (%1x%2)"}.arg(QS_NUMBER(columnCount), QS_NUMBER(rowCount));
     //TODO: Load language from config file
 
-    QApplication qApplication{argc, argv};
+    QmsApplication qApplication{argc, argv};
+    if (!traceFilePath.empty()) {
+        QmsTraceRecorder::initializeInstance(QString::fromStdString(traceFilePath));
+    }
+    if (!metricsFilePath.empty()) {
+        QmsMetricsWriter::initializeInstance(QString::fromStdString(metricsFilePath), metricsInterval);
+    }
+    QmsEventLoopWatchdog::initializeInstance(stallThreshold);
     QmsIcons::initializeInstance();
+    applicationIcons->changeIconPalette(settings.iconPalette());
     QmsSettingsLoader::initializeInstance(nullptr);
     GameController::initializeInstance(columnCount, rowCount);
 #if defined(__ANDROID__)
@@ -197,6 +267,7 @@ int main(int argc, char *argv[]) {
 #endif
     std::shared_ptr<MainWindow> mainWindow{std::make_shared<MainWindow>(QmsSettingsLoader::DEFAULT_LANGUAGE)};
     gameController->bindMainWindow(mainWindow);
+    mainWindow->setRippleReveal(settings.rippleReveal());
     if (mineRatioSetByCommandLine) {
         LOG_INFO() << QString{R"(Using custom mine ratio %1)"}.arg(QS_NUMBER(mineRatio));
         gameController->setCustomMineRatio(mineRatio);
@@ -219,8 +290,16 @@ int main(int argc, char *argv[]) {
             warningBox.setText(QMessageBox::tr(QString{QmsStrings::FAILED_TO_LOAD_GAME_STATE}.arg(result.second.c_str()).toStdString().c_str()));
             warningBox.exec();
         }
+    } else if (!initialBoardPackFile.empty()) {
+        mainWindow->playFromPack(initialBoardPackFile.c_str(), initialBoardPackIndex);
     }
-    return qApplication.exec();
+    const int exitCode{qApplication.exec()};
+    QmsAllocationTracker::report(QmsUtilities::getLogFilePath() + ".allocations.json");
+    QmsEventLoopWatchdog::shutdownInstance();
+    QmsTraceRecorder::shutdownInstance();
+    QmsMetricsWriter::shutdownInstance();
+    QmsLogSink::shutdownInstance();
+    return exitCode;
 }
 
 std::pair<int, int> tryParseDimensions(std::string str) {
@@ -246,17 +325,78 @@ float tryParseMineRatio(std::string str) {
     return returnValue;
 }
 
+int tryParsePackIndex(std::string str) {
+    if (QmsUtilities::startsWith(str, '=')) {
+        str.erase(0, 1);
+    }
+    bool isValid{false};
+    const int returnValue{QString{str.c_str()}.toInt(&isValid)};
+    if ((!isValid) || (returnValue < 0)) {
+        LOG_WARNING() << QString{R"(Invalid board pack index argument "%1", using board 0)"}.arg(str.c_str());
+        return 0;
+    }
+    return returnValue;
+}
+
+int tryParseMetricsInterval(std::string str) {
+    if (QmsUtilities::startsWith(str, '=')) {
+        str.erase(0, 1);
+    }
+    bool isValid{false};
+    const int returnValue{QString{str.c_str()}.toInt(&isValid)};
+    if ((!isValid) || (returnValue <= 0)) {
+        LOG_WARNING() << QString{R"(Invalid metrics interval argument "%1", using %2 seconds)"}.arg(str.c_str(), QS_NUMBER(QmsMetricsWriter::DEFAULT_INTERVAL_SECONDS()));
+        return QmsMetricsWriter::DEFAULT_INTERVAL_SECONDS();
+    }
+    return returnValue;
+}
+
+int tryParseStallThreshold(std::string str) {
+    if (QmsUtilities::startsWith(str, '=')) {
+        str.erase(0, 1);
+    }
+    bool isValid{false};
+    const int returnValue{QString{str.c_str()}.toInt(&isValid)};
+    if ((!isValid) || (returnValue < 0)) {
+        LOG_WARNING() << QString{R"(Invalid stall threshold argument "%1", using %2 ms)"}.arg(str.c_str(), QS_NUMBER(QmsEventLoopWatchdog::DEFAULT_STALL_THRESHOLD()));
+        return QmsEventLoopWatchdog::DEFAULT_STALL_THRESHOLD();
+    }
+    return returnValue;
+}
+
+/* interruptHandler() : Only makes async signal safe calls, since the thread it interrupted may be
+ * holding any lock (the allocator's included). A crash dumps the flight recorder, then dies of
+ * the same signal with the default action, so it still leaves a core dump and an exit status a
+ * supervisor recognizes as a crash. Any other signal that ends the program dumps the flight
+ * recorder and asks the event loop to quit; if it cannot (no event loop yet, or a second signal
+ * while the first one has not been acted on, as with a hung GUI thread), it dies of the signal
+ * too. SIGUSR1 writes the trace from the event loop, SIGUSR2 only dumps the flight recorder */
 void interruptHandler(int signalNumber) {
+    static volatile sig_atomic_t quitRequested{0};
 #if defined(_WIN32)
-    std::cout << std::endl << "Caught signal " << signalNumber << " (" << QmsUtilities::getSignalName(signalNumber) << "), exiting " << PROGRAM_NAME << std::endl;
-    exit (signalNumber);
+    const bool isCrash{(signalNumber == SIGABRT) || (signalNumber == SIGFPE) || (signalNumber == SIGILL) || (signalNumber == SIGSEGV)};
 #else
-    if ((signalNumber == SIGUSR1) || (signalNumber == SIGUSR2) || (signalNumber == SIGCHLD)) {
+    if (signalNumber == SIGUSR1) {
+        QmsApplication::postSignal(signalNumber);
+        return;
+    }
+    if (signalNumber == SIGUSR2) {
+        QmsFlightRecorder::dump(signalNumber);
+        return;
+    }
+    if (signalNumber == SIGCHLD) {
         return;
     }
-    std::cout << std::endl << "Caught signal " << signalNumber << " (" << QmsUtilities::getSignalName(signalNumber) << "), exiting " << PROGRAM_NAME << std::endl;
-    exit (signalNumber);
+    const bool isCrash{(signalNumber == SIGABRT) || (signalNumber == SIGFPE) || (signalNumber == SIGILL) ||
+                       (signalNumber == SIGSEGV) || (signalNumber == SIGBUS) || (signalNumber == SIGQUIT)};
 #endif //defined(_WIN32)
+    QmsFlightRecorder::dump(signalNumber);
+    if ((!isCrash) && (!quitRequested) && (QmsApplication::postSignal(signalNumber))) {
+        quitRequested = 1;
+        return;
+    }
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
 }
 
 void installSignalHandlers(void (*signalHandler)(int)) {
@@ -278,6 +418,8 @@ void installSignalHandlers(void (*signalHandler)(int)) {
     sigaction(SIGILL, &signalInterruptHandler, NULL);
     sigaction(SIGABRT, &signalInterruptHandler, NULL);
     sigaction(SIGFPE, &signalInterruptHandler, NULL);
+    sigaction(SIGSEGV, &signalInterruptHandler, NULL);
+    sigaction(SIGBUS, &signalInterruptHandler, NULL);
     sigaction(SIGPIPE, &signalInterruptHandler, NULL);
     sigaction(SIGALRM, &signalInterruptHandler, NULL);
     sigaction(SIGTERM, &signalInterruptHandler, NULL);
@@ -316,86 +458,40 @@ void displayHelp()
 
 #if defined(USE_QT_LOG)
 
-template<typename StringType, typename FileStringType>
-void logToFile(const StringType &str, const FileStringType &filePath) {
-    using QmsUtilities::toStdString;
-    using QmsUtilities::toQString;
-    QFile qFile{filePath};
-    if (qFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        if (qFile.write(toStdString(str).c_str(), toStdString(str).length()) == -1) {
-            throw std::runtime_error(
-                    QString{R"(Failed to log data "%1" to file "%2" (file was opened, but not writable, permission problem?))"}.arg(
-                            toQString(str), toQString(filePath)).toStdString());
-        }
-    } else {
-        throw std::runtime_error(
-                QString{R"(Failed to log data "%1" to file "%2" (could not open file))"}.arg(toQString(str), toQString(
-                        filePath)).toStdString());
-    }
-
-}
-
+/* globalLogHandler() : Runs on whatever thread logged the message, so it does as little as
+ * possible: the quotes qDebug() puts around a QString are skipped by offset rather than by
+ * copying, and the message goes to the log sink, which does the formatting and writing on its
+ * own thread. Before the sink exists (or after it is gone), the line is written directly */
 void globalLogHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-    QByteArray localMsg{msg.toLocal8Bit()};
-    QString logContext{""};
-    auto *outputStream = &std::cout;
-    switch (type) {
-        case QtDebugMsg:
-            if (!verboseLogging) {
-                return;
-            }
-            logContext = "[D]";
-            outputStream = &std::cout;
-            break;
-        case QtInfoMsg:
-            logContext = "[I]";
-            outputStream = &std::clog;
-            break;
-        case QtWarningMsg:
-            logContext = "[W]";
-            outputStream = &std::cout;
-            break;
-        case QtCriticalMsg:
-            logContext = "[C]";
-            outputStream = &std::cerr;
-            break;
-        case QtFatalMsg:
-            logContext = "[F]";
-            outputStream = &std::cerr;
-            abort();
+    if ((type == QtDebugMsg) && (!QmsLogging::isEnabled(QmsLogLevel::Debug))) {
+        return;
     }
-    QString logMessage{""};
-    std::string coreLogMessage{QString{localMsg}.toStdString()};
-    if (coreLogMessage.find('\"') == 0) {
-        coreLogMessage = coreLogMessage.substr(1);
+    const QChar *message{msg.constData()};
+    int messageLength{msg.length()};
+    if ((messageLength > 0) && (message[0] == QLatin1Char{'\"'})) {
+        message++;
+        messageLength--;
     }
-    if (coreLogMessage.find_last_of('\"') == coreLogMessage.length() - 1) {
-        coreLogMessage = coreLogMessage.substr(0, coreLogMessage.length() - 1);
+    if ((messageLength > 0) && (message[messageLength - 1] == QLatin1Char{'\"'})) {
+        messageLength--;
     }
-    //coreLogMessage.erase(std::remove_if(coreLogMessage.begin(), coreLogMessage.end(),[](char c) { return c == '\"'; }), coreLogMessage.end());
-    if ((type == QtCriticalMsg) || (type == QtFatalMsg)) {
-        logMessage = QString{"[%1] - %2: %3 (%4:%5, %6)"}.arg(QDateTime::currentDateTime().time().toString(), logContext,
-                                                             coreLogMessage.c_str(), context.file,
-                                                             QS_NUMBER(context.line), context.function);
-    } else {
-        logMessage = QString{"[%1] - %2: %3"}.arg(QDateTime::currentDateTime().time().toString(), logContext,
-                                                 coreLogMessage.c_str());
-    }
-    bool addLineEnding{true};
-    static const QList<const char *> LINE_ENDINGS{"\r\n", "\r", "\n", "\n\r"};
-    for (const auto &it : LINE_ENDINGS) {
-        if (logMessage.endsWith(it)) {
-            addLineEnding = false;
+    QmsLogSink *sink{logSink.load(std::memory_order_acquire)};
+    if (sink) {
+        sink->push(type, message, messageLength, context.file, context.line, context.function);
+        if (type == QtFatalMsg) {
+            sink->flush(std::chrono::seconds{5});
         }
+    } else {
+        const QByteArray text{QString{message, messageLength}.toUtf8()};
+        const std::string logMessage{QmsLogSink::formatLine(type, QDateTime::currentMSecsSinceEpoch(), text.constData(),
+                                                            static_cast<size_t>(text.size()))};
+        auto *outputStream = ((type == QtCriticalMsg) || (type == QtFatalMsg)) ? &std::cerr : &std::cout;
+        *outputStream << logMessage;
+        outputStream->flush();
     }
-    if (addLineEnding) {
-        logMessage.append("\n");
-    }
-    if (outputStream) {
-        *outputStream << logMessage.toStdString();
+    if (type == QtFatalMsg) {
+        abort();
     }
-    logToFile(logMessage.toStdString(), QmsUtilities::getLogFilePath());
-    outputStream->flush();
 }
 
 #else
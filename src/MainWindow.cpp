@@ -1,6 +1,7 @@
 #include <QMediaPlayer>
 #include <QGridLayout>
-#include <QDesktopWidget>
+#include <QGuiApplication>
+#include <QScreen>
 #include <QWindow>
 #include <QString>
 #include <QRect>
@@ -11,11 +12,24 @@
 #include <QTranslator>
 #include <QSettings>
 #include <QDateTime>
+#include <QInputDialog>
+#include <QDockWidget>
 
 #include <cctype>
+#include <algorithm>
+#include <limits>
 
 #include "QmsButton.hpp"
 #include "QmsIcons.hpp"
+#include "QmsIconAtlas.hpp"
+#include "QmsPauseOverlay.hpp"
+#include "QmsLatencyOverlay.hpp"
+#include "QmsBoardInputDispatcher.hpp"
+#include "QmsBoardRepaintScheduler.hpp"
+#include "QmsProgressiveReveal.hpp"
+#include "QmsBoardView.hpp"
+#include "QmsBoardMinimap.hpp"
+#include "QmsScreenMetrics.hpp"
 #include "GameController.hpp"
 #include "BoardResizeWidget.hpp"
 #include "QmsSoundEffects.hpp"
@@ -25,6 +39,12 @@
 #include "GlobalDefinitions.hpp"
 #include "QmsApplicationSettings.hpp"
 #include "AboutApplicationWidget.hpp"
+#include "QmsReplay.hpp"
+#include "QmsBoardPack.hpp"
+#include "QmsReplayPlayer.hpp"
+#include "QmsReplayControls.hpp"
+#include "QmsAllocationTracker.hpp"
+#include "QmsInstrumentation.hpp"
 
 #include "MainWindow.hpp"
 #include "ui_MainWindow.h"
@@ -41,19 +61,22 @@ const int MainWindow::WIDTH_SCALE_FACTOR{28};
 const int MainWindow::NUMBER_OF_HORIZONTAL_MARGINS{2};
 const int MainWindow::NUMBER_OF_VERTIAL_MARGINS{4};
 const int MainWindow::DEFAULT_MINE_SIZE_SCALE_FACTOR{19};
+const int MainWindow::MINIMUM_MINE_SIZE{12};
 const int MainWindow::STATUS_BAR_FONT_POINT_SIZE{12};
-const double MainWindow::MINE_ICON_REDUCTION_SCALE_FACTOR{0.75};
 
 /* MainWindow() : Constructor. All UI stuff if initialized and
  * relevant events are hooked (QObject::connect()) to set up the game to play */
 MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLanguage,
                        QWidget *parent) :
         MouseMoveableQMainWindow{parent},
-        m_eventTimer{new QTimer{}},
-        m_userIdleTimer{new SteadyEventTimer{}},
+        m_gameTimerDisplayTimer{new QTimer{}},
+        m_userIdleTimer{new QTimer{}},
+        m_userIdleTimeRemaining{0},
+        m_geometryUpdatePending{false},
         m_aboutQmsDialog{new AboutApplicationWidget{}},
         m_boardResizeDialog{new BoardResizeWidget{}},
         m_languageActionGroup{new QActionGroup{nullptr}},
+        m_iconPaletteActionGroup{new QActionGroup{nullptr}},
         m_translator{new QTranslator{}},
         m_statusBarLabel{new QLabel{}},
         m_language{initialDisplayLanguage},
@@ -61,16 +84,46 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
         m_currentDefaultMineSize{QSize{0, 0}},
         m_currentMaxMineSize{QSize{0, 0}},
         m_currentIconReductionSize{QSize{0, 0}},
+        m_mineFieldLayoutSize{QSize{0, 0}},
+        m_maximumBoardViewportSize{QSize{0, 0}},
         m_maxMineSizeCacheIsValid{false},
+        m_maxMineSizeScreen{nullptr},
+        m_maxMineSizeBoardSize{QSize{0, 0}},
+        m_screenRelayoutPending{false},
         m_iconReductionSizeCacheIsValid{false},
         m_boardSizeGeometrySet{false},
         m_saveFilePath{""},
-        m_ui{new Ui::MainWindow{}} {
+        m_ui{new Ui::MainWindow{}},
+        m_replayPlayer{nullptr},
+        m_replayControls{nullptr},
+        m_boardView{nullptr},
+        m_minimapDock{nullptr},
+        m_boardMinimap{nullptr},
+        m_pauseOverlay{nullptr},
+        m_latencyOverlay{nullptr},
+        m_boardInputDispatcher{nullptr},
+        m_boardRepaintScheduler{nullptr},
+        m_progressiveReveal{new QmsProgressiveReveal{}},
+        m_screenMetrics{new QmsScreenMetrics{}} {
 
     using namespace QmsStrings;
     this->m_ui->setupUi(this);
     this->m_ui->centralwidget->setMouseTracking(true);
     this->setStyleSheet("");
+    this->m_ui->gridLayout->removeWidget(this->m_ui->mineFrame);
+    this->m_boardView.reset(new QmsBoardView{this->m_ui->mineFrame, this->m_ui->centralwidget});
+    this->m_ui->gridLayout->addWidget(this->m_boardView.get(), 1, 0);
+    this->m_minimapDock.reset(new QDockWidget{this});
+    this->m_minimapDock->setFeatures(QDockWidget::NoDockWidgetFeatures);
+    this->m_minimapDock->setWindowTitle(MainWindow::tr(MINIMAP_DOCK_TITLE));
+    this->m_boardMinimap.reset(new QmsBoardMinimap{this->m_boardView.get(), this->m_minimapDock.get()});
+    this->m_minimapDock->setWidget(this->m_boardMinimap.get());
+    this->addDockWidget(Qt::RightDockWidgetArea, this->m_minimapDock.get());
+    this->m_minimapDock->hide();
+    this->m_pauseOverlay.reset(new QmsPauseOverlay{this->m_ui->mineFrame});
+    this->m_latencyOverlay.reset(new QmsLatencyOverlay{this->m_boardView->viewport()});
+    this->m_boardInputDispatcher.reset(new QmsBoardInputDispatcher{this->m_ui->mineFrame, this->m_ui->mineFrameGridLayout});
+    this->m_boardRepaintScheduler.reset(new QmsBoardRepaintScheduler{this->m_ui->mineFrame});
 
     this->m_ui->numberOfMoves->setDataSource(gameController->numbersOfMovesMadeDataSource());
     this->m_ui->minesRemaining->setDataSource(gameController->userDisplayNumbersOfMinesDataSource());
@@ -85,19 +138,34 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
 
     this->setLanguage(this->m_language);
     this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_SMILEY);
-    this->m_eventTimer->setInterval(gameController->GAME_TIMER_INTERVAL());
+    this->m_gameTimerDisplayTimer->setSingleShot(true);
+    this->m_gameTimerDisplayTimer->setTimerType(Qt::PreciseTimer);
+    this->m_userIdleTimer->setSingleShot(true);
+    this->m_userIdleTimer->setInterval(GameController::DEFAULT_SLEEPY_FACE_TIMEOUT());
 
     connect(this->m_ui->actionSave, &QAction::triggered, this, &MainWindow::onSaveActionTriggered);
     connect(this->m_ui->actionSaveAs, &QAction::triggered, this, &MainWindow::onSaveAsActionTriggered);
     connect(this->m_ui->actionOpen, &QAction::triggered, this, &MainWindow::onOpenActionTriggered);
+    connect(this->m_ui->actionPlayFromPack, &QAction::triggered, this, &MainWindow::onPlayFromPackActionTriggered);
+    connect(this->m_ui->actionOpenReplay, &QAction::triggered, this, &MainWindow::onOpenReplayActionTriggered);
 
     this->m_ui->actionSave->setEnabled(false);
     this->m_ui->actionSaveAs->setEnabled(false);
 
+    connect(this->m_ui->actionUndo, &QAction::triggered, gameController, &GameController::onUndoRequested);
+    connect(this->m_ui->actionRedo, &QAction::triggered, gameController, &GameController::onRedoRequested);
+    connect(gameController, &GameController::undoAvailabilityChanged, this, &MainWindow::onUndoAvailabilityChanged);
+    this->m_ui->actionUndo->setEnabled(false);
+    this->m_ui->actionRedo->setEnabled(false);
+
     connect(this->m_ui->actionQuit, &QAction::triggered, this, &MainWindow::close);
     connect(this->m_ui->actionAboutQt, &QAction::triggered, this, &MainWindow::onAboutQtActionTriggered);
     connect(this->m_ui->actionBoardSize, &QAction::triggered, this, &MainWindow::onChangeBoardSizeActionTriggered);
     connect(this->m_ui->actionMuteSound, &QAction::triggered, this, &MainWindow::onActionMuteSoundChecked);
+    connect(this->m_ui->actionRippleReveal, &QAction::triggered, this, &MainWindow::onActionRippleRevealChecked);
+    connect(this->m_ui->actionShowLatencyOverlay, &QAction::triggered, this, &MainWindow::onActionShowLatencyOverlayChecked);
+    connect(this->m_boardView.get(), &QmsBoardView::cellSizeChanged, this, &MainWindow::onBoardCellSizeChanged);
+    connect(this->m_boardView.get(), &QmsBoardView::contentSizeChanged, this, &MainWindow::onBoardContentSizeChanged);
 
     connect(this->m_ui->resetButton, &QPushButton::clicked, this, &MainWindow::onResetButtonClicked);
     connect(gameController, &GameController::winEvent, this, &MainWindow::onGameWon);
@@ -107,16 +175,21 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
     connect(gameController, &GameController::customMineRatioSet, this, &MainWindow::onCustomMineRatioSet);
     connect(gameController, &GameController::loadGameCompleted, this, &MainWindow::onLoadGameCompleted);
 
-    connect(this->m_eventTimer.get(), &QTimer::timeout, this, &MainWindow::eventLoop);
+    connect(this->m_gameTimerDisplayTimer.get(), &QTimer::timeout, this, &MainWindow::updateVisibleGameTimer);
+    connect(this->m_userIdleTimer.get(), &QTimer::timeout, this, &MainWindow::onUserIdleTimeout);
+    connect(gameController, &GameController::gameStateChanged, this, &MainWindow::onGameStateChanged);
+    connect(this->m_screenMetrics.get(), &QmsScreenMetrics::screenMetricsChanged, this, &MainWindow::onScreenMetricsChanged);
 
-    connect(gameController, &GameController::gameResumed, this, &MainWindow::onGameResumed);
+    connect(gameController, &GameController::pausedChanged, this, &MainWindow::onPausedChanged);
     connect(gameController, &GameController::mineExplosionEvent, this, &MainWindow::onMineExplosionEventTriggered);
 
     connect(this->m_ui->menuFile, &QMenu::aboutToShow, gameController, &GameController::onContextMenuActive);
+    connect(this->m_ui->menuEdit, &QMenu::aboutToShow, gameController, &GameController::onContextMenuActive);
     connect(this->m_ui->menuPreferences, &QMenu::aboutToShow, gameController, &GameController::onContextMenuActive);
     connect(this->m_ui->menuHelp, &QMenu::aboutToShow, gameController, &GameController::onContextMenuActive);
 
     connect(this->m_ui->menuFile, &QMenu::aboutToHide, gameController, &GameController::onContextMenuInactive);
+    connect(this->m_ui->menuEdit, &QMenu::aboutToHide, gameController, &GameController::onContextMenuInactive);
     connect(this->m_ui->menuPreferences, &QMenu::aboutToHide, gameController, &GameController::onContextMenuInactive);
     connect(this->m_ui->menuHelp, &QMenu::aboutToHide, gameController, &GameController::onContextMenuInactive);
 
@@ -124,7 +197,6 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
     connect(this, &MainWindow::mineDisplayed, gameController, &GameController::onMineDisplayed);
     connect(this, &MainWindow::winEvent, gameController, &GameController::onGameWon);
     connect(this, &MainWindow::gamePaused, gameController, &GameController::onGamePaused);
-    connect(this, &MainWindow::mineSweeperButtonCreated, gameController, &GameController::onMineSweeperButtonCreated);
     connect(this, &MainWindow::resetGame, gameController, &GameController::onGameReset);
     connect(this, &MainWindow::gameResumed, gameController, &GameController::onGameResumed);
     connect(this, &MainWindow::mineExplosionEvent, gameController, &GameController::onMineExplosionEventTriggered);
@@ -140,14 +212,30 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
     connect(this->m_ui->actionFrench, &QAction::triggered, this, &MainWindow::onLanguageSelected);
     connect(this->m_ui->actionJapanese, &QAction::triggered, this, &MainWindow::onLanguageSelected);
 
+    this->m_iconPaletteActionGroup->addAction(this->m_ui->actionPaletteClassic);
+    this->m_iconPaletteActionGroup->addAction(this->m_ui->actionPaletteHighContrast);
+    this->m_iconPaletteActionGroup->addAction(this->m_ui->actionPaletteMonochrome);
+    this->m_iconPaletteActionGroup->setExclusive(true);
+    if (applicationIcons->iconPalette() == IconPalette::HighContrast) {
+        this->m_ui->actionPaletteHighContrast->setChecked(true);
+    } else if (applicationIcons->iconPalette() == IconPalette::Monochrome) {
+        this->m_ui->actionPaletteMonochrome->setChecked(true);
+    }
+
+    connect(this->m_ui->actionPaletteClassic, &QAction::triggered, this, &MainWindow::onIconPaletteSelected);
+    connect(this->m_ui->actionPaletteHighContrast, &QAction::triggered, this, &MainWindow::onIconPaletteSelected);
+    connect(this->m_ui->actionPaletteMonochrome, &QAction::triggered, this, &MainWindow::onIconPaletteSelected);
+    connect(applicationIcons->iconAtlas(), &QmsIconAtlas::atlasChanged, this->m_ui->mineFrame,
+            static_cast<void (QWidget::*)()>(&QWidget::update));
+
     this->m_aboutQmsDialog->addLicenseTab(QmsGlobalSettings::PROGRAM_NAME, QmsStrings::QMINESWEEPER_LICENSE_PATH);
 
-    std::unique_ptr<QRect> avail{new QRect{QDesktopWidget{}.availableGeometry()}};
+    const QRect avail{this->m_screenMetrics->geometryOf(this->currentScreen()).availableGeometry};
 
 #if defined(__ANDROID__)
     this->m_reductionSizeScaleFactor = 1;
 #else
-    if (avail->height() > 800) {
+    if (avail.height() > 800) {
         this->m_reductionSizeScaleFactor = 0.7;
     } else {
         this->m_reductionSizeScaleFactor = 0.5;
@@ -168,13 +256,20 @@ MainWindow::MainWindow(QmsSettingsLoader::SupportedLanguage initialDisplayLangua
     connect(this->m_aboutQmsDialog.get(), &AboutApplicationWidget::aboutToClose, this,
             &MainWindow::onAboutQmsWindowClosed);
 
-    this->m_eventTimer->start();
+    this->updateVisibleGameTimer();
 }
 
 void MainWindow::onCustomMineRatioSet(float mineRatio) {
     LOG_DEBUG() << QString{R"(Custom mine ratio %1 has been set)"}.arg(QS_NUMBER(mineRatio));
 }
 
+/* onUndoAvailabilityChanged() : Called whenever a move is made, undone or redone, or the
+ * game ends or is reset, so the Edit menu only offers what the GameController will accept */
+void MainWindow::onUndoAvailabilityChanged(bool canUndo, bool canRedo) {
+    this->m_ui->actionUndo->setEnabled(canUndo);
+    this->m_ui->actionRedo->setEnabled(canRedo);
+}
+
 void MainWindow::onSaveActionTriggered() {
     if (this->m_saveFilePath == "") {
         this->onSaveAsActionTriggered();
@@ -252,31 +347,25 @@ void MainWindow::onOpenActionTriggered() {
 }
 
 void MainWindow::onLoadGameCompleted(const std::pair<LoadGameStateResult, std::string> &loadResult, const QmsGameState &gameState) {
+    QMS_INSTRUMENT_SCOPE("Apply loaded game");
     if (loadResult.first == LoadGameStateResult::Success) {
         emit(resetGame());
-        this->setupNewGame();
-        this->boardResize(gameController->numberOfColumns(), gameController->numberOfRows());
+        this->invalidateSizeCaches();
+        emit(boardResize(gameState.numberOfColumns(), gameState.numberOfRows()));
         gameController->applyGameState(gameState);
-        for (auto &it : gameController->mineSweeperButtons()) {
-            auto button = it.second;
-            this->m_ui->mineFrameGridLayout->addWidget(button.get(), it.first.Y(), it.first.X(), 1, 1);
-            it.second->setFixedSize(getMaxMineSize());
-            emit(mineSweeperButtonCreated(button));
-            it.second->setIconSize(button->size() * MainWindow::MINE_ICON_REDUCTION_SCALE_FACTOR);
-            this->m_saveStyleSheet = button->styleSheet();
-        }
         for (const auto &it : gameController->mineSweeperButtons()) {
             auto button = it.second;
-            if (button->isRevealed()) {
+            const QmsCellState cellState{gameController->cellState(button.get())};
+            button->setHasMine(cellState.hasMine());
+            button->setNumberOfSurroundingMines(cellState.numberOfSurroundingMines());
+            if (cellState.isRevealed()) {
                 this->displayMineFromLoad(button.get());
-            } else if (button->hasFlag()) {
+            } else if (cellState.hasFlag()) {
                 button->setHasFlag(true);
-            } else if (button->hasQuestionMark()) {
+            } else if (cellState.hasQuestionMark()) {
                 button->setHasQuestionMark(true);
             }
         }
-        this->m_ui->numberOfMoves->setDataSource(gameController->numbersOfMovesMadeDataSource());
-        this->m_ui->minesRemaining->setDataSource(gameController->userDisplayNumbersOfMinesDataSource());
         emit(gameResumed());
         return;
     }
@@ -290,6 +379,179 @@ void MainWindow::onLoadGameCompleted(const std::pair<LoadGameStateResult, std::s
     errorBox->exec();
 }
 
+/* onPlayFromPackActionTriggered() : Lets the user pick a board pack, then a board
+ * by its number within the pack, which replaces the current game */
+void MainWindow::onPlayFromPackActionTriggered() {
+    emit(gamePaused());
+    const QString packFilter{QString{MainWindow::tr("QMineSweeper board packs : (*%1)")}.arg(
+            QmsStrings::BOARD_PACK_FILE_EXTENSION)};
+    const QString packPath{QFileDialog::getOpenFileName(this, MainWindow::tr(QmsStrings::OPEN_BOARD_PACK_CAPTION),
+                                                        QmsUtilities::getProgramSettingsDirectory(), packFilter)};
+    if (packPath.isEmpty()) {
+        emit(gameResumed());
+        return;
+    }
+    QmsBoardPack boardPack{};
+    if (!this->openBoardPack(boardPack, packPath)) {
+        emit(gameResumed());
+        return;
+    }
+    const int lastBoardIndex{static_cast<int>(std::min(boardPack.boardCount() - 1,
+                                                       static_cast<uint32_t>(std::numeric_limits<int>::max())))};
+    bool accepted{false};
+    const QString indexPrompt{QString{MainWindow::tr(QmsStrings::CHOOSE_BOARD_PACK_INDEX_PROMPT)}.arg(
+            QS_NUMBER(lastBoardIndex))};
+    const int boardIndex{QInputDialog::getInt(this, MainWindow::tr(QmsStrings::CHOOSE_BOARD_PACK_INDEX_TITLE),
+                                              indexPrompt, 0, 0, lastBoardIndex, 1, &accepted)};
+    if ((!accepted) || (!this->playPackedBoard(boardPack, boardIndex, packPath))) {
+        emit(gameResumed());
+    }
+}
+
+/* playFromPack() : Starts a game on board boardIndex of the pack at filePath, as
+ * requested from the command line. Any problem is reported to the user */
+bool MainWindow::playFromPack(const QString &filePath, int boardIndex) {
+    QmsBoardPack boardPack{};
+    return (this->openBoardPack(boardPack, filePath) && this->playPackedBoard(boardPack, boardIndex, filePath));
+}
+
+bool MainWindow::openBoardPack(QmsBoardPack &boardPack, const QString &filePath) {
+    const auto openResult = boardPack.open(filePath);
+    if (openResult.first != OpenBoardPackResult::Success) {
+        this->displayBoardPackError(filePath, openResult.second.c_str());
+        return false;
+    }
+    if (boardPack.boardCount() == 0) {
+        this->displayBoardPackError(filePath, QString{"File \"%1\" contains no boards"}.arg(filePath));
+        return false;
+    }
+    return true;
+}
+
+/* playPackedBoard() : Sets up a fresh board of the packed board's size and hands its mines to the
+ * GameController, which keeps the first click safe. Only the index entry and the bytes of the one
+ * board are read from the pack */
+bool MainWindow::playPackedBoard(const QmsBoardPack &boardPack, int boardIndex, const QString &filePath) {
+    QmsPackedBoard packedBoard{};
+    if ((boardIndex < 0) || (!boardPack.boardAt(static_cast<uint32_t>(boardIndex), packedBoard))) {
+        this->displayBoardPackError(filePath, QString{"Board %1 of %2 could not be read"}.arg(
+                QS_NUMBER(boardIndex), QS_NUMBER(boardPack.boardCount())));
+        return false;
+    }
+    this->stopReplay();
+    this->m_boardResizeDialog->hide();
+    this->m_saveFilePath = "";
+    this->invalidateSizeCaches();
+    emit(boardResize(packedBoard.numberOfColumns, packedBoard.numberOfRows));
+    gameController->setPresetMinePlacement(packedBoard.mineCells, true);
+    LOG_INFO() << QString{"Playing board %1 of board pack %2 (%3x%4, %5 mines)"}.arg(
+            QS_NUMBER(boardIndex), filePath, QS_NUMBER(packedBoard.numberOfColumns),
+            QS_NUMBER(packedBoard.numberOfRows), QS_NUMBER(packedBoard.mineCells.size()));
+    return true;
+}
+
+void MainWindow::displayBoardPackError(const QString &filePath, const QString &reason) {
+    std::unique_ptr<QMessageBox> errorBox{new QMessageBox{}};
+    errorBox->setWindowTitle(MainWindow::tr(QmsStrings::ERROR_LOADING_BOARD_PACK_TITLE));
+    QString errorText{QString{QmsStrings::ERROR_LOADING_FILE_MESSAGE}.arg(filePath, reason)};
+    LOG_WARNING() << errorText;
+    errorBox->setText(errorText);
+    errorBox->setWindowIcon(applicationIcons->MINE_ICON_48);
+    errorBox->exec();
+}
+
+/* onOpenReplayActionTriggered() : Lets the user pick a replay, which is played back on its own
+ * board in place of the current game. Replays are saved automatically at the end of each game */
+void MainWindow::onOpenReplayActionTriggered() {
+    emit(gamePaused());
+    const QString replayPath{QFileDialog::getOpenFileName(this, MainWindow::tr(QmsStrings::OPEN_REPLAY_CAPTION),
+                                                          QmsReplayRecorder::replayDirectory(),
+                                                          QString{MainWindow::tr("QMineSweeper replays : (*%1)")}.arg(QmsStrings::REPLAY_FILE_EXTENSION))};
+    if (replayPath.isEmpty()) {
+        emit(gameResumed());
+        return;
+    }
+    QmsReplay replay{};
+    const auto loadResult = QmsReplay::loadFromFile(replayPath, replay);
+    if (loadResult.first == LoadReplayResult::Success) {
+        this->startReplay(replay);
+        return;
+    }
+
+    std::unique_ptr<QMessageBox> errorBox{new QMessageBox{}};
+    errorBox->setWindowTitle(MainWindow::tr(QmsStrings::ERROR_LOADING_REPLAY_TITLE));
+    QString errorText{QString{QmsStrings::ERROR_LOADING_FILE_MESSAGE}.arg(replayPath, loadResult.second.c_str())};
+    LOG_WARNING() << errorText;
+    errorBox->setText(errorText);
+    errorBox->setWindowIcon(applicationIcons->MINE_ICON_48);
+    errorBox->exec();
+    emit(gameResumed());
+}
+
+/* startReplay() : Sets up a fresh board of the replay's size, hands the recorded mine layout to the
+ * GameController, and shows the playback controls. Anything that would replace the board is disabled
+ * until the replay is closed, and clicks on the board are ignored by the GameController meanwhile */
+void MainWindow::startReplay(const QmsReplay &replay) {
+    this->stopReplay();
+    this->m_boardResizeDialog->hide();
+    this->invalidateSizeCaches();
+    emit(boardResize(replay.numberOfColumns(), replay.numberOfRows()));
+    gameController->beginReplayPlayback(replay);
+
+    this->m_ui->actionOpen->setEnabled(false);
+    this->m_ui->actionBoardSize->setEnabled(false);
+    this->m_ui->actionSave->setEnabled(false);
+    this->m_ui->actionSaveAs->setEnabled(false);
+
+    this->m_replayPlayer.reset(new QmsReplayPlayer{replay});
+    this->m_replayControls.reset(new QmsReplayControls{this->m_replayPlayer.get()});
+    connect(this->m_replayPlayer.get(), &QmsReplayPlayer::stateRestored, this, &MainWindow::onReplayStateRestored);
+    connect(this->m_replayControls.get(), &QmsReplayControls::closeRequested, this, &MainWindow::stopReplay);
+    this->m_ui->statusBar->addPermanentWidget(this->m_replayControls.get());
+    this->m_replayPlayer->play();
+}
+
+/* stopReplay() : Removes the playback controls and starts a normal new game. The
+ * controls are deleted later, as this is usually called from one of their own signals */
+void MainWindow::stopReplay() {
+    if (!gameController->isReplayPlaybackActive()) {
+        return;
+    }
+    this->m_replayPlayer->pause();
+    this->m_ui->statusBar->removeWidget(this->m_replayControls.get());
+    this->m_replayControls.release()->deleteLater();
+    this->m_replayPlayer.release()->deleteLater();
+    gameController->endReplayPlayback();
+
+    this->m_ui->actionOpen->setEnabled(true);
+    this->m_ui->actionBoardSize->setEnabled(true);
+    this->invalidateSizeCaches();
+    emit(boardResize(gameController->numberOfColumns(), gameController->numberOfRows()));
+}
+
+/* onReplayStateRestored() : Called when seeking restores a keyframe,
+ * which replaces the whole game state at once rather than cell by cell */
+void MainWindow::onReplayStateRestored() {
+    QMS_INSTRUMENT_SCOPE("Restore replay state");
+    this->refreshMineField();
+}
+
+/* refreshMineField() : Brings every QMineSweeperButton in line with the GameController's cell
+ * grid, including undoing anything the end of a game does to the buttons (mine glyphs and red
+ * uncovered mines). Like displayMineFromLoad(), no signals are emitted */
+void MainWindow::refreshMineField() {
+    this->m_progressiveReveal->finish();
+    for (const auto &it : gameController->mineSweeperButtons()) {
+        auto button = it.second;
+        const QmsCellState cellState{gameController->cellState(button.get())};
+        button->setHasMine(cellState.hasMine());
+        button->setNumberOfSurroundingMines(cellState.numberOfSurroundingMines());
+        button->setShowsUncoveredMine(false);
+        this->restoreMineSquare(button.get(), cellState);
+    }
+    this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_SMILEY);
+}
+
 /* displayStatusMessage() : Called to include a space in the beginning
  * of the statusBar message, because without it, it is too closely aligned
  * to the corner of the window and doesn't look quite right */
@@ -306,6 +568,8 @@ QmsApplicationSettings MainWindow::collectApplicationSettings() const {
     returnSettings.setNumberOfColumns(gameController->numberOfColumns());
     returnSettings.setNumberOfRows(gameController->numberOfRows());
     returnSettings.setAudioVolume(applicationSoundEffects->audioVolume());
+    returnSettings.setIconPalette(applicationIcons->iconPalette());
+    returnSettings.setRippleReveal(this->m_progressiveReveal->rippleEnabled());
     return returnSettings;
 }
 
@@ -334,6 +598,7 @@ void MainWindow::setLanguage(QmsSettingsLoader::SupportedLanguage language) {
         this->displayStatusMessage(QStatusBar::tr(this->m_ui->statusBar->currentMessage().toStdString().c_str()));
         this->setWindowTitle(MainWindow::tr(this->windowTitle().toStdString().c_str()));
         this->m_ui->retranslateUi(this);
+        this->m_minimapDock->setWindowTitle(MainWindow::tr(QmsStrings::MINIMAP_DOCK_TITLE));
     }
 }
 
@@ -352,6 +617,23 @@ void MainWindow::onLanguageSelected(bool checked) {
     }
 }
 
+/* onIconPaletteSelected() : Called when a new icon palette is selected from the
+ * preferences menu. The board is repainted once the icon atlas has been rendered
+ * in the new palette, via QmsIconAtlas::atlasChanged() */
+void MainWindow::onIconPaletteSelected(bool checked) {
+    (void) checked;
+    QAction *checkedAction{this->m_iconPaletteActionGroup->checkedAction()};
+    if (checkedAction == this->m_ui->actionPaletteClassic) {
+        applicationIcons->changeIconPalette(IconPalette::Classic);
+    } else if (checkedAction == this->m_ui->actionPaletteHighContrast) {
+        applicationIcons->changeIconPalette(IconPalette::HighContrast);
+    } else if (checkedAction == this->m_ui->actionPaletteMonochrome) {
+        applicationIcons->changeIconPalette(IconPalette::Monochrome);
+    } else {
+        LOG_DEBUG() << "Icon palette action checked, but it was not a known QAction (this should never happen)";
+    }
+}
+
 /* boardResizeDialogVisible() : Pass through function, delegating to
  * the shared_ptr of the board size form, returning whether or not
  * the form is visible, for use in pausing or unpausing the game */
@@ -363,6 +645,10 @@ bool MainWindow::boardResizeDialogVisible() {
  * gameResumed signal if the window is actually visible (ie not hidden) */
 void MainWindow::showEvent(QShowEvent *event) {
     Q_UNUSED(event);
+    if (this->windowHandle()) {
+        connect(this->windowHandle(), &QWindow::screenChanged, this, &MainWindow::scheduleScreenRelayout,
+                Qt::UniqueConnection);
+    }
     //if ((!this->isHidden()) && (!this->isMinimized())) {
     if (!gameController->initialClickFlag() && (!gameController->gameOver())) {
         emit (gameResumed());
@@ -422,8 +708,10 @@ void MainWindow::onBoardResizeDialogClosed(BoardResizeWidget::ResizeWidgetResult
 /* onGameWon() : Called when the GameController class detects (via a mine click event,
  * flagging enough mines, or whatever win condition is defined) that the game has been won
  * Upon call, it iterates through the game board and sets the icons appropriately (green check if
- * a mine was correctly marked, red x if a flag was incorrectly marked, etc */
+ * a mine was correctly marked, red x if a flag was incorrectly marked, etc. Every cell is revealed,
+ * which goes through GameController::notifyCellChanged() like any other change to a cell */
 void MainWindow::onGameWon() {
+    QMS_INSTRUMENT_SCOPE("Game won");
     using namespace QmsUtilities;
     using namespace QmsStrings;
     this->m_ui->actionSave->setEnabled(false);
@@ -431,19 +719,26 @@ void MainWindow::onGameWon() {
     this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_BIG_SMILEY);
     gameController->setGameOver(true);
 
+    this->m_boardRepaintScheduler->beginBatch();
+    this->m_progressiveReveal->finish();
     for (auto &it : gameController->mineSweeperButtons()) {
         if (it.second->hasMine()) {
             if (it.second->hasFlag()) {
-                it.second->setIcon(applicationIcons->STATUS_ICON_FLAG_CHECK);
+                it.second->setGlyph(CellGlyph::FlagCheck);
             } else {
-                it.second->setIcon(applicationIcons->MINE_ICON_72);
-                it.second->setStyleSheet(UNCOVERED_MINE_STYLESHEET);
+                it.second->setGlyph(CellGlyph::Mine);
+                it.second->setShowsUncoveredMine(true);
             }
         } else if (it.second->hasFlag()) {
-            it.second->setIcon(applicationIcons->STATUS_ICON_FLAG_X);
+            it.second->setGlyph(CellGlyph::FlagX);
         }
         it.second->setIsRevealed(true);
         it.second->setChecked(true);
+        gameController->notifyCellChanged(it.second.get());
+    }
+    this->m_boardRepaintScheduler->endBatch();
+    if (gameController->isReplayPlaybackActive()) {
+        return;
     }
     std::unique_ptr<QMessageBox> winBox{new QMessageBox{}};
     winBox->setWindowTitle(MainWindow::tr(MAIN_WINDOW_TITLE));
@@ -462,56 +757,41 @@ void MainWindow::onGameStarted() {
                                                                          QS_NUMBER(gameController->numberOfRows()));
     this->startGameTimer();
     this->startUserIdleTimer();
-    this->m_ui->actionSave->setEnabled(true);
-    this->m_ui->actionSaveAs->setEnabled(true);
+    this->updateVisibleGameTimer();
+    if (!gameController->isReplayPlaybackActive()) {
+        this->m_ui->actionSave->setEnabled(true);
+        this->m_ui->actionSaveAs->setEnabled(true);
+    }
 }
 
-/* setupNewGame() : Called when a gameStarted() signal is emitted
- * Iterate through all of the QMineSweeperButtons on the mineFrame and delete them,
- * so new MineSweeperButtons can be created from a known fresh state, then
- * populate the mineFrame via populateMineFrame() */
+/* setupNewGame() : Called when the GameController is ready for a new board (at startup,
+ * and after every board resize), to populate the mineFrame via populateMineField() */
 void MainWindow::setupNewGame() {
-    QLayoutItem *wItem;
-    while ((wItem = this->m_ui->mineFrame->layout()->takeAt(0)) != 0) {
-        delete wItem;
-    }
+    QMS_INSTRUMENT_SCOPE("New game setup");
     this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_SMILEY);
+    this->m_progressiveReveal->cancel();
     this->populateMineField();
     this->centerAndFitWindow(true, true);
 }
 
-/* onGamePaused() : Called when a gamePaused() signal is emitted
- * Iterate through all of the QMineSweeperButtons on the mineFrame and
- * disable them, so the user cannot play the game until it is resumed */
-void MainWindow::onGamePaused() {
-    if (gameController->gameState() == GameState::GameActive) {
-        for (auto &it : gameController->mineSweeperButtons()) {
-            it.second->setEnabled(false);
-        }
-    }
-}
-
-/* onGameResumed() : Called when a gameResumed() signal is emitted
- * Iterate through all of the QMineSweeperButtons on the mineFrame and enable them,
- * so the user can continue with their game */
-void MainWindow::onGameResumed() {
-    if (gameController->gameState() == GameState::GamePaused) {
-        for (auto &it : gameController->mineSweeperButtons()) {
-            it.second->setEnabled(true);
-        }
-    }
+/* onPausedChanged() : Called when the game is paused or resumed (a menu or dialog opening or
+ * closing, the window being minimized, etc). The pause overlay covers the whole mineFrame, so
+ * the user cannot play (or study the board) until the game is resumed, without touching any
+ * of the QMineSweeperButtons underneath it */
+void MainWindow::onPausedChanged(bool paused) {
+    this->m_pauseOverlay->setPaused(paused);
 }
 
 /* displayMineSquare() : Called via the click handlers or other code (maybe onGameWon())
- * to provide a consistent way to display a mine on the MainWindow. First the number
- * of surrounding mines is drawn (the push button icon is set to the correct number
- * of surrounding mines), then a mineDisplayed() signal is emitted, to inform anything
- * connected that a mine is being displayed, then recursively check for other empty mines */
+ * to provide a consistent way to display a mine on the MainWindow. The button is revealed
+ * right away, and queued to be drawn (with the number of surrounding mines) by the
+ * QmsProgressiveReveal, then a mineDisplayed() signal is emitted, to inform anything
+ * connected that a mine is being displayed, then check for other empty mines */
 void MainWindow::displayMineSquare(QmsButton *msb) {
-    drawNumberOfSurroundingMines(msb);
-    msb->setFlat(true);
-    msb->setChecked(true);
+    QMS_ALLOCATION_SCOPE("MainWindow::displayMineSquare");
     msb->setIsRevealed(true);
+    gameController->notifyCellChanged(msb);
+    this->m_progressiveReveal->enqueue(msb);
     emit(mineDisplayed());
     if (msb->numberOfSurroundingMines() == 0) {
         gameController->checkForOtherEmptyMines(msb);
@@ -521,12 +801,30 @@ void MainWindow::displayMineSquare(QmsButton *msb) {
 /* displayMineFromLoad() : Called after loading a game file from disk,
  * prevents all of the other events from being fired so we just display the mine */
 void MainWindow::displayMineFromLoad(QmsButton *msb) {
-    drawNumberOfSurroundingMines(msb);
-    msb->setFlat(true);
-    msb->setChecked(true);
+    QmsProgressiveReveal::applyReveal(msb);
     msb->setIsRevealed(true);
 }
 
+/* restoreMineSquare() : Called when an undo or redo puts a cell back into an earlier state.
+ * Like displayMineFromLoad(), no signals are emitted, as the GameController restores the
+ * counters itself. The question mark is cleared first, because clearing either mark also
+ * clears the glyph that the other one may have just set */
+void MainWindow::restoreMineSquare(QmsButton *msb, QmsCellState cellState) {
+    this->m_progressiveReveal->finish();
+    if (cellState.isRevealed()) {
+        this->displayMineFromLoad(msb);
+        return;
+    }
+    msb->setChecked(false);
+    msb->setFlat(false);
+    msb->setIsRevealed(false);
+    msb->setHasQuestionMark(false);
+    msb->setHasFlag(cellState.hasFlag());
+    if (cellState.hasQuestionMark()) {
+        msb->setHasQuestionMark(true);
+    }
+}
+
 /*
 void MainWindow::forceDisplayMine(QmsButton *msb) {
     drawNumberOfSurroundingMines(msb);
@@ -541,22 +839,63 @@ void MainWindow::forceDisplayMine(QmsButton *msb) {
 
 /* populateMineField() : The initialization for any new game, adding all QMineSweeperButtons
  * Iterate through the number of columns and rows and call GameController::addMineSweeperButton
- * to populate all of the QMineSweeperButtons. Also, save the stylesheet so it can be quickly
- * recalled on a new game. The size of the icons and the button itself is also set */
+ * to populate all of the QMineSweeperButtons, most of which are recycled from the previous board.
+ * Only newly created buttons need to be made checkable and handed the repaint scheduler. If the board has the same size as
+ * the one already laid out, every button gets its old layout cell back, so the layout is left alone.
+ * The buttons are sized by the layout, to the cell size the board view starts over at (its default zoom) */
 void MainWindow::populateMineField() {
+    const QSize boardSize{gameController->numberOfColumns(), gameController->numberOfRows()};
+    const bool layoutChanged{boardSize != this->m_mineFieldLayoutSize};
+    const QSize mineSize{this->getMaxMineSize()};
+    this->onBoardCellSizeChanged(mineSize);
+    if (layoutChanged) {
+        QLayoutItem *wItem;
+        while ((wItem = this->m_ui->mineFrameGridLayout->takeAt(this->m_ui->mineFrameGridLayout->count() - 1)) != nullptr) {
+            delete wItem;
+        }
+    }
     for (int rowIndex = 0; rowIndex < gameController->numberOfRows(); rowIndex++) {
         for (int columnIndex = 0; columnIndex < gameController->numberOfColumns(); columnIndex++) {
-            gameController->addMineSweeperButton(columnIndex, rowIndex);
+            const bool buttonCreated{gameController->addMineSweeperButton(columnIndex, rowIndex)};
             std::shared_ptr<QmsButton> tempPtr{gameController->mineSweeperButtonAtIndex(columnIndex, rowIndex)};
-            this->m_ui->mineFrameGridLayout->addWidget(tempPtr.get(), rowIndex, columnIndex, 1, 1);
-            tempPtr->setFixedSize(getMaxMineSize());
-            emit(mineSweeperButtonCreated(tempPtr));
-            tempPtr->setIconSize(tempPtr->size() * MainWindow::MINE_ICON_REDUCTION_SCALE_FACTOR);
-            this->m_saveStyleSheet = tempPtr->styleSheet();
-            tempPtr->setCheckable(true);
+            if (layoutChanged) {
+                this->m_ui->mineFrameGridLayout->addWidget(tempPtr.get(), rowIndex, columnIndex, 1, 1);
+                if (tempPtr->isHidden()) {
+                    tempPtr->show();
+                }
+            }
+            if (buttonCreated) {
+                tempPtr->setCheckable(true);
+                tempPtr->setRepaintScheduler(this->m_boardRepaintScheduler.get());
+            }
         }
     }
-    this->m_saveStyleSheet = gameController->mineSweeperButtonAtIndex(0, 0)->styleSheet();
+    if (layoutChanged) {
+        for (const auto &it : gameController->spareMineSweeperButtons()) {
+            it->hide();
+        }
+        this->m_mineFieldLayoutSize = boardSize;
+    }
+    this->m_boardView->setMaximumViewportSize(this->m_maximumBoardViewportSize);
+    this->m_boardView->setBaseCellSize(mineSize);
+    this->m_boardView->updateContentSize();
+}
+
+/* onBoardCellSizeChanged() : Called when the board view is zoomed, as long as the zoom leaves
+ * cells large enough for the QmsButtons to be shown. The buttons themselves are left alone: the
+ * board view resizes the mine field, whose grid layout hands every button its new cell, and only
+ * the cells inside the viewport get painted. All that is needed here is the atlas for the new
+ * glyph size, started ahead of those paints */
+void MainWindow::onBoardCellSizeChanged(const QSize &cellSize) {
+    applicationIcons->iconAtlas()->prepareGlyphSize(cellSize * QmsButton::GLYPH_SCALE_FACTOR,
+                                                    this->m_ui->mineFrame->devicePixelRatioF());
+}
+
+/* onBoardContentSizeChanged() : The minimap is only shown while the board
+ * does not fit in the board view, and the window follows the view's size */
+void MainWindow::onBoardContentSizeChanged() {
+    this->m_minimapDock->setVisible(this->m_boardView->isOverflowing());
+    this->centerAndFitWindow(true, true);
 }
 
 /* invalidateSizeCaches() : The maximum size of a QMineSweeperButton and the
@@ -591,34 +930,31 @@ QSize MainWindow::getIconReductionSize() {
  * of maximum height or maximum width will be returned from this function, to keep
  * the QMineSweeperButton geometry as a square, as opposed to a rectangle. This function
  * first checks if the cache for this number is still valid, and if it's not, calculates the new value.
- * It is dependant on the available geometry of the screen, as well as the total number of mines */
+ * It is dependant on the available geometry of the screen the window is on (cached per screen by
+ * QmsScreenMetrics), as well as the size of the board, so a cached value is only used for both.
+ * Boards too large for the screen get MainWindow::MINIMUM_MINE_SIZE buttons, and are scrolled and zoomed
+ * out through the board view, which is given the space the board would have had to fit in */
 QSize MainWindow::getMaxMineSize() {
-    using namespace QmsStrings;
-    QDesktopWidget qDesktopWidget{};
-    if (!this->m_maxMineSizeCacheIsValid) {
-        int defaultMineSize{qDesktopWidget.availableGeometry().height() / this->DEFAULT_MINE_SIZE_SCALE_FACTOR};
+    QScreen *screen{this->currentScreen()};
+    const QSize boardSize{gameController->numberOfColumns(), gameController->numberOfRows()};
+    if ((!this->m_maxMineSizeCacheIsValid) || (screen != this->m_maxMineSizeScreen) || (boardSize != this->m_maxMineSizeBoardSize)) {
+        const QRect availableGeometry{this->m_screenMetrics->geometryOf(screen).availableGeometry};
+        int defaultMineSize{availableGeometry.height() / this->DEFAULT_MINE_SIZE_SCALE_FACTOR};
         this->m_currentDefaultMineSize = QSize{defaultMineSize, defaultMineSize};
         int statusBarHeight{this->m_ui->statusBar->height()};
         int menuBarHeight{this->m_ui->menuBar->height()};
         int titleFrameHeight{this->m_ui->titleFrame->height()};
         int gridSpacingHeight{this->centralWidget()->layout()->margin() * this->NUMBER_OF_VERTIAL_MARGINS};
         int gridSpacingWidth{this->centralWidget()->layout()->margin() * this->NUMBER_OF_HORIZONTAL_MARGINS};
-        int heightScale{qDesktopWidget.availableGeometry().height() / this->HEIGHT_SCALE_FACTOR};
-        int widthScale{qDesktopWidget.availableGeometry().width() / this->WIDTH_SCALE_FACTOR};
+        int heightScale{availableGeometry.height() / this->HEIGHT_SCALE_FACTOR};
+        int widthScale{availableGeometry.width() / this->WIDTH_SCALE_FACTOR};
         int extraHeight{statusBarHeight + menuBarHeight + titleFrameHeight + gridSpacingHeight};
-        int x{(qDesktopWidget.availableGeometry().height() - extraHeight - TASKBAR_HEIGHT - heightScale) /
-              gameController->numberOfRows()};
-        int y{(qDesktopWidget.availableGeometry().width() - gridSpacingWidth - widthScale) /
-              gameController->numberOfColumns()};
-        if ((x < 5) || (y < 5)) {
-            //TODO: Deal with too small to play mines
-            std::unique_ptr<QMessageBox> errorBox{new QMessageBox{}};
-            errorBox->setWindowTitle(MainWindow::tr(MAIN_WINDOW_TITLE));
-            errorBox->setText(tr(GENERIC_ERROR_MESSAGE));
-            errorBox->setWindowIcon(applicationIcons->MINE_ICON_48);
-            errorBox->exec();
-            exit(EXIT_FAILURE);
-        }
+        this->m_maximumBoardViewportSize = QSize{availableGeometry.width() - gridSpacingWidth - widthScale,
+                                                 availableGeometry.height() - extraHeight - TASKBAR_HEIGHT - heightScale};
+        int x{std::max(MainWindow::MINIMUM_MINE_SIZE,
+                       this->m_maximumBoardViewportSize.height() / gameController->numberOfRows())};
+        int y{std::max(MainWindow::MINIMUM_MINE_SIZE,
+                       this->m_maximumBoardViewportSize.width() / gameController->numberOfColumns())};
         if ((x >= m_currentDefaultMineSize.width()) && (y >= m_currentDefaultMineSize.height())) {
             this->m_currentMaxMineSize = this->m_currentDefaultMineSize;
         } else if (x < m_currentDefaultMineSize.width()) {
@@ -630,11 +966,57 @@ QSize MainWindow::getMaxMineSize() {
         } else {
             this->m_currentMaxMineSize = QSize{y, y};
         }
+        this->m_maxMineSizeScreen = screen;
+        this->m_maxMineSizeBoardSize = boardSize;
         this->m_maxMineSizeCacheIsValid = true;
     }
     return this->m_currentMaxMineSize;
 }
 
+QScreen *MainWindow::currentScreen() const {
+    return this->windowHandle() ? this->windowHandle()->screen() : QGuiApplication::primaryScreen();
+}
+
+void MainWindow::onScreenMetricsChanged(QScreen *screen) {
+    if (screen == this->m_maxMineSizeScreen) {
+        this->scheduleScreenRelayout();
+    }
+}
+
+/* scheduleScreenRelayout() : Moving to another monitor emits screenChanged() and usually a
+ * geometry or DPI change as well, so the board is laid out again once for all of them */
+void MainWindow::scheduleScreenRelayout() {
+    if (!this->m_screenRelayoutPending) {
+        this->m_screenRelayoutPending = true;
+        QMetaObject::invokeMethod(this, "relayoutForScreen", Qt::QueuedConnection);
+    }
+}
+
+/* relayoutForScreen() : The cell size is computed again for the screen the window is on now.
+ * The buttons are only resized if that gives a different size; the board view is updated
+ * either way, since the room it is given depends on the screen too. A screen with another
+ * device pixel ratio needs another atlas even for the same cell size, so it is prepared
+ * either way too (which does nothing if the atlas for it is already there) */
+void MainWindow::relayoutForScreen() {
+    this->m_screenRelayoutPending = false;
+    if (this->m_mineFieldLayoutSize.isEmpty()) {
+        return;
+    }
+    const QSize previousMineSize{this->m_currentMaxMineSize};
+    this->m_maxMineSizeCacheIsValid = false;
+    const QSize mineSize{this->getMaxMineSize()};
+    LOG_DEBUG() << QString{"Laying out the board again for a new screen (cell size %1 -> %2)"}.arg(
+            QS_NUMBER(previousMineSize.width()), QS_NUMBER(mineSize.width()));
+    this->m_boardView->setMaximumViewportSize(this->m_maximumBoardViewportSize);
+    if (mineSize != previousMineSize) {
+        this->m_boardView->setBaseCellSize(mineSize);
+        this->onBoardCellSizeChanged(mineSize);
+    } else {
+        this->onBoardCellSizeChanged(this->m_boardView->cellSize());
+    }
+    this->m_boardView->updateContentSize();
+}
+
 /* resizeResetIcon(): The reset button's icon is set separate from the rest of the
  * QMineSweeperButton icons, because it can be any size, independant of the rest of
  * the icons. The value is calculated based upon the size of the adjacent LCDs */
@@ -658,34 +1040,34 @@ void MainWindow::setResetButtonIcon(const QIcon &icon) {
 
 /* displayAllMines() : Called when a game is won or lost, to reveal all of the
  * QMineSweeperButtons. This also displays any correctly or incorrectly marked
- * flags, to show the user where they made mistakes or were correct */
+ * flags, to show the user where they made mistakes or were correct. Every button is changed
+ * inside one repaint batch, so the board is repainted once rather than once per button, and
+ * passed to GameController::notifyCellChanged(), so the cell grid, the state hash and the board
+ * summary (the overview and minimap) show the revealed board too */
 void MainWindow::displayAllMines() {
     using namespace QmsStrings;
     this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_FROWNY);
     gameController->setGameOver(true);
+    this->m_boardRepaintScheduler->beginBatch();
+    this->m_progressiveReveal->finish();
     for (auto &it : gameController->mineSweeperButtons()) {
         if (it.second->hasMine()) {
             if (it.second->hasFlag()) {
-                it.second->setIcon(applicationIcons->STATUS_ICON_FLAG_CHECK);
+                it.second->setGlyph(CellGlyph::FlagCheck);
                 it.second->setChecked(true);
             } else {
-                it.second->setIcon(applicationIcons->MINE_ICON_72);
+                it.second->setGlyph(CellGlyph::Mine);
                 it.second->setChecked(true);
-                it.second->setStyleSheet(UNCOVERED_MINE_STYLESHEET);
+                it.second->setShowsUncoveredMine(true);
             }
         } else if (it.second->hasFlag()) {
-            it.second->setIcon(applicationIcons->STATUS_ICON_FLAG_X);
+            it.second->setGlyph(CellGlyph::FlagX);
             it.second->setChecked(true);
         }
         it.second->setIsRevealed(true);
+        gameController->notifyCellChanged(it.second.get());
     }
-}
-
-/* saveStyleSheet() : The default Qt-supplied stylesheet for the
- * QMineSweeperButtons is saved to quickly recall it, this is a
- * simple member access function for this value */
-QString MainWindow::saveStyleSheet() const {
-    return this->m_saveStyleSheet;
+    this->m_boardRepaintScheduler->endBatch();
 }
 
 /* onResetButtonClicked() : When the reset button is clicked, the user is requesting
@@ -694,7 +1076,12 @@ QString MainWindow::saveStyleSheet() const {
  * are sure they want to reset the current game. If so, the game is reset via
  * the doGameReset() method. If not, a gameResumed() signal is emitted */
 void MainWindow::onResetButtonClicked() {
+    QMS_INSTRUMENT_SCOPE("Reset button");
     using namespace QmsStrings;
+    if (gameController->isReplayPlaybackActive()) {
+        this->stopReplay();
+        return;
+    }
     emit(gamePaused());
     if (!gameController->gameOver() && !gameController->initialClickFlag()) {
         QMessageBox::StandardButton userReply;
@@ -713,19 +1100,21 @@ void MainWindow::onResetButtonClicked() {
 
 /* doGameReset() : To reset the current game, all of the columns and rows
  * are iterated through and each QMineSweeperButton is set to a default state,
- * (not checked, flat, default stylesheet, etc). After all are set, a
+ * (not checked, flat, no uncovered mine highlight, etc). After all are set, a
  * resetGame() signal is emitted and the reset button is set to default */
 void MainWindow::doGameReset() {
     using namespace QmsStrings;
     this->m_boardResizeDialog->hide();
+    this->m_progressiveReveal->cancel();
+    this->m_boardRepaintScheduler->beginBatch();
     for (auto &it : gameController->mineSweeperButtons()) {
         it.second->setChecked(false);
         it.second->setFlat(false);
-        it.second->setStyleSheet(this->m_saveStyleSheet);
-        it.second->setIcon(applicationIcons->COUNT_MINES_0);
-        it.second->setEnabled(true);
+        it.second->setShowsUncoveredMine(false);
+        it.second->setGlyph(CellGlyph::None);
         it.second->setIsRevealed(false);
     }
+    this->m_boardRepaintScheduler->endBatch();
 
     this->m_saveFilePath = "";
     emit(resetGame());
@@ -733,18 +1122,40 @@ void MainWindow::doGameReset() {
     this->displayStatusMessage(QStatusBar::tr(START_NEW_GAME_INSTRUCTION));
 }
 
-/* eventLoop() : Called whenever the game timer times out, at the specified interval.
- * Any periodic things that must be done during the game are called here, such as
- * updating the visible game timer, and any resizing of the geometry */
-void MainWindow::eventLoop() {
-    this->updateVisibleGameTimer();
-    this->updateUserIdleTimer();
-    this->updateMyGeometry();
+/* event() : The window is fitted to its minimum size whenever that might have changed, which
+ * is after a resize or after the central layout was invalidated (the board or the board view
+ * changed size). Layout requests are handled by the layout before they get here, so the
+ * minimum size is already up to date by the time updateMyGeometry() runs */
+bool MainWindow::event(QEvent *event) {
+    if (event->type() == QEvent::UpdateRequest) {
+        bool handled{false};
+        {
+            QMS_INSTRUMENT_SCOPE(QmsLatencyOverlay::FRAME_HISTOGRAM_NAME());
+            handled = MouseMoveableQMainWindow::event(event);
+        }
+        QmsInputLatency::markPainted();
+        return handled;
+    }
+    const bool handled{MouseMoveableQMainWindow::event(event)};
+    if ((event->type() == QEvent::Resize) || (event->type() == QEvent::LayoutRequest)) {
+        this->scheduleGeometryUpdate();
+    }
+    return handled;
+}
+
+/* scheduleGeometryUpdate() : Several resizes and layout requests arrive together
+ * (and a screen change brings its own), so the window is fitted once for all of them */
+void MainWindow::scheduleGeometryUpdate() {
+    if (!this->m_geometryUpdatePending) {
+        this->m_geometryUpdatePending = true;
+        QMetaObject::invokeMethod(this, "updateMyGeometry", Qt::QueuedConnection);
+    }
 }
 
 /* updateMyGeometry() : Convenience function to center and fit the window,
  * if it is not already set by checking the size against the calculated minimum size */
 void MainWindow::updateMyGeometry() {
+    this->m_geometryUpdatePending = false;
     if (this->size() != this->minimumSize()) {
         this->centerAndFitWindow(true, true);
     }
@@ -756,58 +1167,72 @@ void MainWindow::startGameTimer() {
     gameController->startPlayTimer();
 }
 
-/* startUserIdleTimer() : Called after each move made by a player.
- * The user idle timer keeps track of when the user is idle, and is checked
- * against a threshold value. If/when the user idle timer crosses the
- * threshold, the reset icon is changed to a sleepy face */
+/* startUserIdleTimer() : Called after each move made by a player, via the userIsNoLongerIdle()
+ * signal. The user idle timer is a single shot timer, which changes the reset icon to a sleepy
+ * face if the player makes no move for GameController::DEFAULT_SLEEPY_FACE_TIMEOUT() */
 void MainWindow::startUserIdleTimer() {
     if (gameController->gameState() == GameState::GameActive) {
-        this->m_userIdleTimer->restart();
+        this->m_userIdleTimeRemaining = 0;
+        this->m_userIdleTimer->start();
     }
 }
 
-/* updateVisibleGameTimer() : Called in the main eventLoop() to update the visible timer to inform the player 
- * how long they've been playing the current game. Before updating, the current game state is checked from
- * the GameController::gameState() method. If the game is paused or in progress, the timer is updated.
- * If the game is stopped, the timer is not updated, and the "start new game" dialog is shown instead */
-void MainWindow::updateVisibleGameTimer() {
-    using namespace QmsUtilities;
-    using namespace QmsStrings;
-    QString gameTime{""};
+void MainWindow::onUserIdleTimeout() {
     if (gameController->gameState() == GameState::GameActive) {
+        this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_SLEEPY);
+    }
+}
+
+/* onGameStateChanged() : The play timer and the user idle timer only run while the game is
+ * active. A paused game keeps what was left of the idle timeout, to pick up where it left off,
+ * while a game that is over (or not started yet) drops it. Nothing is left running otherwise */
+void MainWindow::onGameStateChanged(GameState gameState) {
+    if (gameState == GameState::GameActive) {
         if (gameController->playTimer().isPaused()) {
             gameController->resumePlayTimer();
         }
-        gameTime = toQString(
-                gameController->playTimer().toString(static_cast<uint8_t>(GameController::MILLISECOND_DELAY_DIGITS())));
-        this->displayStatusMessage(gameTime);
-    } else if (!gameController->initialClickFlag()) {
-        gameController->pausePlayTimer();
-        gameTime = toQString(
-                gameController->playTimer().toString(static_cast<uint8_t>(GameController::MILLISECOND_DELAY_DIGITS())));
-        this->displayStatusMessage(gameTime);
+        if (this->m_userIdleTimeRemaining > 0) {
+            this->m_userIdleTimer->start(this->m_userIdleTimeRemaining);
+            this->m_userIdleTimeRemaining = 0;
+        }
     } else {
-        this->displayStatusMessage(QStatusBar::tr(START_NEW_GAME_INSTRUCTION));
+        if (!gameController->initialClickFlag()) {
+            gameController->pausePlayTimer();
+        }
+        if ((gameState == GameState::GamePaused) && this->m_userIdleTimer->isActive()) {
+            this->m_userIdleTimeRemaining = this->m_userIdleTimer->remainingTime();
+        } else if (gameState != GameState::GamePaused) {
+            this->m_userIdleTimeRemaining = 0;
+        }
+        this->m_userIdleTimer->stop();
     }
+    this->updateVisibleGameTimer();
 }
 
-/* updateUserIdleTimer() : If the current game state is not paused or stopped,
- * the user idle timer is checked, the see if it has crossed the GameControllers
- * DEFAULT_SLEEPY_FACE_TIMEOUT threshold. If it has, the reset icon is changed to
- * a sleepy face. If it has not, the method returns */
-void MainWindow::updateUserIdleTimer() {
-    if (gameController->gameState() == GameState::GameActive) {
-        if (this->m_userIdleTimer->isPaused()) {
-            this->m_userIdleTimer->resume();
-        }
-    } else if (!gameController->initialClickFlag()) {
-        this->m_userIdleTimer->pause();
-        this->m_userIdleTimer->update();
+/* updateVisibleGameTimer() : Updates the visible timer to inform the player how long they've been
+ * playing the current game. While the game is active, the next update is scheduled for the moment
+ * the last displayed digit changes (every 100 milliseconds for one millisecond digit), instead of
+ * polling. If the game is paused or over, the time is shown once and left alone, and if no game
+ * has been started yet, the "start new game" instruction is shown instead */
+void MainWindow::updateVisibleGameTimer() {
+    using namespace QmsUtilities;
+    using namespace QmsStrings;
+    SteadyEventTimer playTimer{gameController->playTimer()};
+    if ((gameController->gameState() == GameState::GameActive) || (!gameController->initialClickFlag())) {
+        this->displayStatusMessage(toQString(playTimer.toString(static_cast<uint8_t>(GameController::MILLISECOND_DELAY_DIGITS()))));
+    } else {
+        this->displayStatusMessage(QStatusBar::tr(START_NEW_GAME_INSTRUCTION));
     }
     if (gameController->gameState() == GameState::GameActive) {
-        if (this->m_userIdleTimer->totalTime() >= gameController->DEFAULT_SLEEPY_FACE_TIMEOUT()) {
-            this->m_ui->resetButton->setIcon(applicationIcons->FACE_ICON_SLEEPY);
+        int displayResolution{1000};
+        for (int digit = 0; digit < GameController::MILLISECOND_DELAY_DIGITS(); digit++) {
+            displayResolution /= 10;
         }
+        displayResolution = std::max(1, displayResolution);
+        const auto elapsedInDigit = static_cast<int>(playTimer.totalMilliseconds() % displayResolution);
+        this->m_gameTimerDisplayTimer->start(displayResolution - elapsedInDigit);
+    } else {
+        this->m_gameTimerDisplayTimer->stop();
     }
 }
 
@@ -822,6 +1247,7 @@ std::string MainWindow::getLCDPadding(uint8_t howMuch) {
  * emitted by the GameController, and this method is called. All mines are displayed, and the mineExplosionEvent
  * is re-emitted by MainWindow, indicating that all UI elements of a game over are taken care of */
 void MainWindow::onMineExplosionEventTriggered() {
+    QMS_INSTRUMENT_SCOPE("Mine explosion");
     using namespace QmsUtilities;
     displayAllMines();
     applicationSoundEffects->explosionEffect().play();
@@ -837,6 +1263,26 @@ void MainWindow::onActionMuteSoundChecked(bool checked) {
             (checked ? QS_NUMBER(QmsSettingsLoader::DEFAULT_AUDIO_VOLUME) : "0"));
 }
 
+/* onActionRippleRevealChecked() : Called when the "Ripple Reveal" menu option is clicked.
+ * If the option is checked, cells uncovered by a cascade are drawn spreading out from the
+ * clicked cell, instead of all at once */
+void MainWindow::onActionRippleRevealChecked(bool checked) {
+    this->m_progressiveReveal->setRippleEnabled(checked);
+    LOG_INFO() << QString{"Ripple reveal %1"}.arg(checked ? "enabled" : "disabled");
+}
+
+/* onActionShowLatencyOverlayChecked() : Called when the "Show Latency Overlay" menu option is
+ * clicked. The overlay sits in the corner of the board, over the mine field */
+void MainWindow::onActionShowLatencyOverlayChecked(bool checked) {
+    this->m_latencyOverlay->setVisible(checked);
+}
+
+/* setRippleReveal() : Applies the ripple reveal setting loaded at startup */
+void MainWindow::setRippleReveal(bool rippleReveal) {
+    this->m_ui->actionRippleReveal->setChecked(rippleReveal);
+    this->m_progressiveReveal->setRippleEnabled(rippleReveal);
+}
+
 /* onChangeBoardSizeActionTriggered() : Called when the "change board size" menu option
  * is triggered. The current game is first paused, then the user is shown the BoardSize form.
  * The MainWindow flag m_boardSizeGeometrySet is checked, and if it is false, the geometry for the
@@ -882,37 +1328,10 @@ void MainWindow::onAboutQMineSweeperActionTriggered() {
 }
 
 /* onApplicationExit() : Called when the QApplication is about to close,
- * via hooking the QApplication::exit() event in main.cpp, empty by default */
+ * via hooking the QApplication::exit() event in main.cpp. A game still
+ * in progress is saved as a replay, so it is not lost on exit */
 void MainWindow::onApplicationExit() {
-
-}
-
-/* drawNumberOfSurroundingMines() : Called when a mine is about to be displayed
- * Queries the shared_ptr passed in for it's number of surrounding mines, then
- * uses the shared_ptr to the QMineSweeperIcons instance to set the graphic on the
- * QMineSweeperButton to the correct number via chained else-ifs */
-void MainWindow::drawNumberOfSurroundingMines(QmsButton *msb) {
-    if (msb->numberOfSurroundingMines() == 0) {
-        msb->setIcon(applicationIcons->COUNT_MINES_0);
-    } else if (msb->numberOfSurroundingMines() == 1) {
-        msb->setIcon(applicationIcons->COUNT_MINES_1);
-    } else if (msb->numberOfSurroundingMines() == 2) {
-        msb->setIcon(applicationIcons->COUNT_MINES_2);
-    } else if (msb->numberOfSurroundingMines() == 3) {
-        msb->setIcon(applicationIcons->COUNT_MINES_3);
-    } else if (msb->numberOfSurroundingMines() == 4) {
-        msb->setIcon(applicationIcons->COUNT_MINES_4);
-    } else if (msb->numberOfSurroundingMines() == 5) {
-        msb->setIcon(applicationIcons->COUNT_MINES_5);
-    } else if (msb->numberOfSurroundingMines() == 6) {
-        msb->setIcon(applicationIcons->COUNT_MINES_6);
-    } else if (msb->numberOfSurroundingMines() == 7) {
-        msb->setIcon(applicationIcons->COUNT_MINES_7);
-    } else if (msb->numberOfSurroundingMines() == 8) {
-        msb->setIcon(applicationIcons->COUNT_MINES_8);
-    } else {
-        msb->setIcon(applicationIcons->COUNT_MINES_0);
-    }
+    gameController->finishReplayRecording();
 }
 
 /* ~MainWindow() : Destructor, empty by default, as all ownership is taken care
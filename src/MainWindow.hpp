@@ -50,10 +50,38 @@ class QDialog;
 
 class QPoint;
 
+class QDockWidget;
+
 class QMoveEvent;
 
 class AboutApplicationWidget;
 
+class QmsReplay;
+
+class QmsBoardPack;
+
+class QmsReplayPlayer;
+
+class QmsReplayControls;
+
+class QmsPauseOverlay;
+
+class QmsLatencyOverlay;
+
+class QmsBoardInputDispatcher;
+
+class QmsBoardRepaintScheduler;
+
+class QmsProgressiveReveal;
+
+class QmsBoardView;
+
+class QmsBoardMinimap;
+
+class QmsScreenMetrics;
+
+class QScreen;
+
 class MainWindow : public MouseMoveableQMainWindow {
 Q_OBJECT
 public:
@@ -66,34 +94,53 @@ public:
     void resizeResetIcon();
     void displayMineSquare(QmsButton *msb);
     void displayMineFromLoad(QmsButton *msb);
+    void restoreMineSquare(QmsButton *msb, QmsCellState cellState);
     void setResetButtonIcon(const QIcon &icon);
-    void drawNumberOfSurroundingMines(QmsButton *msb);
     void setLanguage(QmsSettingsLoader::SupportedLanguage newLanguage);
     bool boardResizeDialogVisible();
+    bool playFromPack(const QString &filePath, int boardIndex);
+    void setRippleReveal(bool rippleReveal);
 
     QmsApplicationSettings collectApplicationSettings() const;
-    QString saveStyleSheet() const;
 
 private:
-    std::unique_ptr<QTimer> m_eventTimer;
-    std::unique_ptr<SteadyEventTimer> m_userIdleTimer;
+    std::unique_ptr<QTimer> m_gameTimerDisplayTimer;
+    std::unique_ptr<QTimer> m_userIdleTimer;
+    int m_userIdleTimeRemaining;
+    bool m_geometryUpdatePending;
     std::unique_ptr<AboutApplicationWidget> m_aboutQmsDialog;
     std::unique_ptr<BoardResizeWidget> m_boardResizeDialog;
     std::unique_ptr<QActionGroup> m_languageActionGroup;
+    std::unique_ptr<QActionGroup> m_iconPaletteActionGroup;
     std::unique_ptr<QTranslator> m_translator;
     std::unique_ptr<QLabel> m_statusBarLabel;
     QmsSettingsLoader::SupportedLanguage m_language;
 
     double m_reductionSizeScaleFactor;
-    QString m_saveStyleSheet;
     QSize m_currentDefaultMineSize;
     QSize m_currentMaxMineSize;
     QSize m_currentIconReductionSize;
+    QSize m_mineFieldLayoutSize;
+    QSize m_maximumBoardViewportSize;
     bool m_maxMineSizeCacheIsValid;
+    QScreen *m_maxMineSizeScreen;
+    QSize m_maxMineSizeBoardSize;
+    bool m_screenRelayoutPending;
     bool m_iconReductionSizeCacheIsValid;
     bool m_boardSizeGeometrySet;
     QString m_saveFilePath;
     Ui::MainWindow *m_ui;
+    std::unique_ptr<QmsReplayPlayer> m_replayPlayer;
+    std::unique_ptr<QmsReplayControls> m_replayControls;
+    std::unique_ptr<QmsBoardView> m_boardView;
+    std::unique_ptr<QDockWidget> m_minimapDock;
+    std::unique_ptr<QmsBoardMinimap> m_boardMinimap;
+    std::unique_ptr<QmsPauseOverlay> m_pauseOverlay;
+    std::unique_ptr<QmsLatencyOverlay> m_latencyOverlay;
+    std::unique_ptr<QmsBoardInputDispatcher> m_boardInputDispatcher;
+    std::unique_ptr<QmsBoardRepaintScheduler> m_boardRepaintScheduler;
+    std::unique_ptr<QmsProgressiveReveal> m_progressiveReveal;
+    std::unique_ptr<QmsScreenMetrics> m_screenMetrics;
 
     static const int TASKBAR_HEIGHT;
     static const int GAME_TIMER_INTERVAL;
@@ -103,9 +150,10 @@ private:
     static const int NUMBER_OF_HORIZONTAL_MARGINS;
     static const int NUMBER_OF_VERTIAL_MARGINS;
     static const int DEFAULT_MINE_SIZE_SCALE_FACTOR;
+    static const int MINIMUM_MINE_SIZE;
     static const int STATUS_BAR_FONT_POINT_SIZE;
-    static const double MINE_ICON_REDUCTION_SCALE_FACTOR;
 
+    bool event(QEvent *event) override;
     void hideEvent(QHideEvent *event) override;
     void showEvent(QShowEvent *event) override;
     void closeEvent(QCloseEvent *event) override;
@@ -113,6 +161,7 @@ private:
     void invalidateSizeCaches();
     void doGameReset();
     QSize getMaxMineSize();
+    QScreen *currentScreen() const;
     QSize getIconReductionSize();
     std::string getLCDPadding(uint8_t howMuch);
     static const long long int constexpr MILLISECONDS_PER_SECOND{1000};
@@ -122,6 +171,11 @@ private:
 
     void displayStatusMessage(QString statusMessage);
     void doSaveGame(const QString &filePath);
+    void startReplay(const QmsReplay &replay);
+    bool openBoardPack(QmsBoardPack &boardPack, const QString &filePath);
+    bool playPackedBoard(const QmsBoardPack &boardPack, int boardIndex, const QString &filePath);
+    void displayBoardPackError(const QString &filePath, const QString &reason);
+    void refreshMineField();
 signals:
     void resetButtonClicked();
     void resetGame();
@@ -131,13 +185,11 @@ signals:
     void gameResumed();
     void mineDisplayed();
     void winEvent();
-    void mineSweeperButtonCreated(std::shared_ptr<QmsButton> msb);
 
 public slots:
     void resetResetButtonIcon();
     void onGameStarted();
-    void onGamePaused();
-    void onGameResumed();
+    void onPausedChanged(bool paused);
     void onMineExplosionEventTriggered();
     void setupNewGame();
     void onGameWon();
@@ -145,24 +197,38 @@ public slots:
     void startUserIdleTimer();
 
 private slots:
-    void eventLoop();
     void onResetButtonClicked();
     void onAboutQtActionTriggered();
     void onAboutQMineSweeperActionTriggered();
     void onAboutQmsWindowClosed();
     void onApplicationExit();
     void updateVisibleGameTimer();
-    void updateUserIdleTimer();
+    void onUserIdleTimeout();
+    void onGameStateChanged(GameState gameState);
+    void scheduleGeometryUpdate();
+    void scheduleScreenRelayout();
+    void relayoutForScreen();
+    void onScreenMetricsChanged(QScreen *screen);
     void startGameTimer();
     void onChangeBoardSizeActionTriggered();
     void onCustomMineRatioSet(float mineRatio);
+    void onUndoAvailabilityChanged(bool canUndo, bool canRedo);
 
     void onActionMuteSoundChecked(bool checked);
+    void onActionRippleRevealChecked(bool checked);
+    void onActionShowLatencyOverlayChecked(bool checked);
+    void onBoardCellSizeChanged(const QSize &cellSize);
+    void onBoardContentSizeChanged();
 
     void onLanguageSelected(bool triggered);
+    void onIconPaletteSelected(bool triggered);
     void onSaveActionTriggered();
     void onSaveAsActionTriggered();
     void onOpenActionTriggered();
+    void onOpenReplayActionTriggered();
+    void onPlayFromPackActionTriggered();
+    void onReplayStateRestored();
+    void stopReplay();
     void updateMyGeometry();
 
     void onLoadGameCompleted(const std::pair<LoadGameStateResult, std::string> &loadResult,
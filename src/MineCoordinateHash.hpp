@@ -2,15 +2,28 @@
 #define QMINESWEEPER_MINECOORDINATEHASH_HPP
 
 #include "MineCoordinates.hpp"
+#include <cstdint>
 #include <utility>
 
 class MineCoordinateHash {
 public:
     /* operator() : Overloaded operator(), for use as a functor.
-     * This allows the MineCoordinates class to be used in a std::unordered_map */
+     * This allows the MineCoordinates class to be used in a std::unordered_map.
+     * The packed key goes through the splitmix64 finalizer, so every bit of x and y
+     * affects every bit of the hash. Hashing x and y separately and xor-ing the results
+     * (with the identity std::hash<int> of libstdc++) gave every cell on a diagonal the
+     * same hash, and (x,y) the same hash as (y,x) */
     std::size_t operator()(const MineCoordinates &mc) const {
-        //return std::hash<std::pair<int, int>>()(std::make_pair(mc.X(), mc.Y()));
-        return (std::hash<int>()(mc.X()) ^ (std::hash<int>()(mc.Y())));
+        return static_cast<std::size_t>(MineCoordinateHash::mix(mc.key()));
+    }
+
+    static inline uint64_t mix(uint64_t key) {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return key;
     }
 };
 
@@ -17,6 +17,7 @@
 ***********************************************************************/
 
 #include "MineCoordinates.hpp"
+#include "QmsFormat.hpp"
 
 /* MineCoordinates() : Constructor for MineCoordinates using separate
  * x and y parameters, simply copying these elements to m_x and m_y */
@@ -91,14 +92,22 @@ bool MineCoordinates::operator>=(const MineCoordinates &compareObject) const {
     return ((*this > compareObject) || (*this == compareObject));
 }
 
+/* formatted() : The coordinate pair as "(x,y)", written into a buffer on the stack. Called
+ * for every cell of the board when a game is saved, so it does not go through CSStringFormat() */
+static QmsFormatBuffer<2 * QmsFormat::INTEGER_CHARACTER_COUNT + 3> formatted(int x, int y) {
+    QmsFormatBuffer<2 * QmsFormat::INTEGER_CHARACTER_COUNT + 3> text{};
+    text.append('(').appendInteger(x).append(',').appendInteger(y).append(')');
+    return text;
+}
+
 /* toString() : A string representation of the coordinate pair */
 std::string MineCoordinates::toString() const {
-    return QmsUtilities::CSStringFormat("({0},{1})", this->m_x, this->m_y);
+    return formatted(this->m_x, this->m_y).toStdString();
 }
 
 /* toQString() : A string representation of the coordinate pair */
 QString MineCoordinates::toQString() const {
-    return QmsUtilities::QStringFormat("({0},{1})", this->m_x, this->m_y);
+    return formatted(this->m_x, this->m_y).toQString();
 }
 
 MineCoordinates MineCoordinates::parse(const std::string &str) {
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <iostream>
@@ -29,6 +30,12 @@ public:
     std::string toString() const;
     QString toQString() const;
     std::pair<int, int> toStdPair() const;
+
+    /* key() : Both coordinates packed into one integer, x in the high half. Two
+     * coordinates are equal exactly when their keys are, so it is what gets hashed */
+    inline uint64_t key() const {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(this->m_x)) << 32) | static_cast<uint32_t>(this->m_y);
+    }
     friend std::ostream &operator<<(std::ostream &os, const MineCoordinates &mc);
 
     static MineCoordinates parse(const std::string &str);
@@ -2,9 +2,11 @@
 
 #include <QPoint>
 #include <QMouseEvent>
-#include <QDesktopWidget>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
 #include <QPair>
-#include <memory>
+#include <QRect>
 
 MouseMoveableQMainWindow::MouseMoveableQMainWindow(QWidget *parent) :
         QMainWindow{parent},
@@ -53,13 +55,16 @@ void MouseMoveableQMainWindow::centerAndFitWindow(bool setMinimumSize, bool setF
     this->move(resultPosition.first, resultPosition.second);
 }
 
+/* calculateXYPlacement() : Centered on the screen the window is on, which
+ * is not necessarily the primary one, so refitting never moves it elsewhere */
 QPair<int, int> MouseMoveableQMainWindow::calculateXYPlacement() {
-    std::unique_ptr<QRect> avail{new QRect{QDesktopWidget{}.availableGeometry()}};
-    int x{(avail->width() / 2) - (this->width() / 2)};
+    QScreen *screen{this->windowHandle() ? this->windowHandle()->screen() : QGuiApplication::primaryScreen()};
+    const QRect avail{screen ? screen->availableGeometry() : QRect{}};
+    int x{avail.x() + (avail.width() / 2) - (this->width() / 2)};
 #if defined(__ANDROID__)
-    int y{avail->height() - this->height()};
+    int y{avail.y() + avail.height() - this->height()};
 #else
-    int y{(avail->height() / 2) - (this->height() / 2)};
+    int y{avail.y() + (avail.height() / 2) - (this->height() / 2)};
 #endif
     return QPair<int, int>{x, y};
 }
@@ -0,0 +1,331 @@
+#include "QmsAllocationTracker.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdlib>
+#include <new>
+
+#if defined(QMS_ALLOCATION_TRACKING) && defined(__GLIBC__)
+#    define QMS_ALLOCATION_TRACKING_MALLOC
+#    include <cerrno>
+#endif
+
+namespace {
+
+    /* ThreadAllocationCounters : Trivial, so the thread_local needs no initialization guard,
+     * which matters because its first use is from inside malloc() or operator new */
+    struct ThreadAllocationCounters {
+        uint64_t allocationCount;
+        uint64_t allocatedBytes;
+    };
+
+    thread_local ThreadAllocationCounters threadCounters{0, 0};
+    std::atomic<uint64_t> processAllocationCount{0};
+    std::atomic<uint64_t> processAllocatedBytes{0};
+    std::atomic<uint64_t> processDeallocationCount{0};
+
+}
+
+#if defined(QMS_ALLOCATION_TRACKING)
+
+namespace {
+
+    inline void countAllocation(std::size_t size) {
+        threadCounters.allocationCount++;
+        threadCounters.allocatedBytes += size;
+        processAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        processAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline void countDeallocation(void *pointer) {
+        if (pointer) {
+            processDeallocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+}
+
+#endif //defined(QMS_ALLOCATION_TRACKING)
+
+#if defined(QMS_ALLOCATION_TRACKING_MALLOC)
+
+/* With glibc, malloc() and its relatives are replaced in the executable, which the dynamic linker
+ * binds every library's calls to ahead of the C library's own, so the buffers Qt allocates for
+ * QString, QByteArray, QImage and its containers are counted too. The real allocator is reached
+ * through the __libc_ entry points glibc exports for this. libstdc++'s operator new calls malloc(),
+ * so it is counted here as well, and is not replaced */
+extern "C" {
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *pointer, std::size_t size);
+    void *__libc_memalign(std::size_t alignment, std::size_t size);
+    void *__libc_valloc(std::size_t size);
+    void *__libc_pvalloc(std::size_t size);
+    void __libc_free(void *pointer);
+
+    void *malloc(std::size_t size) {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(std::size_t count, std::size_t size) {
+        countAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    /* realloc() : Counted as an allocation of the new size, as that is what it costs
+     * when the block moves. Shrinking to nothing frees the block instead */
+    void *realloc(void *pointer, std::size_t size) {
+        if ((pointer != nullptr) && (size == 0)) {
+            countDeallocation(pointer);
+        } else {
+            countAllocation(size);
+        }
+        return __libc_realloc(pointer, size);
+    }
+
+    void *memalign(std::size_t alignment, std::size_t size) {
+        countAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void *aligned_alloc(std::size_t alignment, std::size_t size) {
+        countAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void **pointer, std::size_t alignment, std::size_t size) {
+        if ((alignment < sizeof(void *)) || ((alignment & (alignment - 1)) != 0)) {
+            return EINVAL;
+        }
+        countAllocation(size);
+        void *allocated{__libc_memalign(alignment, size)};
+        if (!allocated) {
+            return ENOMEM;
+        }
+        *pointer = allocated;
+        return 0;
+    }
+
+    void *valloc(std::size_t size) {
+        countAllocation(size);
+        return __libc_valloc(size);
+    }
+
+    void *pvalloc(std::size_t size) {
+        countAllocation(size);
+        return __libc_pvalloc(size);
+    }
+
+    void free(void *pointer) {
+        countDeallocation(pointer);
+        __libc_free(pointer);
+    }
+}
+
+#elif defined(QMS_ALLOCATION_TRACKING)
+
+namespace {
+
+    void *trackedAllocate(std::size_t size) {
+        countAllocation(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void trackedDeallocate(void *pointer) {
+        countDeallocation(pointer);
+        std::free(pointer);
+    }
+
+}
+
+void *operator new(std::size_t size) {
+    void *pointer{trackedAllocate(size)};
+    if (!pointer) {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void *operator new[](std::size_t size) {
+    void *pointer{trackedAllocate(size)};
+    if (!pointer) {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    trackedDeallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    trackedDeallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    trackedDeallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    trackedDeallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    trackedDeallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    trackedDeallocate(pointer);
+}
+
+#endif //defined(QMS_ALLOCATION_TRACKING_MALLOC) || defined(QMS_ALLOCATION_TRACKING)
+
+QmsAllocationRegion::QmsAllocationRegion(const char *name) :
+        QmsRegistered{},
+        m_name{name},
+        m_entryCount{0},
+        m_allocationCount{0},
+        m_allocatedBytes{0},
+        m_maximumAllocationCount{0} {
+
+}
+
+void QmsAllocationRegion::addEntry(uint64_t allocationCount, uint64_t allocatedBytes) {
+    this->m_entryCount.fetch_add(1, std::memory_order_relaxed);
+    this->m_allocationCount.fetch_add(allocationCount, std::memory_order_relaxed);
+    this->m_allocatedBytes.fetch_add(allocatedBytes, std::memory_order_relaxed);
+    uint64_t maximumAllocationCount{this->m_maximumAllocationCount.load(std::memory_order_relaxed)};
+    while ((allocationCount > maximumAllocationCount) &&
+           (!this->m_maximumAllocationCount.compare_exchange_weak(maximumAllocationCount, allocationCount,
+                                                                  std::memory_order_relaxed))) {}
+}
+
+const char *QmsAllocationRegion::name() const {
+    return this->m_name;
+}
+
+uint64_t QmsAllocationRegion::entryCount() const {
+    return this->m_entryCount.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsAllocationRegion::allocationCount() const {
+    return this->m_allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsAllocationRegion::allocatedBytes() const {
+    return this->m_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsAllocationRegion::maximumAllocationCount() const {
+    return this->m_maximumAllocationCount.load(std::memory_order_relaxed);
+}
+
+/* countedAllocator() : What the numbers cover, which is written to the report, as without
+ * glibc only what goes through operator new is seen */
+const char *QmsAllocationTracker::countedAllocator() {
+#if defined(QMS_ALLOCATION_TRACKING_MALLOC)
+    return "malloc";
+#elif defined(QMS_ALLOCATION_TRACKING)
+    return "operator new";
+#else
+    return "none";
+#endif
+}
+
+QmsAllocationScope::QmsAllocationScope(QmsAllocationRegion &region) :
+        m_region{region},
+        m_startAllocationCount{threadCounters.allocationCount},
+        m_startAllocatedBytes{threadCounters.allocatedBytes} {
+
+}
+
+QmsAllocationScope::~QmsAllocationScope() {
+    this->m_region.addEntry(threadCounters.allocationCount - this->m_startAllocationCount,
+                            threadCounters.allocatedBytes - this->m_startAllocatedBytes);
+}
+
+bool QmsAllocationTracker::isEnabled() {
+#if defined(QMS_ALLOCATION_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t QmsAllocationTracker::threadAllocationCount() {
+    return threadCounters.allocationCount;
+}
+
+uint64_t QmsAllocationTracker::threadAllocatedBytes() {
+    return threadCounters.allocatedBytes;
+}
+
+uint64_t QmsAllocationTracker::totalAllocationCount() {
+    return processAllocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsAllocationTracker::totalAllocatedBytes() {
+    return processAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsAllocationTracker::totalDeallocationCount() {
+    return processDeallocationCount.load(std::memory_order_relaxed);
+}
+
+/* report() : Logs the totals of every region that was entered, and writes the same numbers
+ * (plus the process wide totals) to jsonFilePath. Called once, as the program exits */
+void QmsAllocationTracker::report(const QString &jsonFilePath) {
+    if (!QmsAllocationTracker::isEnabled()) {
+        return;
+    }
+    QJsonArray regions{};
+    for (const QmsAllocationRegion *region = QmsAllocationRegion::first(); region != nullptr; region = region->next()) {
+        const uint64_t entryCount{region->entryCount()};
+        if (entryCount == 0) {
+            continue;
+        }
+        LOG_INFO() << QString{"Allocations in %1: %2 in %3 calls (%4 bytes, at most %5 in one call)"}.arg(
+                region->name(), QS_NUMBER(region->allocationCount()), QS_NUMBER(entryCount),
+                QS_NUMBER(region->allocatedBytes()), QS_NUMBER(region->maximumAllocationCount()));
+        QJsonObject regionObject{};
+        regionObject.insert("name", QString{region->name()});
+        regionObject.insert("calls", static_cast<double>(entryCount));
+        regionObject.insert("allocations", static_cast<double>(region->allocationCount()));
+        regionObject.insert("bytes", static_cast<double>(region->allocatedBytes()));
+        regionObject.insert("maximumAllocationsPerCall", static_cast<double>(region->maximumAllocationCount()));
+        regionObject.insert("allocationsPerCall", static_cast<double>(region->allocationCount()) / entryCount);
+        regions.append(regionObject);
+    }
+    LOG_INFO() << QString{"Allocations in total: %1 (%2 bytes), %3 freed, counted through %4"}.arg(
+            QS_NUMBER(QmsAllocationTracker::totalAllocationCount()), QS_NUMBER(QmsAllocationTracker::totalAllocatedBytes()),
+            QS_NUMBER(QmsAllocationTracker::totalDeallocationCount()), QmsAllocationTracker::countedAllocator());
+    QJsonObject totals{};
+    totals.insert("allocations", static_cast<double>(QmsAllocationTracker::totalAllocationCount()));
+    totals.insert("bytes", static_cast<double>(QmsAllocationTracker::totalAllocatedBytes()));
+    totals.insert("deallocations", static_cast<double>(QmsAllocationTracker::totalDeallocationCount()));
+    QJsonObject root{};
+    root.insert("counted", QString{QmsAllocationTracker::countedAllocator()});
+    root.insert("regions", regions);
+    root.insert("total", totals);
+
+    QFile jsonFile{jsonFilePath};
+    if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOG_WARNING() << QString{"Failed to open allocation report file %1"}.arg(jsonFilePath);
+        return;
+    }
+    jsonFile.write(QJsonDocument{root}.toJson());
+    LOG_INFO() << QString{"Wrote allocation report to %1"}.arg(jsonFilePath);
+}
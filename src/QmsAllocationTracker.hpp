@@ -0,0 +1,81 @@
+#ifndef QMINESWEEPER_QMSALLOCATIONTRACKER_HPP
+#define QMINESWEEPER_QMSALLOCATIONTRACKER_HPP
+
+#include "QmsRegistry.hpp"
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+
+/* QmsAllocationRegion : A named part of the code whose heap allocations are counted, such as a
+ * click handler. Each QMS_INSTRUMENT_SCOPE() has one, and QMS_ALLOCATION_SCOPE() creates one on
+ * its own for work too small to be worth more than counting its allocations (such as revealing
+ * one cell). They are registered (see QmsRegistered) so they can all be reported at exit */
+class QmsAllocationRegion : public QmsRegistered<QmsAllocationRegion> {
+public:
+    explicit QmsAllocationRegion(const char *name);
+    QmsAllocationRegion(const QmsAllocationRegion &rhs) = delete;
+    QmsAllocationRegion &operator=(const QmsAllocationRegion &rhs) = delete;
+
+    void addEntry(uint64_t allocationCount, uint64_t allocatedBytes);
+
+    const char *name() const;
+    uint64_t entryCount() const;
+    uint64_t allocationCount() const;
+    uint64_t allocatedBytes() const;
+    uint64_t maximumAllocationCount() const;
+
+private:
+    const char *m_name;
+    std::atomic<uint64_t> m_entryCount;
+    std::atomic<uint64_t> m_allocationCount;
+    std::atomic<uint64_t> m_allocatedBytes;
+    std::atomic<uint64_t> m_maximumAllocationCount;
+};
+
+/* QmsAllocationScope : Adds the allocations made by the current thread between its construction
+ * and destruction to a region. Scopes nest, and each one counts everything made inside it, so
+ * the allocations of a region called from another one are counted in both */
+class QmsAllocationScope {
+public:
+    explicit QmsAllocationScope(QmsAllocationRegion &region);
+    ~QmsAllocationScope();
+    QmsAllocationScope(const QmsAllocationScope &rhs) = delete;
+    QmsAllocationScope &operator=(const QmsAllocationScope &rhs) = delete;
+
+private:
+    QmsAllocationRegion &m_region;
+    uint64_t m_startAllocationCount;
+    uint64_t m_startAllocatedBytes;
+};
+
+/* QmsAllocationTracker : With QMS_ALLOCATION_TRACKING defined (the QMS_ALLOCATION_TRACKING CMake
+ * option), every allocation is counted, per thread and for the whole process. With glibc, malloc()
+ * and its relatives are replaced, so everything is seen, including the buffers Qt allocates for
+ * QString and QByteArray. Elsewhere only the global operator new and delete are replaced, and
+ * memory Qt gets from malloc() is not counted; countedAllocator() says which, and so does the
+ * report. Without the option nothing is replaced, no region is ever entered and report() does
+ * nothing */
+class QmsAllocationTracker {
+public:
+    static bool isEnabled();
+    static const char *countedAllocator();
+    static uint64_t threadAllocationCount();
+    static uint64_t threadAllocatedBytes();
+    static uint64_t totalAllocationCount();
+    static uint64_t totalAllocatedBytes();
+    static uint64_t totalDeallocationCount();
+
+    static void report(const QString &jsonFilePath);
+};
+
+#if defined(QMS_ALLOCATION_TRACKING)
+#    define QMS_ALLOCATION_SCOPE(regionName) \
+        static QmsAllocationRegion qmsAllocationRegion{regionName}; \
+        QmsAllocationScope qmsAllocationScope{qmsAllocationRegion}
+#else
+#    define QMS_ALLOCATION_SCOPE(regionName)
+#endif
+
+#endif //QMINESWEEPER_QMSALLOCATIONTRACKER_HPP
@@ -0,0 +1,117 @@
+#include "QmsApplication.hpp"
+#include "QmsTraceRecorder.hpp"
+#include "GlobalDefinitions.hpp"
+#include "QmsUtilities.hpp"
+#include "QmsApplicationSettings.hpp"
+
+#include <QEvent>
+#include <QMetaEnum>
+#include <QSocketNotifier>
+
+#include <chrono>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+thread_local int QmsApplication::s_notifyDepth{0};
+int QmsApplication::s_signalSockets[2]{-1, -1};
+
+/* QmsApplication() : The write end of the signal socket does not block, so a burst
+ * of signals fills it up and the rest are dropped, rather than hanging the handler */
+QmsApplication::QmsApplication(int &argc, char **argv) :
+        QApplication{argc, argv},
+        m_signalNotifier{nullptr} {
+#if !defined(_WIN32)
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, QmsApplication::s_signalSockets) == 0) {
+        fcntl(QmsApplication::s_signalSockets[0], F_SETFL, fcntl(QmsApplication::s_signalSockets[0], F_GETFL) | O_NONBLOCK);
+        this->m_signalNotifier.reset(new QSocketNotifier{QmsApplication::s_signalSockets[1], QSocketNotifier::Read});
+        connect(this->m_signalNotifier.get(), &QSocketNotifier::activated, this, &QmsApplication::onSignalPosted);
+    } else {
+        LOG_WARNING() << QString{"Could not create the signal socket, SIGUSR1 will be ignored, and SIGINT and SIGTERM will end the program without saving"};
+    }
+#endif
+}
+
+/* ~QmsApplication() : The sockets are left open, as a signal handler may still write to them */
+QmsApplication::~QmsApplication() {
+    this->m_signalNotifier.reset();
+}
+
+bool QmsApplication::notify(QObject *receiver, QEvent *event) {
+    if ((!QmsTraceRecorder::isEnabled()) || (QmsApplication::s_notifyDepth != 0)) {
+        return QApplication::notify(receiver, event);
+    }
+    const QEvent::Type eventType{event->type()};
+    const auto startTime = std::chrono::steady_clock::now();
+    QmsApplication::s_notifyDepth++;
+    bool accepted{false};
+    try {
+        accepted = QApplication::notify(receiver, event);
+    } catch (...) {
+        QmsApplication::s_notifyDepth--;
+        throw;
+    }
+    QmsApplication::s_notifyDepth--;
+    QmsTraceRecorder::recordSpan(QmsApplication::eventTypeName(eventType), "event", startTime, std::chrono::steady_clock::now());
+    return accepted;
+}
+
+/* postSignal() : Called from a signal handler, so it only uses write(). Returns false when there
+ * is no event loop to hand the signal to yet. Windows runs handlers on a thread of their own
+ * instead of interrupting one, so there the signal can simply be queued to the GUI thread */
+bool QmsApplication::postSignal(int signalNumber) {
+#if defined(_WIN32)
+    QCoreApplication *application{QCoreApplication::instance()};
+    if (application == nullptr) {
+        return false;
+    }
+    return QMetaObject::invokeMethod(application, "onSignalReceived", Qt::QueuedConnection, Q_ARG(int, signalNumber));
+#else
+    const int signalSocket{QmsApplication::s_signalSockets[0]};
+    if (signalSocket == -1) {
+        return false;
+    }
+    const auto signalByte = static_cast<unsigned char>(signalNumber);
+    ssize_t written{write(signalSocket, &signalByte, 1)};
+    (void)written;
+    return true;
+#endif
+}
+
+void QmsApplication::onSignalPosted() {
+#if !defined(_WIN32)
+    unsigned char signalBytes[16];
+    const ssize_t received{read(QmsApplication::s_signalSockets[1], signalBytes, sizeof(signalBytes))};
+    for (ssize_t index = 0; index < received; index++) {
+        this->onSignalReceived(signalBytes[index]);
+    }
+#endif
+}
+
+/* onSignalReceived() : Handles, on the GUI thread, the signals postSignal() was given. Any
+ * signal but SIGUSR1 quits the event loop, so the program shuts down the same way it does
+ * when the window is closed, and main() stops the threads and writes out what they recorded */
+void QmsApplication::onSignalReceived(int signalNumber) {
+#if !defined(_WIN32)
+    if (signalNumber == SIGUSR1) {
+        QmsTraceRecorder::writeInstance();
+        return;
+    }
+#endif
+    LOG_INFO() << QString{"Caught signal %1 (%2), exiting %3"}.arg(QS_NUMBER(signalNumber),
+                                                                  QString::fromStdString(QmsUtilities::getSignalName(signalNumber)),
+                                                                  QmsGlobalSettings::PROGRAM_NAME);
+    this->quit();
+}
+
+/* eventTypeName() : The key comes from the meta object of QEvent, so it lives as long as the
+ * program does and can be kept in the trace as is. Custom event types have no name of their own */
+const char *QmsApplication::eventTypeName(QEvent::Type eventType) {
+    static const QMetaEnum eventTypes{QMetaEnum::fromType<QEvent::Type>()};
+    const char *name{eventTypes.valueToKey(eventType)};
+    return (name ? name : "QEvent");
+}
@@ -0,0 +1,39 @@
+#ifndef QMINESWEEPER_QMSAPPLICATION_HPP
+#define QMINESWEEPER_QMSAPPLICATION_HPP
+
+#include <QApplication>
+
+#include <memory>
+
+class QSocketNotifier;
+
+/* QmsApplication : The QApplication, with every event the event loop dispatches recorded as a
+ * trace span named after the event's type while tracing is on. Events sent from inside the
+ * handling of another event are left out, since they are already part of its span. Signals that
+ * need more than an async signal safe call are handed to the event loop through postSignal() */
+class QmsApplication : public QApplication {
+Q_OBJECT
+public:
+    QmsApplication(int &argc, char **argv);
+    ~QmsApplication() override;
+    QmsApplication(const QmsApplication &rhs) = delete;
+    QmsApplication &operator=(const QmsApplication &rhs) = delete;
+
+    bool notify(QObject *receiver, QEvent *event) override;
+
+    static bool postSignal(int signalNumber);
+
+private slots:
+    void onSignalPosted();
+    void onSignalReceived(int signalNumber);
+
+private:
+    std::unique_ptr<QSocketNotifier> m_signalNotifier;
+
+    static const char *eventTypeName(QEvent::Type eventType);
+
+    static thread_local int s_notifyDepth;
+    static int s_signalSockets[2];
+};
+
+#endif //QMINESWEEPER_QMSAPPLICATION_HPP
@@ -47,6 +47,14 @@ void QmsApplicationSettings::setAudioVolume(int audioVolume) {
     this->m_audioVolume = audioVolume;
 }
 
+void QmsApplicationSettings::setIconPalette(IconPalette iconPalette) {
+    this->m_iconPalette = iconPalette;
+}
+
+void QmsApplicationSettings::setRippleReveal(bool rippleReveal) {
+    this->m_rippleReveal = rippleReveal;
+}
+
 int QmsApplicationSettings::numberOfColumns() const {
     return this->m_numberOfColumns;
 }
@@ -57,4 +65,12 @@ int QmsApplicationSettings::numberOfRows() const {
 
 int QmsApplicationSettings::audioVolume() const {
     return this->m_audioVolume;
-}
\ No newline at end of file
+}
+
+IconPalette QmsApplicationSettings::iconPalette() const {
+    return this->m_iconPalette;
+}
+
+bool QmsApplicationSettings::rippleReveal() const {
+    return this->m_rippleReveal;
+}
\ No newline at end of file
@@ -29,20 +29,28 @@ namespace QmsGlobalSettings {
 #endif
 }
 
+enum class IconPalette : int;
+
 class QmsApplicationSettings {
 public:
     int numberOfColumns() const;
     int numberOfRows() const;
     int audioVolume() const;
+    IconPalette iconPalette() const;
+    bool rippleReveal() const;
 
     void setNumberOfColumns(int columns);
     void setNumberOfRows(int rows);
     void setAudioVolume(int volume);
+    void setIconPalette(IconPalette iconPalette);
+    void setRippleReveal(bool rippleReveal);
 
 private:
     int m_numberOfColumns;
     int m_numberOfRows;
     int m_audioVolume;
+    IconPalette m_iconPalette;
+    bool m_rippleReveal;
 };
 
 #endif // QMINESWEEPER_QMSAPPLICATIONSETTINGS_HPP
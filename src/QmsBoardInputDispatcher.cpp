@@ -0,0 +1,141 @@
+#include "QmsBoardInputDispatcher.hpp"
+#include "QmsButton.hpp"
+#include "GameController.hpp"
+#include "QmsInstrumentation.hpp"
+
+#include <QWidget>
+#include <QGridLayout>
+#include <QMouseEvent>
+
+#include <cmath>
+
+QmsBoardInputDispatcher::QmsBoardInputDispatcher(QWidget *mineFrame, QGridLayout *mineFrameLayout) :
+        QObject{mineFrame},
+        m_mineFrame{mineFrame},
+        m_mineFrameLayout{mineFrameLayout},
+        m_longPressTimer{},
+        m_pressTimer{},
+        m_pressedButton{nullptr},
+        m_pressedMouseButton{Qt::MouseButton::NoButton},
+        m_isLongPress{false} {
+    this->m_longPressTimer.setSingleShot(true);
+    this->m_longPressTimer.setInterval(GameController::LONG_CLICK_THRESHOLD());
+    connect(&this->m_longPressTimer, &QTimer::timeout, this, &QmsBoardInputDispatcher::onLongPressTimeout);
+    mineFrame->installEventFilter(this);
+}
+
+/* buttonAt() : Every cell of the grid has the same size, so the cell under position is found
+ * from the first cell's origin and the distance between neighboring cells (including the
+ * layout's spacing). The button's own geometry is checked last, so a click on the spacing
+ * between two buttons does not count as a click on either of them */
+QmsButton *QmsBoardInputDispatcher::buttonAt(const QPoint &position) const {
+    const int numberOfColumns{gameController->numberOfColumns()};
+    const int numberOfRows{gameController->numberOfRows()};
+    if ((numberOfColumns <= 0) || (numberOfRows <= 0)) {
+        return nullptr;
+    }
+    const QRect firstCell{this->m_mineFrameLayout->cellRect(0, 0)};
+    if (!firstCell.isValid()) {
+        return nullptr;
+    }
+    const int columnPitch{numberOfColumns > 1 ? this->m_mineFrameLayout->cellRect(0, 1).x() - firstCell.x() : firstCell.width()};
+    const int rowPitch{numberOfRows > 1 ? this->m_mineFrameLayout->cellRect(1, 0).y() - firstCell.y() : firstCell.height()};
+    if ((columnPitch <= 0) || (rowPitch <= 0)) {
+        return nullptr;
+    }
+    const auto columnIndex = static_cast<int>(std::floor(static_cast<double>(position.x() - firstCell.x()) / columnPitch));
+    const auto rowIndex = static_cast<int>(std::floor(static_cast<double>(position.y() - firstCell.y()) / rowPitch));
+    if ((columnIndex < 0) || (columnIndex >= numberOfColumns) || (rowIndex < 0) || (rowIndex >= numberOfRows)) {
+        return nullptr;
+    }
+    auto button = gameController->mineSweeperButtonAtIndex(columnIndex, rowIndex);
+    if ((!button) || (!button->isVisible()) || (!button->geometry().contains(position))) {
+        return nullptr;
+    }
+    return button.get();
+}
+
+/* eventFilter() : Presses that land outside of every button are left alone, so the
+ * window can still be dragged from the mine field's border and spacing */
+bool QmsBoardInputDispatcher::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == this->m_mineFrame) {
+        if ((event->type() == QEvent::MouseButtonPress) || (event->type() == QEvent::MouseButtonDblClick)) {
+            return this->handleMousePress(static_cast<QMouseEvent *>(event));
+        } else if (event->type() == QEvent::MouseButtonRelease) {
+            return this->handleMouseRelease(static_cast<QMouseEvent *>(event));
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+bool QmsBoardInputDispatcher::handleMousePress(QMouseEvent *mouseEvent) {
+    if ((mouseEvent->button() != Qt::MouseButton::LeftButton) && (mouseEvent->button() != Qt::MouseButton::RightButton)) {
+        return false;
+    }
+    QmsButton *button{this->buttonAt(mouseEvent->pos())};
+    if (!button) {
+        return false;
+    }
+    if (gameController->isBoardInputBlocked()) {
+        return true;
+    }
+    this->clearPressedButton();
+    if (button->isChecked()) {
+        button->setIsRevealed(true);
+    }
+    if (!button->isRevealed()) {
+        gameController->onBoardInput(mouseEvent->button() == Qt::MouseButton::LeftButton ? BoardInputKind::LeftPressed :
+                                     BoardInputKind::RightPressed, button);
+        button->setDown(true);
+    }
+    this->m_pressedButton = button;
+    this->m_pressedMouseButton = mouseEvent->button();
+    this->m_isLongPress = false;
+    this->m_pressTimer.start();
+    this->m_longPressTimer.start();
+    return true;
+}
+
+/* handleMouseRelease() : Like a QPushButton, a release only counts when it happens over
+ * the same button that was pressed, so dragging off a cell cancels the click */
+bool QmsBoardInputDispatcher::handleMouseRelease(QMouseEvent *mouseEvent) {
+    if ((!this->m_pressedButton) || (mouseEvent->button() != this->m_pressedMouseButton)) {
+        return this->m_pressedButton != nullptr;
+    }
+    QMS_INSTRUMENT_SCOPE("Mouse release");
+    QmsInputLatency::markInput();
+    QmsButton *button{this->m_pressedButton};
+    const bool isLongPress{this->m_isLongPress || (this->m_pressTimer.elapsed() >= GameController::LONG_CLICK_THRESHOLD())};
+    this->clearPressedButton();
+    if (gameController->isBoardInputBlocked() || (this->buttonAt(mouseEvent->pos()) != button)) {
+        return true;
+    }
+    if (button->isChecked()) {
+        button->setIsRevealed(true);
+    }
+    if (!button->isRevealed()) {
+        if (mouseEvent->button() == Qt::MouseButton::LeftButton) {
+            gameController->onBoardInput(isLongPress ? BoardInputKind::LongLeftReleased : BoardInputKind::LeftReleased, button);
+        } else {
+            gameController->onBoardInput(isLongPress ? BoardInputKind::LongRightReleased : BoardInputKind::RightReleased, button);
+        }
+    }
+    return true;
+}
+
+void QmsBoardInputDispatcher::onLongPressTimeout() {
+    if ((this->m_pressedButton) && (!this->m_pressedButton->isRevealed())) {
+        this->m_isLongPress = true;
+        this->m_pressedButton->setIsBeingLongClicked(true);
+    }
+}
+
+void QmsBoardInputDispatcher::clearPressedButton() {
+    this->m_longPressTimer.stop();
+    if (this->m_pressedButton) {
+        this->m_pressedButton->setDown(false);
+        this->m_pressedButton->setIsBeingLongClicked(false);
+        this->m_pressedButton = nullptr;
+    }
+    this->m_pressedMouseButton = Qt::MouseButton::NoButton;
+}
@@ -0,0 +1,49 @@
+#ifndef QMINESWEEPER_QMSBOARDINPUTDISPATCHER_HPP
+#define QMINESWEEPER_QMSBOARDINPUTDISPATCHER_HPP
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPoint>
+
+class QWidget;
+class QGridLayout;
+class QMouseEvent;
+class QmsButton;
+
+/* QmsBoardInputDispatcher : Handles every mouse press and release on the mine field from a
+ * single event filter on the frame holding the QmsButtons (which are transparent for mouse
+ * events). The cell under the cursor is found arithmetically from the grid layout's pitch,
+ * and the input is handed straight to GameController::onBoardInput(). This replaces six
+ * signal connections and a long click timer per button with one of each for the whole board */
+class QmsBoardInputDispatcher : public QObject {
+Q_OBJECT
+public:
+    QmsBoardInputDispatcher(QWidget *mineFrame, QGridLayout *mineFrameLayout);
+    ~QmsBoardInputDispatcher() override = default;
+    QmsBoardInputDispatcher(const QmsBoardInputDispatcher &rhs) = delete;
+    QmsBoardInputDispatcher &operator=(const QmsBoardInputDispatcher &rhs) = delete;
+
+    QmsButton *buttonAt(const QPoint &position) const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onLongPressTimeout();
+
+private:
+    QWidget *m_mineFrame;
+    QGridLayout *m_mineFrameLayout;
+    QTimer m_longPressTimer;
+    QElapsedTimer m_pressTimer;
+    QmsButton *m_pressedButton;
+    Qt::MouseButton m_pressedMouseButton;
+    bool m_isLongPress;
+
+    bool handleMousePress(QMouseEvent *mouseEvent);
+    bool handleMouseRelease(QMouseEvent *mouseEvent);
+    void clearPressedButton();
+};
+
+#endif //QMINESWEEPER_QMSBOARDINPUTDISPATCHER_HPP
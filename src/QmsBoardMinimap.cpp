@@ -0,0 +1,88 @@
+#include "QmsBoardMinimap.hpp"
+#include "QmsBoardView.hpp"
+#include "GameController.hpp"
+#include "QmsInstrumentation.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+
+#include <algorithm>
+
+const int QmsBoardMinimap::s_MAXIMUM_SIDE_LENGTH{160};
+
+QmsBoardMinimap::QmsBoardMinimap(QmsBoardView *boardView, QWidget *parent) :
+        QWidget{parent},
+        m_boardView{boardView} {
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+    this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    connect(gameController, &GameController::boardSummaryChanged, this,
+            static_cast<void (QWidget::*)()>(&QWidget::update));
+    connect(boardView, &QmsBoardView::visibleCellsChanged, this,
+            static_cast<void (QWidget::*)()>(&QWidget::update));
+}
+
+/* sizeHint() : The board's aspect ratio, with the longest side MAXIMUM_SIDE_LENGTH() pixels long */
+QSize QmsBoardMinimap::sizeHint() const {
+    const int numberOfColumns{std::max(1, gameController->numberOfColumns())};
+    const int numberOfRows{std::max(1, gameController->numberOfRows())};
+    const int longestSide{std::max(numberOfColumns, numberOfRows)};
+    return QSize{std::max(1, (QmsBoardMinimap::s_MAXIMUM_SIDE_LENGTH * numberOfColumns) / longestSide),
+                 std::max(1, (QmsBoardMinimap::s_MAXIMUM_SIDE_LENGTH * numberOfRows) / longestSide)};
+}
+
+void QmsBoardMinimap::paintEvent(QPaintEvent *paintEvent) {
+    QMS_INSTRUMENT_SCOPE("Minimap paint");
+    QPainter painter{this};
+    painter.fillRect(paintEvent->rect(), this->palette().window());
+    const QRectF board{this->boardRect()};
+    gameController->boardSummary().drawTiles(&painter, board, paintEvent->rect());
+    const QRectF visibleCells{this->m_boardView->visibleCells()};
+    const qreal horizontalScale{board.width() / std::max(1, gameController->numberOfColumns())};
+    const qreal verticalScale{board.height() / std::max(1, gameController->numberOfRows())};
+    painter.setPen(QPen{this->palette().highlight().color(), 2});
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(QRectF{board.x() + (visibleCells.x() * horizontalScale), board.y() + (visibleCells.y() * verticalScale),
+                            visibleCells.width() * horizontalScale, visibleCells.height() * verticalScale});
+}
+
+void QmsBoardMinimap::mousePressEvent(QMouseEvent *mouseEvent) {
+    if (mouseEvent->button() == Qt::MouseButton::LeftButton) {
+        this->centerBoardViewAt(mouseEvent->pos());
+        mouseEvent->accept();
+    } else {
+        QWidget::mousePressEvent(mouseEvent);
+    }
+}
+
+void QmsBoardMinimap::mouseMoveEvent(QMouseEvent *mouseEvent) {
+    if (mouseEvent->buttons() & Qt::MouseButton::LeftButton) {
+        this->centerBoardViewAt(mouseEvent->pos());
+        mouseEvent->accept();
+    } else {
+        QWidget::mouseMoveEvent(mouseEvent);
+    }
+}
+
+/* boardRect() : The board keeps its aspect ratio, centered in whatever size the dock gives us */
+QRectF QmsBoardMinimap::boardRect() const {
+    const int numberOfColumns{std::max(1, gameController->numberOfColumns())};
+    const int numberOfRows{std::max(1, gameController->numberOfRows())};
+    const qreal scale{std::min(static_cast<qreal>(this->width()) / numberOfColumns,
+                               static_cast<qreal>(this->height()) / numberOfRows)};
+    const QSizeF boardSize{numberOfColumns * scale, numberOfRows * scale};
+    return QRectF{QPointF{(this->width() - boardSize.width()) / 2, (this->height() - boardSize.height()) / 2}, boardSize};
+}
+
+void QmsBoardMinimap::centerBoardViewAt(const QPoint &position) {
+    const QRectF board{this->boardRect()};
+    if (board.isEmpty()) {
+        return;
+    }
+    this->m_boardView->centerOnCell(QPointF{(position.x() - board.x()) * gameController->numberOfColumns() / board.width(),
+                                            (position.y() - board.y()) * gameController->numberOfRows() / board.height()});
+}
+
+int QmsBoardMinimap::MAXIMUM_SIDE_LENGTH() {
+    return QmsBoardMinimap::s_MAXIMUM_SIDE_LENGTH;
+}
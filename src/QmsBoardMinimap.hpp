@@ -0,0 +1,37 @@
+#ifndef QMINESWEEPER_QMSBOARDMINIMAP_HPP
+#define QMINESWEEPER_QMSBOARDMINIMAP_HPP
+
+#include <QWidget>
+#include <QRectF>
+
+class QPaintEvent;
+class QMouseEvent;
+class QmsBoardView;
+
+/* QmsBoardMinimap : The whole board drawn from the summary tiles at a fixed size, with the
+ * part currently inside the board view outlined. Clicking or dragging on it moves the view */
+class QmsBoardMinimap : public QWidget {
+Q_OBJECT
+public:
+    QmsBoardMinimap(QmsBoardView *boardView, QWidget *parent);
+    ~QmsBoardMinimap() override = default;
+
+    QSize sizeHint() const override;
+
+    static int MAXIMUM_SIDE_LENGTH();
+
+protected:
+    void paintEvent(QPaintEvent *paintEvent) override;
+    void mousePressEvent(QMouseEvent *mouseEvent) override;
+    void mouseMoveEvent(QMouseEvent *mouseEvent) override;
+
+private:
+    QmsBoardView *m_boardView;
+
+    QRectF boardRect() const;
+    void centerBoardViewAt(const QPoint &position);
+
+    static const int s_MAXIMUM_SIDE_LENGTH;
+};
+
+#endif //QMINESWEEPER_QMSBOARDMINIMAP_HPP
@@ -0,0 +1,44 @@
+#include "QmsBoardOverview.hpp"
+#include "GameController.hpp"
+#include "QmsInstrumentation.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+
+QmsBoardOverview::QmsBoardOverview(QWidget *parent) :
+        QWidget{parent},
+        m_paused{false} {
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+    this->setAttribute(Qt::WA_NoSystemBackground);
+    connect(gameController, &GameController::boardSummaryChanged, this,
+            static_cast<void (QWidget::*)()>(&QWidget::update));
+    connect(gameController, &GameController::pausedChanged, this, &QmsBoardOverview::onPausedChanged);
+}
+
+void QmsBoardOverview::onPausedChanged(bool paused) {
+    this->m_paused = paused;
+    this->update();
+}
+
+void QmsBoardOverview::paintEvent(QPaintEvent *paintEvent) {
+    QMS_INSTRUMENT_SCOPE("Board overview paint");
+    QPainter painter{this};
+    painter.fillRect(paintEvent->rect(), this->palette().window());
+    if (this->m_paused) {
+        return;
+    }
+    gameController->boardSummary().drawTiles(&painter, QRectF{this->rect()}, paintEvent->rect());
+}
+
+void QmsBoardOverview::mousePressEvent(QMouseEvent *mouseEvent) {
+    if ((mouseEvent->button() != Qt::MouseButton::LeftButton) || this->m_paused ||
+        (this->width() <= 0) || (this->height() <= 0)) {
+        QWidget::mousePressEvent(mouseEvent);
+        return;
+    }
+    const QmsBoardSummary &boardSummary = gameController->boardSummary();
+    emit(cellClicked(QPointF{static_cast<qreal>(mouseEvent->pos().x()) * boardSummary.numberOfColumns() / this->width(),
+                             static_cast<qreal>(mouseEvent->pos().y()) * boardSummary.numberOfRows() / this->height()}));
+    mouseEvent->accept();
+}
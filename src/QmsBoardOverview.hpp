@@ -0,0 +1,35 @@
+#ifndef QMINESWEEPER_QMSBOARDOVERVIEW_HPP
+#define QMINESWEEPER_QMSBOARDOVERVIEW_HPP
+
+#include <QWidget>
+#include <QPointF>
+
+class QPaintEvent;
+class QMouseEvent;
+
+/* QmsBoardOverview : Stands in for the mine field when the board is zoomed out too far for
+ * the QmsButtons to be read (or drawn in any reasonable time). It paints the board summary's
+ * tiles stretched over its whole size, so it costs the same however many cells the board has.
+ * A click reports the cell under the cursor, which the board view zooms back in on. Like the
+ * pause overlay over the buttons, nothing of the board is drawn while the game is paused */
+class QmsBoardOverview : public QWidget {
+Q_OBJECT
+public:
+    explicit QmsBoardOverview(QWidget *parent);
+    ~QmsBoardOverview() override = default;
+
+signals:
+    void cellClicked(const QPointF &cell);
+
+private slots:
+    void onPausedChanged(bool paused);
+
+protected:
+    void paintEvent(QPaintEvent *paintEvent) override;
+    void mousePressEvent(QMouseEvent *mouseEvent) override;
+
+private:
+    bool m_paused;
+};
+
+#endif //QMINESWEEPER_QMSBOARDOVERVIEW_HPP
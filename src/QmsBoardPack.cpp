@@ -0,0 +1,277 @@
+#include "QmsBoardPack.hpp"
+#include "QmsVarInt.hpp"
+
+#include <QFile>
+#include <QString>
+
+#include <algorithm>
+#include <cstring>
+
+const char *const QmsBoardPack::s_MAGIC_NUMBER{"QMSP"};
+const uint8_t QmsBoardPack::s_FORMAT_VERSION{1};
+const size_t QmsBoardPack::s_HEADER_SIZE{32};
+const size_t QmsBoardPack::s_INDEX_ENTRY_SIZE{16};
+const int QmsBoardPack::s_MAXIMUM_DIMENSION{4096};
+const uint8_t QmsBoardPack::s_BITMAP_ENCODING{0};
+const uint8_t QmsBoardPack::s_SPARSE_ENCODING{1};
+
+namespace {
+
+    uint64_t readLittleEndian(const uint8_t *data, size_t byteCount) {
+        uint64_t value{0};
+        for (size_t i = 0; i < byteCount; i++) {
+            value |= (static_cast<uint64_t>(data[i]) << (8 * i));
+        }
+        return value;
+    }
+
+    void writeLittleEndian(std::vector<uint8_t> &output, size_t position, uint64_t value, size_t byteCount) {
+        for (size_t i = 0; i < byteCount; i++) {
+            output[position + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /* Header : magic (4), version (1), index entry size (1), reserved (2), board count (4),
+     * reserved (4), index offset (8), data offset (8). Index entry : offset from the start
+     * of the data section (8), byte length (4), columns (2), rows (2) */
+    struct PackLayout {
+        uint32_t boardCount;
+        uint64_t indexOffset;
+        uint64_t dataOffset;
+    };
+
+    bool readLayout(const uint8_t *data, size_t size, PackLayout &layout) {
+        const size_t magicNumberLength{std::strlen(QmsBoardPack::MAGIC_NUMBER())};
+        if ((size < QmsBoardPack::HEADER_SIZE()) ||
+            (std::memcmp(data, QmsBoardPack::MAGIC_NUMBER(), magicNumberLength) != 0) ||
+            (data[4] != QmsBoardPack::FORMAT_VERSION()) || (data[5] != QmsBoardPack::INDEX_ENTRY_SIZE())) {
+            return false;
+        }
+        layout.boardCount = static_cast<uint32_t>(readLittleEndian(data + 8, 4));
+        layout.indexOffset = readLittleEndian(data + 16, 8);
+        layout.dataOffset = readLittleEndian(data + 24, 8);
+        const uint64_t indexSize{static_cast<uint64_t>(layout.boardCount) * QmsBoardPack::INDEX_ENTRY_SIZE()};
+        return ((layout.indexOffset >= QmsBoardPack::HEADER_SIZE()) && (layout.indexOffset <= size) &&
+                (indexSize <= size - layout.indexOffset) && (layout.dataOffset <= size));
+    }
+
+}
+
+QmsBoardPack::QmsBoardPack() :
+        m_file{nullptr},
+        m_data{nullptr},
+        m_size{0},
+        m_boardCount{0} {
+
+}
+
+QmsBoardPack::~QmsBoardPack() {
+    this->close();
+}
+
+/* open() : Maps the whole file and checks the header and the bounds of the index.
+ * The boards themselves are only looked at (and checked) as they are read */
+std::pair<OpenBoardPackResult, std::string> QmsBoardPack::open(const QString &filePath) {
+    this->close();
+    std::unique_ptr<QFile> packFile{new QFile{filePath}};
+    if (!packFile->exists()) {
+        return std::make_pair(OpenBoardPackResult::FileDoesNotExist, QString{"File \"%1\" does not exist"}.arg(filePath).toStdString());
+    }
+    if (!packFile->open(QIODevice::OpenModeFlag::ReadOnly)) {
+        return std::make_pair(OpenBoardPackResult::UnableToOpenFile, QString{"Could not open file \"%1\""}.arg(filePath).toStdString());
+    }
+    const auto fileSize = packFile->size();
+    const uchar *mappedData{(fileSize > 0) ? packFile->map(0, fileSize) : nullptr};
+    if (mappedData == nullptr) {
+        return std::make_pair(OpenBoardPackResult::UnableToMapFile, QString{"Could not map file \"%1\" into memory (%2)"}.arg(filePath, packFile->errorString()).toStdString());
+    }
+    uint32_t boardCount{0};
+    if (!QmsBoardPack::readHeader(mappedData, static_cast<size_t>(fileSize), boardCount)) {
+        packFile->unmap(const_cast<uchar *>(mappedData));
+        return std::make_pair(OpenBoardPackResult::InvalidFormat, QString{"File \"%1\" is not a valid board pack"}.arg(filePath).toStdString());
+    }
+    this->m_file = std::move(packFile);
+    this->m_data = mappedData;
+    this->m_size = static_cast<size_t>(fileSize);
+    this->m_boardCount = boardCount;
+    return std::make_pair(OpenBoardPackResult::Success, "");
+}
+
+void QmsBoardPack::close() {
+    if (this->m_file) {
+        this->m_file->unmap(const_cast<uchar *>(this->m_data));
+        this->m_file->close();
+        this->m_file.reset();
+    }
+    this->m_data = nullptr;
+    this->m_size = 0;
+    this->m_boardCount = 0;
+}
+
+bool QmsBoardPack::isOpen() const {
+    return (this->m_data != nullptr);
+}
+
+uint32_t QmsBoardPack::boardCount() const {
+    return this->m_boardCount;
+}
+
+bool QmsBoardPack::boardAt(uint32_t boardIndex, QmsPackedBoard &targetBoard) const {
+    return (this->isOpen() && QmsBoardPack::readBoard(this->m_data, this->m_size, boardIndex, targetBoard));
+}
+
+bool QmsBoardPack::readHeader(const uint8_t *data, size_t size, uint32_t &boardCount) {
+    PackLayout layout{};
+    if (!readLayout(data, size, layout)) {
+        return false;
+    }
+    boardCount = layout.boardCount;
+    return true;
+}
+
+/* readBoard() : O(1) in the number of boards. Everything read is bounds checked,
+ * so a corrupt pack yields false for the affected boards instead of bad memory reads */
+bool QmsBoardPack::readBoard(const uint8_t *data, size_t size, uint32_t boardIndex, QmsPackedBoard &targetBoard) {
+    PackLayout layout{};
+    if (!readLayout(data, size, layout) || (boardIndex >= layout.boardCount)) {
+        return false;
+    }
+    const uint8_t *indexEntry{data + layout.indexOffset + (static_cast<uint64_t>(boardIndex) * s_INDEX_ENTRY_SIZE)};
+    const uint64_t boardOffset{readLittleEndian(indexEntry, 8)};
+    const uint64_t boardLength{readLittleEndian(indexEntry + 8, 4)};
+    const auto columnCount = static_cast<int>(readLittleEndian(indexEntry + 12, 2));
+    const auto rowCount = static_cast<int>(readLittleEndian(indexEntry + 14, 2));
+    if ((boardOffset > size - layout.dataOffset) || (boardLength > size - layout.dataOffset - boardOffset) ||
+        (boardLength == 0) || (columnCount <= 0) || (rowCount <= 0) ||
+        (columnCount > s_MAXIMUM_DIMENSION) || (rowCount > s_MAXIMUM_DIMENSION)) {
+        return false;
+    }
+    const int cellCount{columnCount * rowCount};
+    const uint8_t *cursor{data + layout.dataOffset + boardOffset};
+    const uint8_t *end{cursor + boardLength};
+    const uint8_t encoding{*cursor++};
+
+    QmsPackedBoard decodedBoard{columnCount, rowCount, std::vector<int>{}};
+    if (encoding == s_BITMAP_ENCODING) {
+        if (static_cast<uint64_t>(end - cursor) != (static_cast<uint64_t>(cellCount) + 7) / 8) {
+            return false;
+        }
+        for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+            if (cursor[cellIndex / 8] & (1 << (cellIndex % 8))) {
+                decodedBoard.mineCells.push_back(cellIndex);
+            }
+        }
+    } else if (encoding == s_SPARSE_ENCODING) {
+        uint64_t mineCount{0};
+        if (!QmsVarInt::decode(cursor, end, mineCount) || (mineCount > static_cast<uint64_t>(end - cursor))) {
+            return false;
+        }
+        decodedBoard.mineCells.reserve(static_cast<size_t>(mineCount));
+        uint64_t nextMineCell{0};
+        for (uint64_t i = 0; i < mineCount; i++) {
+            uint64_t gap{0};
+            if (!QmsVarInt::decode(cursor, end, gap) || (gap >= static_cast<uint64_t>(cellCount) - nextMineCell)) {
+                return false;
+            }
+            nextMineCell += gap;
+            decodedBoard.mineCells.push_back(static_cast<int>(nextMineCell));
+            nextMineCell++;
+        }
+        if (cursor != end) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    //A board must leave at least one cell to click on
+    if (decodedBoard.mineCells.size() >= static_cast<size_t>(cellCount)) {
+        return false;
+    }
+    targetBoard = std::move(decodedBoard);
+    return true;
+}
+
+std::vector<uint8_t> QmsBoardPack::encode(const std::vector<QmsPackedBoard> &boards) {
+    const uint64_t indexOffset{s_HEADER_SIZE};
+    const uint64_t dataOffset{indexOffset + (boards.size() * s_INDEX_ENTRY_SIZE)};
+    std::vector<uint8_t> output(static_cast<size_t>(dataOffset), 0);
+    std::memcpy(output.data(), s_MAGIC_NUMBER, std::strlen(s_MAGIC_NUMBER));
+    output[4] = s_FORMAT_VERSION;
+    output[5] = static_cast<uint8_t>(s_INDEX_ENTRY_SIZE);
+    writeLittleEndian(output, 8, boards.size(), 4);
+    writeLittleEndian(output, 16, indexOffset, 8);
+    writeLittleEndian(output, 24, dataOffset, 8);
+
+    std::vector<uint8_t> sparseBoard{};
+    for (size_t boardIndex = 0; boardIndex < boards.size(); boardIndex++) {
+        const QmsPackedBoard &board = boards[boardIndex];
+        const int cellCount{board.numberOfColumns * board.numberOfRows};
+        std::vector<int> mineCells{board.mineCells};
+        std::sort(mineCells.begin(), mineCells.end());
+        mineCells.erase(std::unique(mineCells.begin(), mineCells.end()), mineCells.end());
+
+        sparseBoard.clear();
+        sparseBoard.push_back(s_SPARSE_ENCODING);
+        QmsVarInt::encode(sparseBoard, mineCells.size());
+        int previousMineCell{-1};
+        for (const auto &it : mineCells) {
+            QmsVarInt::encode(sparseBoard, static_cast<uint64_t>(it - previousMineCell - 1));
+            previousMineCell = it;
+        }
+
+        const size_t boardOffset{output.size() - static_cast<size_t>(dataOffset)};
+        const size_t bitmapLength{1 + (static_cast<size_t>(cellCount) + 7) / 8};
+        if (sparseBoard.size() < bitmapLength) {
+            output.insert(output.end(), sparseBoard.begin(), sparseBoard.end());
+        } else {
+            const size_t bitmapStart{output.size()};
+            output.resize(bitmapStart + bitmapLength, 0);
+            output[bitmapStart] = s_BITMAP_ENCODING;
+            for (const auto &it : mineCells) {
+                output[bitmapStart + 1 + static_cast<size_t>(it / 8)] |= static_cast<uint8_t>(1 << (it % 8));
+            }
+        }
+        const size_t entryOffset{static_cast<size_t>(indexOffset) + (boardIndex * s_INDEX_ENTRY_SIZE)};
+        writeLittleEndian(output, entryOffset, boardOffset, 8);
+        writeLittleEndian(output, entryOffset + 8, output.size() - static_cast<size_t>(dataOffset) - boardOffset, 4);
+        writeLittleEndian(output, entryOffset + 12, static_cast<uint64_t>(board.numberOfColumns), 2);
+        writeLittleEndian(output, entryOffset + 14, static_cast<uint64_t>(board.numberOfRows), 2);
+    }
+    return output;
+}
+
+std::pair<SaveBoardPackResult, std::string> QmsBoardPack::saveToFile(const QString &filePath,
+                                                                     const std::vector<QmsPackedBoard> &boards) {
+    QFile outputFile{filePath};
+    if (!outputFile.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Truncate)) {
+        return std::make_pair(SaveBoardPackResult::UnableToOpenFile, QString{"Could not open file \"%1\" (permission problem?)"}.arg(filePath).toStdString());
+    }
+    const std::vector<uint8_t> encodedPack{QmsBoardPack::encode(boards)};
+    const auto bytesWritten = outputFile.write(reinterpret_cast<const char *>(encodedPack.data()),
+                                               static_cast<qint64>(encodedPack.size()));
+    outputFile.close();
+    if (bytesWritten != static_cast<qint64>(encodedPack.size())) {
+        return std::make_pair(SaveBoardPackResult::UnableToWriteFile, QString{"Could not write to file \"%1\" (%2)"}.arg(filePath, outputFile.errorString()).toStdString());
+    }
+    return std::make_pair(SaveBoardPackResult::Success, "");
+}
+
+const char *QmsBoardPack::MAGIC_NUMBER() {
+    return QmsBoardPack::s_MAGIC_NUMBER;
+}
+
+uint8_t QmsBoardPack::FORMAT_VERSION() {
+    return QmsBoardPack::s_FORMAT_VERSION;
+}
+
+size_t QmsBoardPack::HEADER_SIZE() {
+    return QmsBoardPack::s_HEADER_SIZE;
+}
+
+size_t QmsBoardPack::INDEX_ENTRY_SIZE() {
+    return QmsBoardPack::s_INDEX_ENTRY_SIZE;
+}
+
+int QmsBoardPack::MAXIMUM_DIMENSION() {
+    return QmsBoardPack::s_MAXIMUM_DIMENSION;
+}
@@ -0,0 +1,83 @@
+#ifndef QMINESWEEPER_QMSBOARDPACK_HPP
+#define QMINESWEEPER_QMSBOARDPACK_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QString;
+class QFile;
+
+struct QmsPackedBoard {
+    int numberOfColumns;
+    int numberOfRows;
+    std::vector<int> mineCells;
+};
+
+enum class OpenBoardPackResult {
+    Success,
+    FileDoesNotExist,
+    UnableToOpenFile,
+    UnableToMapFile,
+    InvalidFormat
+};
+
+enum class SaveBoardPackResult {
+    Success,
+    UnableToOpenFile,
+    UnableToWriteFile
+};
+
+/* QmsBoardPack : Read-only, memory-mapped collection of boards (size and mine layout).
+ * The file is a fixed size header, then an index of fixed size entries (offset, length
+ * and dimensions of each board), then the boards themselves. Each board's mines are
+ * stored either as a raw bitmap or, for sparse boards, as varint gaps between mines,
+ * whichever is smaller, behind a one byte tag. Reading board K only touches the header,
+ * the K'th index entry and that board's bytes, so opening a pack of millions of boards
+ * costs no more than opening one. All integers are little endian. A board may put a mine on any
+ * cell: when it is played, a mine under the first click is moved to the first free cell (see
+ * GameController::generateRandomMinePlacement()), so the first click is always safe */
+class QmsBoardPack {
+public:
+    QmsBoardPack();
+    ~QmsBoardPack();
+    QmsBoardPack(const QmsBoardPack &rhs) = delete;
+    QmsBoardPack &operator=(const QmsBoardPack &rhs) = delete;
+
+    std::pair<OpenBoardPackResult, std::string> open(const QString &filePath);
+    void close();
+    bool isOpen() const;
+    uint32_t boardCount() const;
+    bool boardAt(uint32_t boardIndex, QmsPackedBoard &targetBoard) const;
+
+    static bool readHeader(const uint8_t *data, size_t size, uint32_t &boardCount);
+    static bool readBoard(const uint8_t *data, size_t size, uint32_t boardIndex, QmsPackedBoard &targetBoard);
+    static std::vector<uint8_t> encode(const std::vector<QmsPackedBoard> &boards);
+    static std::pair<SaveBoardPackResult, std::string> saveToFile(const QString &filePath,
+                                                                  const std::vector<QmsPackedBoard> &boards);
+
+    static const char *MAGIC_NUMBER();
+    static uint8_t FORMAT_VERSION();
+    static size_t HEADER_SIZE();
+    static size_t INDEX_ENTRY_SIZE();
+    static int MAXIMUM_DIMENSION();
+
+private:
+    std::unique_ptr<QFile> m_file;
+    const uint8_t *m_data;
+    size_t m_size;
+    uint32_t m_boardCount;
+
+    static const char *const s_MAGIC_NUMBER;
+    static const uint8_t s_FORMAT_VERSION;
+    static const size_t s_HEADER_SIZE;
+    static const size_t s_INDEX_ENTRY_SIZE;
+    static const int s_MAXIMUM_DIMENSION;
+    static const uint8_t s_BITMAP_ENCODING;
+    static const uint8_t s_SPARSE_ENCODING;
+};
+
+#endif //QMINESWEEPER_QMSBOARDPACK_HPP
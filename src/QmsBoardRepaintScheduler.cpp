@@ -0,0 +1,114 @@
+#include "QmsBoardRepaintScheduler.hpp"
+
+#include <QWidget>
+#include <QGridLayout>
+#include <QRegion>
+
+#include <algorithm>
+#include <tuple>
+
+const int QmsBoardRepaintScheduler::s_FRAME_INTERVAL{16};
+
+QmsBoardRepaintScheduler::QmsBoardRepaintScheduler(QWidget *mineFrame) :
+        QObject{mineFrame},
+        m_mineFrame{mineFrame},
+        m_frameTimer{},
+        m_sinceLastFlush{},
+        m_dirtyRects{},
+        m_batchDepth{0} {
+    this->m_frameTimer.setSingleShot(true);
+    this->m_sinceLastFlush.start();
+    connect(&this->m_frameTimer, &QTimer::timeout, this, &QmsBoardRepaintScheduler::flush);
+}
+
+/* markDirty() : The first change after a quiet period is repainted on the next pass of
+ * the event loop, later ones wait until a frame has passed since the last repaint */
+void QmsBoardRepaintScheduler::markDirty(const QWidget *cell) {
+    if (!cell->isVisible()) {
+        return;
+    }
+    this->m_dirtyRects.push_back(cell->geometry());
+    if ((this->m_batchDepth > 0) || this->m_frameTimer.isActive()) {
+        return;
+    }
+    const auto sinceLastFlush = static_cast<int>(this->m_sinceLastFlush.elapsed());
+    this->m_frameTimer.start(std::max(0, QmsBoardRepaintScheduler::s_FRAME_INTERVAL - sinceLastFlush));
+}
+
+/* beginBatch() : Batches nest, only the outermost one stops the mine field from repainting */
+void QmsBoardRepaintScheduler::beginBatch() {
+    if (this->m_batchDepth++ == 0) {
+        this->m_frameTimer.stop();
+        this->m_mineFrame->setUpdatesEnabled(false);
+    }
+}
+
+/* endBatch() : Enabling updates again repaints the whole mine field once, which
+ * covers every cell marked during the batch, so those are simply dropped */
+void QmsBoardRepaintScheduler::endBatch() {
+    if ((this->m_batchDepth == 0) || (--this->m_batchDepth > 0)) {
+        return;
+    }
+    this->m_dirtyRects.clear();
+    this->m_mineFrame->setUpdatesEnabled(true);
+    this->m_sinceLastFlush.restart();
+}
+
+bool QmsBoardRepaintScheduler::isBatching() const {
+    return this->m_batchDepth > 0;
+}
+
+void QmsBoardRepaintScheduler::flush() {
+    if (this->m_dirtyRects.empty()) {
+        return;
+    }
+    int horizontalSpacing{0};
+    int verticalSpacing{0};
+    if (auto gridLayout = qobject_cast<QGridLayout *>(this->m_mineFrame->layout())) {
+        horizontalSpacing = std::max(0, gridLayout->horizontalSpacing());
+        verticalSpacing = std::max(0, gridLayout->verticalSpacing());
+    }
+    QRegion dirtyRegion{};
+    for (const auto &it : QmsBoardRepaintScheduler::coalesce(std::move(this->m_dirtyRects), horizontalSpacing, verticalSpacing)) {
+        dirtyRegion += it;
+    }
+    this->m_dirtyRects.clear();
+    this->m_mineFrame->update(dirtyRegion);
+    this->m_sinceLastFlush.restart();
+}
+
+/* coalesce() : Cells in the same row that are at most the layout's spacing apart are merged
+ * into one run, then runs covering the same columns in rows at most the spacing apart are
+ * merged into one block. A cell marked more than once is only counted once */
+std::vector<QRect> QmsBoardRepaintScheduler::coalesce(std::vector<QRect> rects, int horizontalSpacing, int verticalSpacing) {
+    std::sort(rects.begin(), rects.end(), [](const QRect &lhs, const QRect &rhs) {
+        return std::make_tuple(lhs.top(), lhs.left(), lhs.bottom(), lhs.right()) <
+               std::make_tuple(rhs.top(), rhs.left(), rhs.bottom(), rhs.right());
+    });
+    std::vector<QRect> runs{};
+    for (const auto &it : rects) {
+        if ((!runs.empty()) && (runs.back().top() == it.top()) && (runs.back().bottom() == it.bottom()) &&
+            (it.left() - runs.back().right() - 1 <= horizontalSpacing)) {
+            runs.back().setRight(std::max(runs.back().right(), it.right()));
+        } else {
+            runs.push_back(it);
+        }
+    }
+    std::sort(runs.begin(), runs.end(), [](const QRect &lhs, const QRect &rhs) {
+        return std::make_tuple(lhs.left(), lhs.right(), lhs.top()) < std::make_tuple(rhs.left(), rhs.right(), rhs.top());
+    });
+    std::vector<QRect> blocks{};
+    for (const auto &it : runs) {
+        if ((!blocks.empty()) && (blocks.back().left() == it.left()) && (blocks.back().right() == it.right()) &&
+            (it.top() - blocks.back().bottom() - 1 <= verticalSpacing)) {
+            blocks.back().setBottom(std::max(blocks.back().bottom(), it.bottom()));
+        } else {
+            blocks.push_back(it);
+        }
+    }
+    return blocks;
+}
+
+int QmsBoardRepaintScheduler::FRAME_INTERVAL() {
+    return QmsBoardRepaintScheduler::s_FRAME_INTERVAL;
+}
@@ -0,0 +1,48 @@
+#ifndef QMINESWEEPER_QMSBOARDREPAINTSCHEDULER_HPP
+#define QMINESWEEPER_QMSBOARDREPAINTSCHEDULER_HPP
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRect>
+
+#include <vector>
+
+class QWidget;
+
+/* QmsBoardRepaintScheduler : Collects the cells of the mine field whose appearance changed
+ * (glyph, uncovered mine, long click highlight) and repaints their union at most once per
+ * frame, as a handful of rectangles: neighboring cells in a row are merged into runs, and
+ * identical runs in neighboring rows into blocks. Changes that touch the whole board (the
+ * end of a game, a reset) are made inside a batch, during which the mine field does not
+ * repaint at all, and which ends with a single repaint of the mine field */
+class QmsBoardRepaintScheduler : public QObject {
+Q_OBJECT
+public:
+    explicit QmsBoardRepaintScheduler(QWidget *mineFrame);
+    ~QmsBoardRepaintScheduler() override = default;
+    QmsBoardRepaintScheduler(const QmsBoardRepaintScheduler &rhs) = delete;
+    QmsBoardRepaintScheduler &operator=(const QmsBoardRepaintScheduler &rhs) = delete;
+
+    void markDirty(const QWidget *cell);
+    void beginBatch();
+    void endBatch();
+    bool isBatching() const;
+
+    static std::vector<QRect> coalesce(std::vector<QRect> rects, int horizontalSpacing, int verticalSpacing);
+    static int FRAME_INTERVAL();
+
+private slots:
+    void flush();
+
+private:
+    QWidget *m_mineFrame;
+    QTimer m_frameTimer;
+    QElapsedTimer m_sinceLastFlush;
+    std::vector<QRect> m_dirtyRects;
+    int m_batchDepth;
+
+    static const int s_FRAME_INTERVAL;
+};
+
+#endif //QMINESWEEPER_QMSBOARDREPAINTSCHEDULER_HPP
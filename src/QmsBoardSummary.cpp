@@ -0,0 +1,169 @@
+#include "QmsBoardSummary.hpp"
+#include "QmsCellGrid.hpp"
+
+#include <QPainter>
+#include <QRectF>
+
+#include <algorithm>
+
+const int QmsBoardSummary::s_MAXIMUM_TILES_PER_SIDE{128};
+const QColor QmsBoardSummary::s_REVEALED_COLOR{224, 224, 224};
+const QColor QmsBoardSummary::s_FLAGGED_COLOR{220, 40, 40};
+const QColor QmsBoardSummary::s_UNKNOWN_COLOR{120, 120, 120};
+
+QmsBoardSummary::QmsBoardSummary() :
+        m_numberOfColumns{0},
+        m_numberOfRows{0},
+        m_tileSize{1},
+        m_numberOfTileColumns{0},
+        m_numberOfTileRows{0},
+        m_revealedCounts{},
+        m_flaggedCounts{},
+        m_image{},
+        m_imageIsValid{false} {
+
+}
+
+/* reset() : Every cell of a new board is covered, so every count starts at zero */
+void QmsBoardSummary::reset(int columnCount, int rowCount) {
+    this->m_numberOfColumns = std::max(0, columnCount);
+    this->m_numberOfRows = std::max(0, rowCount);
+    const int longestSide{std::max(this->m_numberOfColumns, this->m_numberOfRows)};
+    this->m_tileSize = std::max(1, (longestSide + QmsBoardSummary::s_MAXIMUM_TILES_PER_SIDE - 1) /
+                                   QmsBoardSummary::s_MAXIMUM_TILES_PER_SIDE);
+    this->m_numberOfTileColumns = (this->m_numberOfColumns + this->m_tileSize - 1) / this->m_tileSize;
+    this->m_numberOfTileRows = (this->m_numberOfRows + this->m_tileSize - 1) / this->m_tileSize;
+    const auto tileCount = static_cast<size_t>(this->m_numberOfTileColumns * this->m_numberOfTileRows);
+    this->m_revealedCounts.assign(tileCount, 0);
+    this->m_flaggedCounts.assign(tileCount, 0);
+    this->m_imageIsValid = false;
+}
+
+/* rebuild() : Used when a whole board is swapped in at once (a loaded
+ * game, a replay being seeked), where going cell by cell is all there is */
+void QmsBoardSummary::rebuild(const QmsCellGrid &cells) {
+    this->reset(cells.numberOfColumns(), cells.numberOfRows());
+    for (int cellIndex = 0; cellIndex < cells.size(); cellIndex++) {
+        this->changeCell(cellIndex, CellVisibility::Covered, cells.at(cellIndex).visibility());
+    }
+}
+
+void QmsBoardSummary::changeCell(int cellIndex, CellVisibility previousVisibility, CellVisibility newVisibility) {
+    if ((previousVisibility == newVisibility) || (cellIndex < 0) ||
+        (cellIndex >= this->m_numberOfColumns * this->m_numberOfRows)) {
+        return;
+    }
+    const auto tileIndex = static_cast<size_t>(this->tileIndexOf(cellIndex));
+    if (previousVisibility == CellVisibility::Revealed) {
+        this->m_revealedCounts[tileIndex]--;
+    } else if (previousVisibility == CellVisibility::Flagged) {
+        this->m_flaggedCounts[tileIndex]--;
+    }
+    if (newVisibility == CellVisibility::Revealed) {
+        this->m_revealedCounts[tileIndex]++;
+    } else if (newVisibility == CellVisibility::Flagged) {
+        this->m_flaggedCounts[tileIndex]++;
+    }
+    this->m_imageIsValid = false;
+}
+
+int QmsBoardSummary::numberOfColumns() const {
+    return this->m_numberOfColumns;
+}
+
+int QmsBoardSummary::numberOfRows() const {
+    return this->m_numberOfRows;
+}
+
+int QmsBoardSummary::tileSize() const {
+    return this->m_tileSize;
+}
+
+int QmsBoardSummary::numberOfTileColumns() const {
+    return this->m_numberOfTileColumns;
+}
+
+int QmsBoardSummary::numberOfTileRows() const {
+    return this->m_numberOfTileRows;
+}
+
+QmsTileSummary QmsBoardSummary::tileAt(int tileColumn, int tileRow) const {
+    const auto tileIndex = static_cast<size_t>((tileRow * this->m_numberOfTileColumns) + tileColumn);
+    return QmsTileSummary{this->tileCellCount(tileColumn, tileRow),
+                          static_cast<int>(this->m_revealedCounts[tileIndex]),
+                          static_cast<int>(this->m_flaggedCounts[tileIndex])};
+}
+
+/* image() : One pixel per tile, each one a mix of the revealed, flagged and unknown colors
+ * weighted by how many of the tile's cells are in that state. Only drawn again after a change */
+const QImage &QmsBoardSummary::image() const {
+    if (this->m_imageIsValid) {
+        return this->m_image;
+    }
+    if ((this->m_image.width() != this->m_numberOfTileColumns) || (this->m_image.height() != this->m_numberOfTileRows)) {
+        this->m_image = QImage{this->m_numberOfTileColumns, this->m_numberOfTileRows, QImage::Format_RGB32};
+    }
+    for (int tileRow = 0; tileRow < this->m_numberOfTileRows; tileRow++) {
+        auto *line = reinterpret_cast<QRgb *>(this->m_image.scanLine(tileRow));
+        for (int tileColumn = 0; tileColumn < this->m_numberOfTileColumns; tileColumn++) {
+            const QmsTileSummary tile{this->tileAt(tileColumn, tileRow)};
+            const int cellCount{std::max(1, tile.cellCount)};
+            const auto mix = [&tile, cellCount](int revealed, int flagged, int unknown) {
+                return ((revealed * tile.revealedCount) + (flagged * tile.flaggedCount) + (unknown * tile.unknownCount())) / cellCount;
+            };
+            line[tileColumn] = qRgb(mix(s_REVEALED_COLOR.red(), s_FLAGGED_COLOR.red(), s_UNKNOWN_COLOR.red()),
+                                    mix(s_REVEALED_COLOR.green(), s_FLAGGED_COLOR.green(), s_UNKNOWN_COLOR.green()),
+                                    mix(s_REVEALED_COLOR.blue(), s_FLAGGED_COLOR.blue(), s_UNKNOWN_COLOR.blue()));
+        }
+    }
+    this->m_imageIsValid = true;
+    return this->m_image;
+}
+
+/* drawTiles() : Draws the tile image stretched over boardRect, the whole board's rectangle
+ * on the painter's device. Only the part of the image behind exposedRect is scaled, so
+ * drawing costs the same however much bigger than the exposed area the board is */
+void QmsBoardSummary::drawTiles(QPainter *painter, const QRectF &boardRect, const QRect &exposedRect) const {
+    const QImage &tiles = this->image();
+    if (tiles.isNull() || boardRect.isEmpty()) {
+        return;
+    }
+    const QRectF targetRect{boardRect.intersected(QRectF{exposedRect})};
+    if (targetRect.isEmpty()) {
+        return;
+    }
+    const qreal horizontalScale{tiles.width() / boardRect.width()};
+    const qreal verticalScale{tiles.height() / boardRect.height()};
+    const QRectF sourceRect{(targetRect.x() - boardRect.x()) * horizontalScale, (targetRect.y() - boardRect.y()) * verticalScale,
+                            targetRect.width() * horizontalScale, targetRect.height() * verticalScale};
+    painter->drawImage(targetRect, tiles, sourceRect);
+}
+
+int QmsBoardSummary::tileIndexOf(int cellIndex) const {
+    const int columnIndex{cellIndex % this->m_numberOfColumns};
+    const int rowIndex{cellIndex / this->m_numberOfColumns};
+    return ((rowIndex / this->m_tileSize) * this->m_numberOfTileColumns) + (columnIndex / this->m_tileSize);
+}
+
+/* tileCellCount() : Tiles along the right and bottom edges may be cut short by the board */
+int QmsBoardSummary::tileCellCount(int tileColumn, int tileRow) const {
+    const int width{std::min(this->m_tileSize, this->m_numberOfColumns - (tileColumn * this->m_tileSize))};
+    const int height{std::min(this->m_tileSize, this->m_numberOfRows - (tileRow * this->m_tileSize))};
+    return width * height;
+}
+
+int QmsBoardSummary::MAXIMUM_TILES_PER_SIDE() {
+    return QmsBoardSummary::s_MAXIMUM_TILES_PER_SIDE;
+}
+
+const QColor &QmsBoardSummary::REVEALED_COLOR() {
+    return QmsBoardSummary::s_REVEALED_COLOR;
+}
+
+const QColor &QmsBoardSummary::FLAGGED_COLOR() {
+    return QmsBoardSummary::s_FLAGGED_COLOR;
+}
+
+const QColor &QmsBoardSummary::UNKNOWN_COLOR() {
+    return QmsBoardSummary::s_UNKNOWN_COLOR;
+}
@@ -0,0 +1,75 @@
+#ifndef QMINESWEEPER_QMSBOARDSUMMARY_HPP
+#define QMINESWEEPER_QMSBOARDSUMMARY_HPP
+
+#include <QImage>
+#include <QColor>
+
+#include <cstdint>
+#include <vector>
+
+#include "QmsCellState.hpp"
+
+class QmsCellGrid;
+class QPainter;
+class QRect;
+class QRectF;
+
+/* QmsTileSummary : How many cells of one tile the player has revealed or flagged */
+struct QmsTileSummary {
+    int cellCount;
+    int revealedCount;
+    int flaggedCount;
+
+    inline int unknownCount() const {
+        return this->cellCount - this->revealedCount - this->flaggedCount;
+    }
+};
+
+/* QmsBoardSummary : The board downsampled into square tiles of tileSize() x tileSize() cells,
+ * with the number of revealed and flagged cells kept per tile. The tile size is picked so that
+ * neither side of the board has more than MAXIMUM_TILES_PER_SIDE() tiles, so anything drawn
+ * from the summary (the minimap, the zoomed out board) costs the same for any size of board.
+ * Like the state hash, it is updated in O(1) for every cell the player changes */
+class QmsBoardSummary {
+public:
+    QmsBoardSummary();
+
+    void reset(int columnCount, int rowCount);
+    void rebuild(const QmsCellGrid &cells);
+    void changeCell(int cellIndex, CellVisibility previousVisibility, CellVisibility newVisibility);
+
+    int numberOfColumns() const;
+    int numberOfRows() const;
+    int tileSize() const;
+    int numberOfTileColumns() const;
+    int numberOfTileRows() const;
+    QmsTileSummary tileAt(int tileColumn, int tileRow) const;
+    const QImage &image() const;
+    void drawTiles(QPainter *painter, const QRectF &boardRect, const QRect &exposedRect) const;
+
+    static int MAXIMUM_TILES_PER_SIDE();
+    static const QColor &REVEALED_COLOR();
+    static const QColor &FLAGGED_COLOR();
+    static const QColor &UNKNOWN_COLOR();
+
+private:
+    int m_numberOfColumns;
+    int m_numberOfRows;
+    int m_tileSize;
+    int m_numberOfTileColumns;
+    int m_numberOfTileRows;
+    std::vector<uint32_t> m_revealedCounts;
+    std::vector<uint32_t> m_flaggedCounts;
+    mutable QImage m_image;
+    mutable bool m_imageIsValid;
+
+    int tileIndexOf(int cellIndex) const;
+    int tileCellCount(int tileColumn, int tileRow) const;
+
+    static const int s_MAXIMUM_TILES_PER_SIDE;
+    static const QColor s_REVEALED_COLOR;
+    static const QColor s_FLAGGED_COLOR;
+    static const QColor s_UNKNOWN_COLOR;
+};
+
+#endif //QMINESWEEPER_QMSBOARDSUMMARY_HPP
@@ -0,0 +1,255 @@
+#include "QmsBoardView.hpp"
+#include "QmsBoardOverview.hpp"
+#include "GameController.hpp"
+
+#include <QFrame>
+#include <QScrollBar>
+#include <QWheelEvent>
+#include <QMouseEvent>
+
+#include <algorithm>
+#include <cmath>
+
+const double QmsBoardView::s_MAXIMUM_ZOOM_FACTOR{4.0};
+const double QmsBoardView::s_ZOOM_STEP{1.25};
+const int QmsBoardView::s_OVERVIEW_CELL_SIZE{8};
+
+/* QmsBoardView() : The mine field is moved off of the window's layout onto a canvas with no
+ * layout of its own, next to the overview. Both are placed by hand in updateContentSize() */
+QmsBoardView::QmsBoardView(QFrame *mineFrame, QWidget *parent) :
+        QScrollArea{parent},
+        m_mineFrame{mineFrame},
+        m_canvas{new QWidget{}},
+        m_overview{nullptr},
+        m_baseCellSize{QSize{0, 0}},
+        m_maximumViewportSize{QSize{0, 0}},
+        m_zoomFactor{1.0},
+        m_isPanning{false},
+        m_lastPanPosition{} {
+    this->setFrameShape(QFrame::NoFrame);
+    this->setWidgetResizable(false);
+    this->setAlignment(Qt::AlignCenter);
+    this->setWidget(this->m_canvas);
+    this->m_mineFrame->setParent(this->m_canvas);
+    this->m_mineFrame->show();
+    this->m_overview = new QmsBoardOverview{this->m_canvas};
+    this->m_overview->hide();
+    this->viewport()->installEventFilter(this);
+
+    connect(this->m_overview, &QmsBoardOverview::cellClicked, this, &QmsBoardView::onOverviewCellClicked);
+    connect(this->horizontalScrollBar(), &QScrollBar::valueChanged, this, &QmsBoardView::visibleCellsChanged);
+    connect(this->verticalScrollBar(), &QScrollBar::valueChanged, this, &QmsBoardView::visibleCellsChanged);
+    connect(this->horizontalScrollBar(), &QScrollBar::rangeChanged, this, &QmsBoardView::visibleCellsChanged);
+    connect(this->verticalScrollBar(), &QScrollBar::rangeChanged, this, &QmsBoardView::visibleCellsChanged);
+}
+
+/* setBaseCellSize() : The size of a cell at a zoom factor of 1, picked by the main window so a
+ * board of reasonable size fits on the screen. A new board always starts at that zoom factor */
+void QmsBoardView::setBaseCellSize(const QSize &baseCellSize) {
+    this->m_baseCellSize = baseCellSize;
+    this->m_zoomFactor = 1.0;
+}
+
+void QmsBoardView::setMaximumViewportSize(const QSize &maximumViewportSize) {
+    this->m_maximumViewportSize = maximumViewportSize;
+}
+
+/* updateContentSize() : Called after the cells changed size (or the board did). Only the
+ * widget matching the current level of detail is shown, so the QmsButtons are never laid
+ * out or painted while the overview stands in for them */
+void QmsBoardView::updateContentSize() {
+    const int offset{this->contentOffset()};
+    const QSize boardSize{this->boardPixelSize()};
+    const QSize contentSize{boardSize + QSize{2 * offset, 2 * offset}};
+    if (this->showsOverview()) {
+        this->m_overview->setGeometry(QRect{QPoint{offset, offset}, boardSize});
+        this->m_overview->show();
+        this->m_mineFrame->hide();
+    } else {
+        this->m_mineFrame->setGeometry(QRect{QPoint{0, 0}, contentSize});
+        this->m_mineFrame->show();
+        this->m_overview->hide();
+    }
+    this->m_canvas->resize(contentSize);
+    this->updateGeometry();
+    emit(contentSizeChanged());
+    emit(visibleCellsChanged());
+}
+
+/* centerOnCell() : Used by the minimap, with cell in (fractional) cell units */
+void QmsBoardView::centerOnCell(const QPointF &cell) {
+    this->scrollCellToViewportPosition(cell, QPointF{this->viewport()->width() / 2.0, this->viewport()->height() / 2.0});
+}
+
+/* zoomBy() : The cell under anchor (in viewport coordinates) stays under anchor after zooming.
+ * Nothing is resized when the cell size in pixels does not actually change */
+void QmsBoardView::zoomBy(double factor, const QPoint &anchor) {
+    if ((this->m_baseCellSize.width() <= 0) || (this->m_baseCellSize.height() <= 0)) {
+        return;
+    }
+    const QPointF anchorCell{this->cellAtViewportPosition(anchor)};
+    const QSize previousCellSize{this->cellSize()};
+    this->m_zoomFactor = std::max(this->minimumZoomFactor(),
+                                  std::min(QmsBoardView::s_MAXIMUM_ZOOM_FACTOR, this->m_zoomFactor * factor));
+    if (this->cellSize() == previousCellSize) {
+        return;
+    }
+    if (!this->showsOverview()) {
+        emit(cellSizeChanged(this->cellSize()));
+    }
+    this->updateContentSize();
+    this->scrollCellToViewportPosition(anchorCell, QPointF{anchor});
+}
+
+QSize QmsBoardView::cellSize() const {
+    return QSize{std::max(1, static_cast<int>(std::lround(this->m_baseCellSize.width() * this->m_zoomFactor))),
+                 std::max(1, static_cast<int>(std::lround(this->m_baseCellSize.height() * this->m_zoomFactor)))};
+}
+
+/* visibleCells() : The part of the board inside the viewport, in (fractional) cell units */
+QRectF QmsBoardView::visibleCells() const {
+    const QSize currentCellSize{this->cellSize()};
+    const QPointF topLeft{this->cellAtViewportPosition(QPoint{0, 0})};
+    const QRectF visible{topLeft, QSizeF{static_cast<qreal>(this->viewport()->width()) / currentCellSize.width(),
+                                         static_cast<qreal>(this->viewport()->height()) / currentCellSize.height()}};
+    return visible.intersected(QRectF{0, 0, static_cast<qreal>(gameController->numberOfColumns()),
+                                      static_cast<qreal>(gameController->numberOfRows())});
+}
+
+bool QmsBoardView::showsOverview() const {
+    const QSize currentCellSize{this->cellSize()};
+    return std::min(currentCellSize.width(), currentCellSize.height()) < QmsBoardView::s_OVERVIEW_CELL_SIZE;
+}
+
+bool QmsBoardView::isOverflowing() const {
+    const QSize contentSize{this->m_canvas->size()};
+    return (this->m_maximumViewportSize.isValid()) &&
+           ((contentSize.width() > this->m_maximumViewportSize.width()) ||
+            (contentSize.height() > this->m_maximumViewportSize.height()));
+}
+
+/* sizeHint() : As large as the board, up to the maximum viewport size, plus
+ * room for the scroll bars on whichever side the board does not fit */
+QSize QmsBoardView::sizeHint() const {
+    const QSize contentSize{this->m_canvas->size()};
+    if (!this->m_maximumViewportSize.isValid()) {
+        return contentSize;
+    }
+    QSize hint{contentSize.boundedTo(this->m_maximumViewportSize)};
+    if (contentSize.width() > this->m_maximumViewportSize.width()) {
+        hint.rheight() += this->horizontalScrollBar()->sizeHint().height();
+    }
+    if (contentSize.height() > this->m_maximumViewportSize.height()) {
+        hint.rwidth() += this->verticalScrollBar()->sizeHint().width();
+    }
+    return hint;
+}
+
+QSize QmsBoardView::minimumSizeHint() const {
+    return this->sizeHint();
+}
+
+/* eventFilter() : Wheel and middle button events not taken by the mine field
+ * (which only handles the left and right buttons) end up at the viewport */
+bool QmsBoardView::eventFilter(QObject *watched, QEvent *event) {
+    if (watched != this->viewport()) {
+        return QScrollArea::eventFilter(watched, event);
+    }
+    if (event->type() == QEvent::Wheel) {
+        auto wheelEvent = static_cast<QWheelEvent *>(event);
+        if ((wheelEvent->modifiers() & Qt::ControlModifier) && (wheelEvent->angleDelta().y() != 0)) {
+            const double notches{wheelEvent->angleDelta().y() / 120.0};
+            this->zoomBy(std::pow(QmsBoardView::s_ZOOM_STEP, notches), wheelEvent->pos());
+            return true;
+        }
+    } else if (event->type() == QEvent::MouseButtonPress) {
+        auto mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() == Qt::MouseButton::MiddleButton) {
+            this->m_isPanning = true;
+            this->m_lastPanPosition = mouseEvent->globalPos();
+            this->viewport()->setCursor(Qt::ClosedHandCursor);
+            return true;
+        }
+    } else if ((event->type() == QEvent::MouseMove) && this->m_isPanning) {
+        auto mouseEvent = static_cast<QMouseEvent *>(event);
+        const QPoint delta{mouseEvent->globalPos() - this->m_lastPanPosition};
+        this->m_lastPanPosition = mouseEvent->globalPos();
+        this->horizontalScrollBar()->setValue(this->horizontalScrollBar()->value() - delta.x());
+        this->verticalScrollBar()->setValue(this->verticalScrollBar()->value() - delta.y());
+        return true;
+    } else if ((event->type() == QEvent::MouseButtonRelease) && this->m_isPanning) {
+        auto mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() == Qt::MouseButton::MiddleButton) {
+            this->m_isPanning = false;
+            this->viewport()->unsetCursor();
+            return true;
+        }
+    }
+    return QScrollArea::eventFilter(watched, event);
+}
+
+/* onOverviewCellClicked() : Zooms back in far enough for the QmsButtons to be shown
+ * again, around the cell that was clicked, without zooming in any further than that */
+void QmsBoardView::onOverviewCellClicked(const QPointF &cell) {
+    const int smallestSide{std::max(1, std::min(this->m_baseCellSize.width(), this->m_baseCellSize.height()))};
+    const double detailedZoomFactor{std::min(1.0, (2.0 * QmsBoardView::s_OVERVIEW_CELL_SIZE) / smallestSide)};
+    if (detailedZoomFactor > this->m_zoomFactor) {
+        this->zoomBy(detailedZoomFactor / this->m_zoomFactor, QPoint{0, 0});
+    }
+    this->centerOnCell(cell);
+}
+
+/* minimumZoomFactor() : Zooming out stops once the whole board fits in the viewport */
+double QmsBoardView::minimumZoomFactor() const {
+    const int numberOfColumns{std::max(1, gameController->numberOfColumns())};
+    const int numberOfRows{std::max(1, gameController->numberOfRows())};
+    if ((!this->m_maximumViewportSize.isValid()) || (this->m_baseCellSize.width() <= 0) ||
+        (this->m_baseCellSize.height() <= 0)) {
+        return 1.0;
+    }
+    const double fitsWidth{static_cast<double>(this->m_maximumViewportSize.width()) /
+                           (numberOfColumns * this->m_baseCellSize.width())};
+    const double fitsHeight{static_cast<double>(this->m_maximumViewportSize.height()) /
+                            (numberOfRows * this->m_baseCellSize.height())};
+    return std::min(1.0, std::min(fitsWidth, fitsHeight));
+}
+
+QSize QmsBoardView::boardPixelSize() const {
+    const QSize currentCellSize{this->cellSize()};
+    return QSize{gameController->numberOfColumns() * currentCellSize.width(),
+                 gameController->numberOfRows() * currentCellSize.height()};
+}
+
+/* contentOffset() : The first cell starts inside the mine field's frame. The
+ * overview is placed at the same offset, so cells line up between the two */
+int QmsBoardView::contentOffset() const {
+    return this->m_mineFrame->frameWidth();
+}
+
+QPointF QmsBoardView::cellAtViewportPosition(const QPoint &position) const {
+    const QSize currentCellSize{this->cellSize()};
+    const QPoint canvasPosition{this->m_canvas->mapFrom(this->viewport(), position)};
+    return QPointF{static_cast<qreal>(canvasPosition.x() - this->contentOffset()) / currentCellSize.width(),
+                   static_cast<qreal>(canvasPosition.y() - this->contentOffset()) / currentCellSize.height()};
+}
+
+void QmsBoardView::scrollCellToViewportPosition(const QPointF &cell, const QPointF &position) {
+    const QSize currentCellSize{this->cellSize()};
+    const int offset{this->contentOffset()};
+    this->horizontalScrollBar()->setValue(
+            static_cast<int>(std::lround(offset + (cell.x() * currentCellSize.width()) - position.x())));
+    this->verticalScrollBar()->setValue(
+            static_cast<int>(std::lround(offset + (cell.y() * currentCellSize.height()) - position.y())));
+}
+
+double QmsBoardView::MAXIMUM_ZOOM_FACTOR() {
+    return QmsBoardView::s_MAXIMUM_ZOOM_FACTOR;
+}
+
+double QmsBoardView::ZOOM_STEP() {
+    return QmsBoardView::s_ZOOM_STEP;
+}
+
+int QmsBoardView::OVERVIEW_CELL_SIZE() {
+    return QmsBoardView::s_OVERVIEW_CELL_SIZE;
+}
@@ -0,0 +1,79 @@
+#ifndef QMINESWEEPER_QMSBOARDVIEW_HPP
+#define QMINESWEEPER_QMSBOARDVIEW_HPP
+
+#include <QScrollArea>
+#include <QSize>
+#include <QRectF>
+#include <QPoint>
+
+#include <memory>
+
+class QFrame;
+class QmsBoardOverview;
+
+/* QmsBoardView : The scrollable viewport the mine field is shown through. Ctrl + mouse wheel
+ * zooms around the cursor and the middle mouse button drags the board around. The size of a
+ * cell follows the zoom factor: the mine field is resized to match, its grid layout resizing the
+ * QmsButtons, and the new size is reported through cellSizeChanged(). Once cells become smaller
+ * than OVERVIEW_CELL_SIZE() pixels the buttons are hidden and the board is drawn from the summary
+ * tiles instead (see QmsBoardOverview), which makes zooming out over a very large board as cheap
+ * as looking at a small one */
+class QmsBoardView : public QScrollArea {
+Q_OBJECT
+public:
+    QmsBoardView(QFrame *mineFrame, QWidget *parent);
+    ~QmsBoardView() override = default;
+    QmsBoardView(const QmsBoardView &rhs) = delete;
+    QmsBoardView &operator=(const QmsBoardView &rhs) = delete;
+
+    void setBaseCellSize(const QSize &baseCellSize);
+    void setMaximumViewportSize(const QSize &maximumViewportSize);
+    void updateContentSize();
+    void centerOnCell(const QPointF &cell);
+    void zoomBy(double factor, const QPoint &anchor);
+
+    QSize cellSize() const;
+    QRectF visibleCells() const;
+    bool showsOverview() const;
+    bool isOverflowing() const;
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+    static double MAXIMUM_ZOOM_FACTOR();
+    static double ZOOM_STEP();
+    static int OVERVIEW_CELL_SIZE();
+
+signals:
+    void cellSizeChanged(const QSize &cellSize);
+    void contentSizeChanged();
+    void visibleCellsChanged();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onOverviewCellClicked(const QPointF &cell);
+
+private:
+    QFrame *m_mineFrame;
+    QWidget *m_canvas;
+    QmsBoardOverview *m_overview;
+    QSize m_baseCellSize;
+    QSize m_maximumViewportSize;
+    double m_zoomFactor;
+    bool m_isPanning;
+    QPoint m_lastPanPosition;
+
+    double minimumZoomFactor() const;
+    QSize boardPixelSize() const;
+    int contentOffset() const;
+    QPointF cellAtViewportPosition(const QPoint &position) const;
+    void scrollCellToViewportPosition(const QPointF &cell, const QPointF &position);
+
+    static const double s_MAXIMUM_ZOOM_FACTOR;
+    static const double s_ZOOM_STEP;
+    static const int s_OVERVIEW_CELL_SIZE;
+};
+
+#endif //QMINESWEEPER_QMSBOARDVIEW_HPP
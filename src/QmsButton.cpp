@@ -23,8 +23,10 @@
 #include "GameController.hpp"
 #include "QmsStrings.hpp"
 #include "GlobalDefinitions.hpp"
+#include "QmsBoardRepaintScheduler.hpp"
 
 #include <QString>
+#include <QPainter>
 
 #if defined (__3D_QMINESWEEPER__)
 const int QmsButton::MAXIMUM_NUMBER_OF_SURROUNDING_MINES{27};
@@ -32,6 +34,10 @@ const int QmsButton::MAXIMUM_NUMBER_OF_SURROUNDING_MINES{27};
 const int QmsButton::MAXIMUM_NUMBER_OF_SURROUNDING_MINES{8};
 #endif
 
+const QColor QmsButton::UNCOVERED_MINE_COLOR{255, 0, 0};
+const QColor QmsButton::LONG_CLICKED_COLOR{0, 255, 0};
+const double QmsButton::GLYPH_SCALE_FACTOR{0.75};
+
 QmsButton::QmsButton(int columnIndex, int rowIndex, QWidget *parent) :
         QPushButton{parent},
         m_hasMine{false},
@@ -42,8 +48,9 @@ QmsButton::QmsButton(int columnIndex, int rowIndex, QWidget *parent) :
         m_columnIndex{columnIndex},
         m_rowIndex{rowIndex},
         m_isBeingLongClicked{false},
-        m_blockClicks{false},
-        m_longClickTimer{} {
+        m_showsUncoveredMine{false},
+        m_glyph{CellGlyph::None},
+        m_repaintScheduler{nullptr} {
     this->initialize();
 }
 
@@ -57,8 +64,9 @@ QmsButton::QmsButton(const QmsButton &rhs) :
         m_columnIndex{rhs.m_columnIndex},
         m_rowIndex{rhs.m_rowIndex},
         m_isBeingLongClicked{false},
-        m_blockClicks{false},
-        m_longClickTimer{rhs.m_longClickTimer} {
+        m_showsUncoveredMine{rhs.m_showsUncoveredMine},
+        m_glyph{rhs.m_glyph},
+        m_repaintScheduler{rhs.m_repaintScheduler} {
     this->initialize();
 }
 
@@ -72,8 +80,9 @@ QmsButton::QmsButton(QmsButton &&rhs) noexcept :
         m_columnIndex{rhs.m_columnIndex},
         m_rowIndex{rhs.m_rowIndex},
         m_isBeingLongClicked{false},
-        m_blockClicks{false},
-        m_longClickTimer{rhs.m_longClickTimer} {
+        m_showsUncoveredMine{rhs.m_showsUncoveredMine},
+        m_glyph{rhs.m_glyph},
+        m_repaintScheduler{rhs.m_repaintScheduler} {
     this->initialize();
 }
 
@@ -87,8 +96,9 @@ QmsButton &QmsButton::operator=(const QmsButton &rhs) {
     this->m_columnIndex = rhs.m_columnIndex;
     this->m_rowIndex = rhs.m_rowIndex;
     this->m_isBeingLongClicked = false;
-    this->m_blockClicks = false;
-    this->m_longClickTimer = rhs.m_longClickTimer;
+    this->m_showsUncoveredMine = rhs.m_showsUncoveredMine;
+    this->m_glyph = rhs.m_glyph;
+    this->m_repaintScheduler = rhs.m_repaintScheduler;
     return *this;
 }
 
@@ -102,13 +112,38 @@ QmsButton &QmsButton::operator=(QmsButton &&rhs) noexcept {
     this->m_columnIndex = rhs.m_columnIndex;
     this->m_rowIndex = rhs.m_rowIndex;
     this->m_isBeingLongClicked = false;
-    this->m_blockClicks = false;
-    this->m_longClickTimer = rhs.m_longClickTimer;
+    this->m_showsUncoveredMine = rhs.m_showsUncoveredMine;
+    this->m_glyph = rhs.m_glyph;
+    this->m_repaintScheduler = rhs.m_repaintScheduler;
     return *this;
 }
 
+/* initialize() : Mouse input for the whole board is handled by the QmsBoardInputDispatcher
+ * on the mine field, so the buttons let every mouse event through to it. They also take
+ * whatever size the mine field's grid layout gives them, so zooming the board only changes
+ * the size of the mine field, never that of each button */
 void QmsButton::initialize() {
+    this->setAttribute(Qt::WA_TransparentForMouseEvents);
+    this->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
+}
 
+/* recycle() : Puts a button taken back out of the GameController's button pool into the
+ * state of a newly constructed one, at new coordinates, which is much cheaper than
+ * creating (and laying out) a new widget */
+void QmsButton::recycle(int columnIndex, int rowIndex) {
+    this->m_columnIndex = columnIndex;
+    this->m_rowIndex = rowIndex;
+    this->m_hasMine = false;
+    this->m_hasFlag = false;
+    this->m_hasQuestionMark = false;
+    this->m_isRevealed = false;
+    this->m_numberOfSurroundingMines = 0;
+    this->setIsBeingLongClicked(false);
+    this->setDown(false);
+    this->setChecked(false);
+    this->setFlat(false);
+    this->setShowsUncoveredMine(false);
+    this->setGlyph(CellGlyph::None);
 }
 
 std::string QmsButton::toString() const {
@@ -124,81 +159,78 @@ bool QmsButton::operator==(const QmsButton &other) const {
     return ((this->m_columnIndex == other.columnIndex()) && (this->m_rowIndex == other.rowIndex()));
 }
 
-void QmsButton::mousePressEvent(QMouseEvent *mouseEvent) {
-    if (this->m_blockClicks) {
-        LOG_DEBUG() << QString{
-                "%1 experienced a mousePressEvent, but it's blockClicks property was set, so the event was ignored"}.arg(
-                this->toQString());
-        return;
-    }
-    if (this->isChecked()) {
-        this->m_isRevealed = true;
+/* setGlyph() : Glyphs are drawn from the application's icon atlas in paintEvent(),
+ * rather than set as a QIcon, so only a change of glyph schedules a repaint */
+void QmsButton::setGlyph(CellGlyph glyph) {
+    if (this->m_glyph != glyph) {
+        this->m_glyph = glyph;
+        this->scheduleRepaint();
     }
-    if (mouseEvent->button() == Qt::MouseButton::LeftButton) {
-        if ((!this->m_isRevealed) && (this->rect().contains(mouseEvent->pos()))) {
-            LOG_DEBUG() << QString{"%1 was left clicked (mouse down only)"}.arg(this->toQString());
-            emit(leftClicked(this));
-        }
-    } else if (mouseEvent->button() == Qt::MouseButton::RightButton) {
-        if ((!this->m_isRevealed) && (this->rect().contains(mouseEvent->pos()))) {
-            LOG_DEBUG() << QString{"%1 was right clicked (mouse down only)"}.arg(this->toQString());
-            emit(rightClicked(this));
-        }
-    }
-    this->m_longClickTimer.restart();
-    QTimer::singleShot(GameController::LONG_CLICK_THRESHOLD(), this, SLOT(doInformLongClick()));
 }
 
-void QmsButton::setBlockClicks(bool blockClicks) {
-    this->m_blockClicks = blockClicks;
+CellGlyph QmsButton::glyph() const {
+    return this->m_glyph;
 }
 
-bool QmsButton::isBlockingClicks() const {
-    return this->m_blockClicks;
+/* setShowsUncoveredMine() : Marks the button as a mine that was uncovered at the end of
+ * a game, which paintEvent() draws as a solid red square. Like the long click highlight,
+ * this is a plain flag rather than a stylesheet, so setting it never re-polishes the button */
+void QmsButton::setShowsUncoveredMine(bool showsUncoveredMine) {
+    if (this->m_showsUncoveredMine != showsUncoveredMine) {
+        this->m_showsUncoveredMine = showsUncoveredMine;
+        this->scheduleRepaint();
+    }
 }
 
-void QmsButton::doInformLongClick() {
-    using namespace QmsStrings;
-    if (this->isDown()) {
-        this->setStyleSheet(LONG_CLICKED_MINE_STYLESHEET);
-        this->m_isBeingLongClicked = true;
-    }
+bool QmsButton::showsUncoveredMine() const {
+    return this->m_showsUncoveredMine;
 }
 
-void QmsButton::mouseReleaseEvent(QMouseEvent *mouseEvent) {
-    using namespace QmsStrings;
-    if (this->m_blockClicks) {
+/* paintEvent() : Highlighted buttons (an uncovered mine, or one being long clicked) are
+ * filled with a flat color instead of the style's bevel. The glyph, if any, is then drawn
+ * on top from the application's icon atlas, at GLYPH_SCALE_FACTOR of the button's size */
+void QmsButton::paintEvent(QPaintEvent *paintEvent) {
+    const QSize glyphSize{this->size() * QmsButton::GLYPH_SCALE_FACTOR};
+    if (this->m_showsUncoveredMine || this->m_isBeingLongClicked) {
+        QPainter painter{this};
+        painter.fillRect(this->rect(), this->m_showsUncoveredMine ? QmsButton::UNCOVERED_MINE_COLOR : QmsButton::LONG_CLICKED_COLOR);
+        applicationIcons->iconAtlas()->drawGlyph(&painter, this->rect(), this->m_glyph, glyphSize,
+                                                 this->devicePixelRatioF());
         return;
     }
-    if (this->isChecked()) {
-        this->m_isRevealed = true;
+    QPushButton::paintEvent(paintEvent);
+    if (this->m_glyph != CellGlyph::None) {
+        QPainter painter{this};
+        applicationIcons->iconAtlas()->drawGlyph(&painter, this->rect(), this->m_glyph, glyphSize,
+                                                 this->devicePixelRatioF());
     }
-    this->setStyleSheet("");
-    this->m_longClickTimer.update();
-    if (mouseEvent->button() == Qt::MouseButton::LeftButton) {
-        if ((!this->m_isRevealed) && (this->rect().contains(mouseEvent->pos()))) {
-            if ((this->m_longClickTimer.totalTime() >= GameController::LONG_CLICK_THRESHOLD()) ||
-                (this->m_isBeingLongClicked)) {
-                LOG_DEBUG() << QString{"%1 was long left clicked"}.arg(this->toQString());
-                emit (longLeftClickReleased(this));
-            } else {
-                LOG_DEBUG() << QString{"%1 was left clicked"}.arg(this->toQString());
-                emit(leftClickReleased(this));
-            }
-        }
-    } else if (mouseEvent->button() == Qt::MouseButton::RightButton) {
-        if ((!this->m_isRevealed) && (this->rect().contains(mouseEvent->pos()))) {
-            if ((this->m_longClickTimer.totalTime() >= GameController::LONG_CLICK_THRESHOLD()) ||
-                (this->m_isBeingLongClicked)) {
-                LOG_DEBUG() << QString{"%1 was long right clicked"}.arg(this->toQString());
-                emit longRightClickReleased(this);
-            } else {
-                LOG_DEBUG() << QString{"%1 was right clicked"}.arg(this->toQString());
-                emit(rightClickReleased(this));
-            }
-        }
+}
+
+/* setIsBeingLongClicked() : Set by the board's input dispatcher while the button is held
+ * down past the long click threshold, which paintEvent() shows as a green highlight */
+void QmsButton::setIsBeingLongClicked(bool isBeingLongClicked) {
+    if (this->m_isBeingLongClicked != isBeingLongClicked) {
+        this->m_isBeingLongClicked = isBeingLongClicked;
+        this->scheduleRepaint();
+    }
+}
+
+bool QmsButton::isBeingLongClicked() const {
+    return this->m_isBeingLongClicked;
+}
+
+/* setRepaintScheduler() : Buttons on the mine field leave their repaints to the board's
+ * QmsBoardRepaintScheduler, so the cells changed by one move are repainted together */
+void QmsButton::setRepaintScheduler(QmsBoardRepaintScheduler *repaintScheduler) {
+    this->m_repaintScheduler = repaintScheduler;
+}
+
+void QmsButton::scheduleRepaint() {
+    if (this->m_repaintScheduler) {
+        this->m_repaintScheduler->markDirty(this);
+    } else {
+        this->update();
     }
-    this->m_isBeingLongClicked = false;
 }
 
 void QmsButton::setHasMine(bool hasMine) {
@@ -207,20 +239,12 @@ void QmsButton::setHasMine(bool hasMine) {
 
 void QmsButton::setHasQuestionMark(bool hasQuestionMark) {
     this->m_hasQuestionMark = hasQuestionMark;
-    if (this->m_hasQuestionMark) {
-        this->setIcon(applicationIcons->STATUS_ICON_QUESTION);
-    } else {
-        this->setIcon(QIcon{});
-    }
+    this->setGlyph(this->m_hasQuestionMark ? CellGlyph::QuestionMark : CellGlyph::None);
 }
 
 void QmsButton::setHasFlag(bool hasFlag) {
     this->m_hasFlag = hasFlag;
-    if (this->m_hasFlag) {
-        this->setIcon(applicationIcons->STATUS_ICON_FLAG);
-    } else {
-        this->setIcon(QIcon{});
-    }
+    this->setGlyph(this->m_hasFlag ? CellGlyph::Flag : CellGlyph::None);
 }
 
 void QmsButton::setIsRevealed(bool isRevealed) {
@@ -231,6 +255,17 @@ bool QmsButton::isRevealed() const {
     return this->m_isRevealed;
 }
 
+CellVisibility QmsButton::visibility() const {
+    if (this->m_isRevealed) {
+        return CellVisibility::Revealed;
+    } else if (this->m_hasFlag) {
+        return CellVisibility::Flagged;
+    } else if (this->m_hasQuestionMark) {
+        return CellVisibility::QuestionMarked;
+    }
+    return CellVisibility::Covered;
+}
+
 bool QmsButton::hasMine() const {
     return this->m_hasMine;
 }
@@ -298,8 +333,3 @@ void QmsButton::setRowIndex(int rowIndex) {
     }
     this->m_rowIndex = rowIndex;
 }
-
-void QmsButton::reveal() {
-    emit(this->leftClickReleased(this));
-}
-
@@ -8,7 +8,10 @@
 #include <QMessageBox>
 #include <QTimer>
 #include <QIcon>
+#include <QColor>
 #include "EventTimer.hpp"
+#include "QmsCellState.hpp"
+#include "QmsIconAtlas.hpp"
 
 #include <memory>
 #include <string>
@@ -19,6 +22,8 @@ class MineCoordinates;
 
 class QmsIcons;
 
+class QmsBoardRepaintScheduler;
+
 class QmsButton : public QPushButton {
 Q_OBJECT
 public:
@@ -39,6 +44,7 @@ public:
     bool hasFlag() const;
     bool hasQuestionMark() const;
     bool isRevealed() const;
+    CellVisibility visibility() const;
     std::shared_ptr<MineCoordinates> mineCoordinates() const;
 
     void setRowIndex(int rowIndex);
@@ -49,27 +55,25 @@ public:
     void setHasQuestionMark(bool hasQuestionMark);
     void setIsRevealed(bool isRevealed);
     void setNumberOfSurroundingMines(int numberOfSurroundingMines);
-    void setBlockClicks(bool blockClicks);
-    bool isBlockingClicks() const;
+    void setGlyph(CellGlyph glyph);
+    CellGlyph glyph() const;
+    void setShowsUncoveredMine(bool showsUncoveredMine);
+    bool showsUncoveredMine() const;
+    void setIsBeingLongClicked(bool isBeingLongClicked);
+    bool isBeingLongClicked() const;
+    void setRepaintScheduler(QmsBoardRepaintScheduler *repaintScheduler);
     std::string toString() const;
     QString toQString() const;
 
-    void reveal();
+    void recycle(int columnIndex, int rowIndex);
 
     static const int MAXIMUM_NUMBER_OF_SURROUNDING_MINES;
+    static const QColor UNCOVERED_MINE_COLOR;
+    static const QColor LONG_CLICKED_COLOR;
+    static const double GLYPH_SCALE_FACTOR;
 
-signals:
-    void leftClicked(QmsButton *msbp);
-    void rightClicked(QmsButton *msbp);
-    void leftClickReleased(QmsButton *msbp);
-    void longLeftClickReleased(QmsButton *msbp);
-    void rightClickReleased(QmsButton *msbp);
-    void longRightClickReleased(QmsButton *msbp);
-
-protected slots:
-    void mousePressEvent(QMouseEvent *mouseEvent) override;
-    void mouseReleaseEvent(QMouseEvent *mouseEvent) override;
-    void doInformLongClick();
+protected:
+    void paintEvent(QPaintEvent *paintEvent) override;
 
 private:
     bool m_hasMine;
@@ -80,9 +84,11 @@ private:
     int m_columnIndex;
     int m_rowIndex;
     bool m_isBeingLongClicked;
-    bool m_blockClicks;
-    SteadyEventTimer m_longClickTimer;
+    bool m_showsUncoveredMine;
+    CellGlyph m_glyph;
+    QmsBoardRepaintScheduler *m_repaintScheduler;
     void initialize();
+    void scheduleRepaint();
 
 };
 
@@ -0,0 +1,118 @@
+#ifndef QMINESWEEPER_QMSCELLGRID_HPP
+#define QMINESWEEPER_QMSCELLGRID_HPP
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "QmsCellState.hpp"
+
+/* QmsCellGrid : Row-major board of QmsCellStates with copy-on-write snapshots.
+ * Cells are stored in fixed size chunks, and both the chunks and the directory that
+ * points at them are shared between copies. Copying a grid only copies one shared_ptr,
+ * and the first write to a shared chunk clones just that chunk (and the directory, if
+ * it is shared too). A null chunk stands for a chunk of default (covered) cells, so a
+ * fresh board of any size is only a directory of null pointers */
+class QmsCellGrid {
+public:
+    QmsCellGrid() :
+            QmsCellGrid{0, 0} {
+
+    }
+
+    QmsCellGrid(int columnCount, int rowCount) :
+            m_numberOfColumns{columnCount},
+            m_numberOfRows{rowCount},
+            m_chunks{std::make_shared<ChunkDirectory>(chunkCountFor(columnCount * rowCount))} {
+
+    }
+
+    QmsCellGrid(const QmsCellGrid &rhs) = default;
+    QmsCellGrid(QmsCellGrid &&rhs) noexcept = default;
+    QmsCellGrid &operator=(const QmsCellGrid &rhs) = default;
+    QmsCellGrid &operator=(QmsCellGrid &&rhs) noexcept = default;
+    ~QmsCellGrid() = default;
+
+    inline int numberOfColumns() const {
+        return this->m_numberOfColumns;
+    }
+
+    inline int numberOfRows() const {
+        return this->m_numberOfRows;
+    }
+
+    inline int size() const {
+        return this->m_numberOfColumns * this->m_numberOfRows;
+    }
+
+    inline int indexOf(int columnIndex, int rowIndex) const {
+        return (rowIndex * this->m_numberOfColumns) + columnIndex;
+    }
+
+    inline bool inBounds(int columnIndex, int rowIndex) const {
+        return ((columnIndex >= 0) && (columnIndex < this->m_numberOfColumns) &&
+                (rowIndex >= 0) && (rowIndex < this->m_numberOfRows));
+    }
+
+    inline QmsCellState at(int cellIndex) const {
+        const auto &chunk = (*this->m_chunks)[static_cast<size_t>(cellIndex) / CHUNK_SIZE];
+        return (chunk ? (*chunk)[static_cast<size_t>(cellIndex) % CHUNK_SIZE] : QmsCellState{});
+    }
+
+    inline QmsCellState at(int columnIndex, int rowIndex) const {
+        return this->at(this->indexOf(columnIndex, rowIndex));
+    }
+
+    inline void set(int cellIndex, QmsCellState cellState) {
+        if (this->at(cellIndex) == cellState) {
+            return;
+        }
+        this->writableChunk(static_cast<size_t>(cellIndex) / CHUNK_SIZE)[static_cast<size_t>(cellIndex) % CHUNK_SIZE] = cellState;
+    }
+
+    inline void set(int columnIndex, int rowIndex, QmsCellState cellState) {
+        this->set(this->indexOf(columnIndex, rowIndex), cellState);
+    }
+
+    /* reset() : Every cell goes back to its default state, without touching
+     * any chunk that another snapshot may still be reading */
+    inline void reset() {
+        this->m_chunks = std::make_shared<ChunkDirectory>(this->m_chunks->size());
+    }
+
+    /* sharesStorageWith() : True if no cell has been written to in
+     * either grid since one was copied from the other */
+    inline bool sharesStorageWith(const QmsCellGrid &other) const {
+        return this->m_chunks == other.m_chunks;
+    }
+
+    static const size_t constexpr CHUNK_SIZE{256};
+
+private:
+    using Chunk = std::array<QmsCellState, CHUNK_SIZE>;
+    using ChunkDirectory = std::vector<std::shared_ptr<Chunk>>;
+
+    int m_numberOfColumns;
+    int m_numberOfRows;
+    std::shared_ptr<ChunkDirectory> m_chunks;
+
+    static inline size_t chunkCountFor(int cellCount) {
+        return (cellCount <= 0) ? 0 : ((static_cast<size_t>(cellCount) + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    }
+
+    Chunk &writableChunk(size_t chunkIndex) {
+        if (this->m_chunks.use_count() != 1) {
+            this->m_chunks = std::make_shared<ChunkDirectory>(*this->m_chunks);
+        }
+        auto &chunk = (*this->m_chunks)[chunkIndex];
+        if (!chunk) {
+            chunk = std::make_shared<Chunk>();
+        } else if (chunk.use_count() != 1) {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        return *chunk;
+    }
+};
+
+#endif //QMINESWEEPER_QMSCELLGRID_HPP
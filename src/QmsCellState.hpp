@@ -0,0 +1,110 @@
+#ifndef QMINESWEEPER_QMSCELLSTATE_HPP
+#define QMINESWEEPER_QMSCELLSTATE_HPP
+
+#include <cstdint>
+
+/* CellVisibility : What the player can currently see on a single cell.
+ * Covered is the default state of every cell on a fresh board */
+enum class CellVisibility : uint8_t {
+    Covered = 0,
+    Flagged = 1,
+    QuestionMarked = 2,
+    Revealed = 3
+};
+
+/* QmsCellState : Everything the game logic knows about a single cell, packed into one byte
+ * so whole boards can be stored, copied and diffed cheaply. A default constructed
+ * QmsCellState (all bits zero) is a covered cell with no mine and no neighbors */
+class QmsCellState {
+public:
+    constexpr QmsCellState() :
+            m_bits{0} {
+
+    }
+
+    constexpr explicit QmsCellState(uint8_t bits) :
+            m_bits{bits} {
+
+    }
+
+    inline uint8_t bits() const {
+        return this->m_bits;
+    }
+
+    inline int numberOfSurroundingMines() const {
+        return (this->m_bits & SURROUNDING_MINES_MASK);
+    }
+
+    inline bool hasMine() const {
+        return ((this->m_bits & MINE_BIT) != 0);
+    }
+
+    inline bool hasFlag() const {
+        return ((this->m_bits & FLAG_BIT) != 0);
+    }
+
+    inline bool hasQuestionMark() const {
+        return ((this->m_bits & QUESTION_MARK_BIT) != 0);
+    }
+
+    inline bool isRevealed() const {
+        return ((this->m_bits & REVEALED_BIT) != 0);
+    }
+
+    inline CellVisibility visibility() const {
+        if (this->isRevealed()) {
+            return CellVisibility::Revealed;
+        } else if (this->hasFlag()) {
+            return CellVisibility::Flagged;
+        } else if (this->hasQuestionMark()) {
+            return CellVisibility::QuestionMarked;
+        }
+        return CellVisibility::Covered;
+    }
+
+    inline QmsCellState &setNumberOfSurroundingMines(int numberOfSurroundingMines) {
+        this->m_bits = static_cast<uint8_t>((this->m_bits & ~SURROUNDING_MINES_MASK) |
+                                            (numberOfSurroundingMines & SURROUNDING_MINES_MASK));
+        return *this;
+    }
+
+    inline QmsCellState &setHasMine(bool hasMine) {
+        return this->setBit(MINE_BIT, hasMine);
+    }
+
+    inline QmsCellState &setHasFlag(bool hasFlag) {
+        return this->setBit(FLAG_BIT, hasFlag);
+    }
+
+    inline QmsCellState &setHasQuestionMark(bool hasQuestionMark) {
+        return this->setBit(QUESTION_MARK_BIT, hasQuestionMark);
+    }
+
+    inline QmsCellState &setIsRevealed(bool isRevealed) {
+        return this->setBit(REVEALED_BIT, isRevealed);
+    }
+
+    inline bool operator==(const QmsCellState &rhs) const {
+        return this->m_bits == rhs.m_bits;
+    }
+
+    inline bool operator!=(const QmsCellState &rhs) const {
+        return this->m_bits != rhs.m_bits;
+    }
+
+private:
+    uint8_t m_bits;
+
+    inline QmsCellState &setBit(uint8_t bit, bool value) {
+        this->m_bits = static_cast<uint8_t>(value ? (this->m_bits | bit) : (this->m_bits & ~bit));
+        return *this;
+    }
+
+    static const uint8_t constexpr SURROUNDING_MINES_MASK{0x0F};
+    static const uint8_t constexpr MINE_BIT{0x10};
+    static const uint8_t constexpr FLAG_BIT{0x20};
+    static const uint8_t constexpr QUESTION_MARK_BIT{0x40};
+    static const uint8_t constexpr REVEALED_BIT{0x80};
+};
+
+#endif //QMINESWEEPER_QMSCELLSTATE_HPP
@@ -0,0 +1,214 @@
+#include "QmsEventLoopWatchdog.hpp"
+#include "QmsLatencyHistogram.hpp"
+#include "QmsFlightRecorder.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QCoreApplication>
+#include <QThread>
+
+QmsEventLoopWatchdog *eventLoopWatchdog{nullptr};
+
+const int QmsEventLoopWatchdog::s_PING_INTERVAL{50};
+const int QmsEventLoopWatchdog::s_DEFAULT_STALL_THRESHOLD{250};
+const int QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH;
+std::array<std::atomic<const char *>, QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH> QmsEventLoopWatchdog::s_contexts{};
+std::atomic<int> QmsEventLoopWatchdog::s_contextDepth{0};
+
+QmsEventLoopWatchdog::QmsEventLoopWatchdog(int stallThresholdMilliseconds) :
+        QObject{nullptr},
+        m_stallThreshold{stallThresholdMilliseconds},
+        m_pingSentTime{},
+        m_pingPending{false},
+        m_stallReported{false},
+        m_stopping{false},
+        m_stallCount{0},
+        m_pingMutex{},
+        m_pingCondition{},
+        m_thread{} {
+    this->m_thread = std::thread{&QmsEventLoopWatchdog::run, this};
+}
+
+QmsEventLoopWatchdog::~QmsEventLoopWatchdog() {
+    {
+        std::lock_guard<std::mutex> pingLock{this->m_pingMutex};
+        this->m_stopping = true;
+    }
+    this->m_pingCondition.notify_one();
+    if (this->m_thread.joinable()) {
+        this->m_thread.join();
+    }
+}
+
+/* initializeInstance() : Must be called on the GUI thread, which the watchdog then pings */
+void QmsEventLoopWatchdog::initializeInstance(int stallThresholdMilliseconds) {
+    if ((eventLoopWatchdog == nullptr) && (stallThresholdMilliseconds > 0)) {
+        eventLoopWatchdog = new QmsEventLoopWatchdog{stallThresholdMilliseconds};
+    }
+}
+
+void QmsEventLoopWatchdog::shutdownInstance() {
+    QmsEventLoopWatchdog *watchdog{eventLoopWatchdog};
+    if (watchdog == nullptr) {
+        return;
+    }
+    eventLoopWatchdog = nullptr;
+    watchdog->logSummary();
+    delete watchdog;
+}
+
+/* isGuiThread() : Whether the calling thread is the one the QCoreApplication lives on, the only
+ * one that may enter contexts. Worked out once per thread, as soon as the application exists */
+bool QmsEventLoopWatchdog::isGuiThread() {
+    static thread_local int isGuiThread{-1};
+    if (isGuiThread == -1) {
+        QCoreApplication *application{QCoreApplication::instance()};
+        if (application == nullptr) {
+            return false;
+        }
+        isGuiThread = (QThread::currentThread() == application->thread()) ? 1 : 0;
+    }
+    return (isGuiThread == 1);
+}
+
+/* enterContext() : Contexts nested deeper than MAXIMUM_CONTEXT_DEPTH are counted but not
+ * named. The depth is only published once the context is stored, so the watchdog thread
+ * never reads a slot that has not been written yet */
+void QmsEventLoopWatchdog::enterContext(const char *context) {
+    const int depth{QmsEventLoopWatchdog::s_contextDepth.load(std::memory_order_relaxed)};
+    if (depth < QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH) {
+        QmsEventLoopWatchdog::s_contexts[static_cast<size_t>(depth)].store(context, std::memory_order_relaxed);
+    }
+    QmsEventLoopWatchdog::s_contextDepth.store(depth + 1, std::memory_order_release);
+}
+
+void QmsEventLoopWatchdog::leaveContext() {
+    QmsEventLoopWatchdog::s_contextDepth.store(QmsEventLoopWatchdog::s_contextDepth.load(std::memory_order_relaxed) - 1,
+                                               std::memory_order_release);
+}
+
+/* currentContext() : The contexts the GUI thread is inside of, outermost first */
+std::string QmsEventLoopWatchdog::currentContext() {
+    const int depth{QmsEventLoopWatchdog::s_contextDepth.load(std::memory_order_acquire)};
+    if (depth <= 0) {
+        return "no named handler";
+    }
+    std::string context{};
+    for (int contextIndex = 0; (contextIndex < depth) && (contextIndex < QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH); contextIndex++) {
+        if (!context.empty()) {
+            context += " > ";
+        }
+        const char *name{QmsEventLoopWatchdog::s_contexts[static_cast<size_t>(contextIndex)].load(std::memory_order_relaxed)};
+        context += (name ? name : "?");
+    }
+    if (depth > QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH) {
+        context += " > ...";
+    }
+    return context;
+}
+
+/* contextDepth() : How many contexts the GUI thread is inside of, which may be more than
+ * MAXIMUM_CONTEXT_DEPTH(). With contextAt(), safe to call from a signal handler */
+int QmsEventLoopWatchdog::contextDepth() {
+    return QmsEventLoopWatchdog::s_contextDepth.load(std::memory_order_acquire);
+}
+
+const char *QmsEventLoopWatchdog::contextAt(int contextIndex) {
+    if ((contextIndex < 0) || (contextIndex >= QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH)) {
+        return nullptr;
+    }
+    return QmsEventLoopWatchdog::s_contexts[static_cast<size_t>(contextIndex)].load(std::memory_order_relaxed);
+}
+
+bool QmsEventLoopWatchdog::event(QEvent *event) {
+    if (event->type() == QmsEventLoopWatchdog::pingEventType()) {
+        this->onPingReceived();
+        return true;
+    }
+    return QObject::event(event);
+}
+
+/* run() : Only one ping is in flight at a time. While it is, the thread wakes up every ping
+ * interval, and the first time it finds the ping older than the threshold it reports the stall.
+ * The warning is logged with the lock released, so that the GUI thread, coming back from the
+ * stall, does not wait in onPingReceived() for the message to be formatted and queued */
+void QmsEventLoopWatchdog::run() {
+    const std::chrono::milliseconds pingInterval{QmsEventLoopWatchdog::s_PING_INTERVAL};
+    std::unique_lock<std::mutex> pingLock{this->m_pingMutex};
+    while (!this->m_stopping) {
+        this->m_pingSentTime = std::chrono::steady_clock::now();
+        this->m_pingPending = true;
+        this->m_stallReported = false;
+        QCoreApplication::postEvent(this, new QEvent{QmsEventLoopWatchdog::pingEventType()});
+        while ((this->m_pingPending) && (!this->m_stopping)) {
+            this->m_pingCondition.wait_for(pingLock, pingInterval);
+            const auto waited = std::chrono::steady_clock::now() - this->m_pingSentTime;
+            if ((this->m_pingPending) && (!this->m_stallReported) && (waited >= this->m_stallThreshold)) {
+                this->m_stallReported = true;
+                this->m_stallCount++;
+                pingLock.unlock();
+                const std::string context{QmsEventLoopWatchdog::currentContext()};
+                const auto waitedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(waited).count();
+                LOG_WARNING() << QString{"The GUI thread has not returned to the event loop for %1 ms, while in %2"}.arg(
+                        QS_NUMBER(static_cast<qint64>(waitedMilliseconds)), QString::fromStdString(context));
+                pingLock.lock();
+            }
+        }
+        if (!this->m_stopping) {
+            this->m_pingCondition.wait_for(pingLock, pingInterval, [this]() { return this->m_stopping; });
+        }
+    }
+}
+
+void QmsEventLoopWatchdog::onPingReceived() {
+    const auto receivedTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration lag{};
+    bool stallReported{false};
+    {
+        std::lock_guard<std::mutex> pingLock{this->m_pingMutex};
+        lag = receivedTime - this->m_pingSentTime;
+        stallReported = this->m_stallReported;
+        this->m_pingPending = false;
+    }
+    this->m_pingCondition.notify_one();
+    QmsEventLoopWatchdog::lagHistogram().record(lag);
+    if (stallReported) {
+        QmsFlightRecorder::record("GUI thread stall", -1, -1, receivedTime - lag, receivedTime);
+        LOG_WARNING() << QString{"The GUI thread was stalled for %1 ms"}.arg(
+                QS_NUMBER(static_cast<qint64>(std::chrono::duration_cast<std::chrono::milliseconds>(lag).count())));
+    }
+}
+
+void QmsEventLoopWatchdog::logSummary() {
+    const QmsLatencyHistogram &histogram = QmsEventLoopWatchdog::lagHistogram();
+    uint64_t stallCount{0};
+    {
+        std::lock_guard<std::mutex> pingLock{this->m_pingMutex};
+        stallCount = this->m_stallCount;
+    }
+    LOG_INFO() << QString{"Event loop lag over %1 pings: p50 %2 us, p90 %3 us, p99 %4 us, max %5 us, %6 stalls over %7 ms"}.arg(
+            QS_NUMBER(histogram.count()), QS_NUMBER(histogram.percentile(0.50)), QS_NUMBER(histogram.percentile(0.90)),
+            QS_NUMBER(histogram.percentile(0.99)), QS_NUMBER(histogram.maximum()), QS_NUMBER(stallCount),
+            QS_NUMBER(static_cast<qint64>(this->m_stallThreshold.count())));
+}
+
+QEvent::Type QmsEventLoopWatchdog::pingEventType() {
+    static const auto eventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+    return eventType;
+}
+
+QmsLatencyHistogram &QmsEventLoopWatchdog::lagHistogram() {
+    static QmsLatencyHistogram histogram{"Event loop lag"};
+    return histogram;
+}
+
+int QmsEventLoopWatchdog::PING_INTERVAL() {
+    return QmsEventLoopWatchdog::s_PING_INTERVAL;
+}
+
+int QmsEventLoopWatchdog::DEFAULT_STALL_THRESHOLD() {
+    return QmsEventLoopWatchdog::s_DEFAULT_STALL_THRESHOLD;
+}
+
+int QmsEventLoopWatchdog::MAXIMUM_CONTEXT_DEPTH() {
+    return QmsEventLoopWatchdog::s_MAXIMUM_CONTEXT_DEPTH;
+}
@@ -0,0 +1,77 @@
+#ifndef QMINESWEEPER_QMSEVENTLOOPWATCHDOG_HPP
+#define QMINESWEEPER_QMSEVENTLOOPWATCHDOG_HPP
+
+#include <QObject>
+#include <QEvent>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class QmsLatencyHistogram;
+
+/* QmsEventLoopWatchdog : A thread that posts a ping to the GUI thread every PING_INTERVAL() and
+ * measures how late the event loop gets to it, into the "Event loop lag" latency histogram (so it
+ * shows on the latency overlay and in metrics snapshots). While a ping goes unanswered for longer
+ * than the stall threshold, the watchdog logs the stall, along with the handlers the GUI thread
+ * is inside of (see QMS_INSTRUMENT_SCOPE()), and the GUI thread logs how long it lasted once it gets
+ * back to the event loop. A summary of the lag is logged at exit */
+class QmsEventLoopWatchdog : public QObject {
+Q_OBJECT
+public:
+    ~QmsEventLoopWatchdog() override;
+    QmsEventLoopWatchdog(const QmsEventLoopWatchdog &rhs) = delete;
+    QmsEventLoopWatchdog &operator=(const QmsEventLoopWatchdog &rhs) = delete;
+
+    static void initializeInstance(int stallThresholdMilliseconds);
+    static void shutdownInstance();
+
+    static bool isGuiThread();
+    static void enterContext(const char *context);
+    static void leaveContext();
+    static std::string currentContext();
+    static int contextDepth();
+    static const char *contextAt(int contextIndex);
+
+    static int PING_INTERVAL();
+    static int DEFAULT_STALL_THRESHOLD();
+    static int MAXIMUM_CONTEXT_DEPTH();
+
+protected:
+    bool event(QEvent *event) override;
+
+private:
+    std::chrono::milliseconds m_stallThreshold;
+    std::chrono::steady_clock::time_point m_pingSentTime;
+    bool m_pingPending;
+    bool m_stallReported;
+    bool m_stopping;
+    uint64_t m_stallCount;
+    std::mutex m_pingMutex;
+    std::condition_variable m_pingCondition;
+    std::thread m_thread;
+
+    explicit QmsEventLoopWatchdog(int stallThresholdMilliseconds);
+
+    void run();
+    void onPingReceived();
+    void logSummary();
+
+    static QEvent::Type pingEventType();
+    static QmsLatencyHistogram &lagHistogram();
+
+    static const int s_PING_INTERVAL;
+    static const int s_DEFAULT_STALL_THRESHOLD;
+    static const int s_MAXIMUM_CONTEXT_DEPTH{8};
+    static std::array<std::atomic<const char *>, s_MAXIMUM_CONTEXT_DEPTH> s_contexts;
+    static std::atomic<int> s_contextDepth;
+};
+
+extern QmsEventLoopWatchdog *eventLoopWatchdog;
+
+#endif //QMINESWEEPER_QMSEVENTLOOPWATCHDOG_HPP
@@ -0,0 +1,133 @@
+#include "QmsFlightRecorder.hpp"
+#include "QmsEventLoopWatchdog.hpp"
+#include "QmsFormat.hpp"
+
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+std::array<QmsFlightRecorder::Slot, QmsFlightRecorder::s_EVENT_COUNT> QmsFlightRecorder::s_slots{};
+std::atomic<uint64_t> QmsFlightRecorder::s_nextSequence{0};
+std::chrono::steady_clock::time_point QmsFlightRecorder::s_startTime{std::chrono::steady_clock::now()};
+char QmsFlightRecorder::s_dumpFilePath[QmsFlightRecorder::s_MAXIMUM_PATH_LENGTH]{};
+const size_t QmsFlightRecorder::s_EVENT_COUNT;
+const size_t QmsFlightRecorder::s_MAXIMUM_PATH_LENGTH;
+
+/* initializeInstance() : The path is encoded ahead of time, as nothing
+ * that could allocate may run once the signal handler has been entered */
+void QmsFlightRecorder::initializeInstance(const QString &dumpFilePath) {
+    const QByteArray encodedPath{QFile::encodeName(dumpFilePath)};
+    if (static_cast<size_t>(encodedPath.size()) < QmsFlightRecorder::s_MAXIMUM_PATH_LENGTH) {
+        std::memcpy(QmsFlightRecorder::s_dumpFilePath, encodedPath.constData(), static_cast<size_t>(encodedPath.size()) + 1);
+    }
+}
+
+/* record() : A slot's sequence is cleared while it is being filled in, and set to one past the
+ * event's place in the ring afterwards, so dump() can tell a finished event from one that is being
+ * written (or was overwritten) while it read it */
+void QmsFlightRecorder::record(const char *kind, int columnIndex, int rowIndex,
+                               std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    const uint64_t sequence{QmsFlightRecorder::s_nextSequence.fetch_add(1, std::memory_order_relaxed)};
+    Slot &slot = QmsFlightRecorder::s_slots[static_cast<size_t>(sequence % QmsFlightRecorder::s_EVENT_COUNT)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(std::chrono::duration_cast<std::chrono::nanoseconds>(begin - QmsFlightRecorder::s_startTime).count(), std::memory_order_relaxed);
+    slot.duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(), std::memory_order_relaxed);
+    slot.kind.store(kind, std::memory_order_relaxed);
+    slot.columnIndex.store(columnIndex, std::memory_order_relaxed);
+    slot.rowIndex.store(rowIndex, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_release);
+}
+
+void QmsFlightRecorder::record(const char *kind, int columnIndex, int rowIndex) {
+    const auto now = std::chrono::steady_clock::now();
+    QmsFlightRecorder::record(kind, columnIndex, rowIndex, now, now);
+}
+
+/* dump() : Writes the events still in the ring, oldest first, followed by the handlers the GUI
+ * thread was inside of (see QMS_INSTRUMENT_SCOPE()), which for a hang is where it was stuck */
+void QmsFlightRecorder::dump(int signalNumber) {
+    if (QmsFlightRecorder::s_dumpFilePath[0] == '\0') {
+        return;
+    }
+#if defined(_WIN32)
+    const int dumpFile{_open(QmsFlightRecorder::s_dumpFilePath, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE)};
+#else
+    const int dumpFile{open(QmsFlightRecorder::s_dumpFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+#endif
+    if (dumpFile < 0) {
+        return;
+    }
+    const auto writeLine = [dumpFile](const QmsFormatBuffer<256> &line) {
+#if defined(_WIN32)
+        int written{_write(dumpFile, line.data(), static_cast<unsigned int>(line.length()))};
+#else
+        ssize_t written{write(dumpFile, line.data(), line.length())};
+#endif
+        (void)written;
+    };
+    const uint64_t endSequence{QmsFlightRecorder::s_nextSequence.load(std::memory_order_acquire)};
+    const uint64_t beginSequence{(endSequence > QmsFlightRecorder::s_EVENT_COUNT) ? (endSequence - QmsFlightRecorder::s_EVENT_COUNT) : 0};
+    QmsFormatBuffer<256> line{};
+    line.append("Flight recorder dump on signal ").appendInteger(signalNumber).append(", ")
+        .appendInteger(static_cast<long long>(endSequence - beginSequence)).append(" of ")
+        .appendInteger(static_cast<long long>(endSequence)).append(" events (seconds since start, kind, cell, duration)\n");
+    writeLine(line);
+    for (uint64_t sequence = beginSequence; sequence < endSequence; sequence++) {
+        const Slot &slot = QmsFlightRecorder::s_slots[static_cast<size_t>(sequence % QmsFlightRecorder::s_EVENT_COUNT)];
+        if (slot.sequence.load(std::memory_order_acquire) != sequence + 1) {
+            continue;
+        }
+        const int64_t timestamp{slot.timestamp.load(std::memory_order_relaxed)};
+        const int64_t duration{slot.duration.load(std::memory_order_relaxed)};
+        const char *kind{slot.kind.load(std::memory_order_relaxed)};
+        const int32_t columnIndex{slot.columnIndex.load(std::memory_order_relaxed)};
+        const int32_t rowIndex{slot.rowIndex.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence + 1) {
+            continue;
+        }
+        line.truncate(0);
+        line.appendInteger(timestamp / 1000000000).append('.').appendInteger((timestamp % 1000000000) / 1000, 6)
+            .append(' ').append(kind ? kind : "?");
+        if ((columnIndex >= 0) && (rowIndex >= 0)) {
+            line.append(" (").appendInteger(columnIndex).append(", ").appendInteger(rowIndex).append(')');
+        }
+        if (duration >= 1000) {
+            line.append(' ').appendInteger(duration / 1000).append(" us");
+        }
+        line.append('\n');
+        writeLine(line);
+    }
+    line.truncate(0);
+    line.append("GUI thread inside: ");
+    const int contextDepth{std::min(QmsEventLoopWatchdog::contextDepth(), QmsEventLoopWatchdog::MAXIMUM_CONTEXT_DEPTH())};
+    for (int contextIndex = 0; contextIndex < contextDepth; contextIndex++) {
+        const char *context{QmsEventLoopWatchdog::contextAt(contextIndex)};
+        line.append((contextIndex == 0) ? "" : " > ").append(context ? context : "?");
+    }
+    if (contextDepth <= 0) {
+        line.append("no named handler");
+    }
+    line.append('\n');
+    writeLine(line);
+#if defined(_WIN32)
+    _close(dumpFile);
+#else
+    close(dumpFile);
+#endif
+}
+
+size_t QmsFlightRecorder::EVENT_COUNT() {
+    return QmsFlightRecorder::s_EVENT_COUNT;
+}
@@ -0,0 +1,47 @@
+#ifndef QMINESWEEPER_QMSFLIGHTRECORDER_HPP
+#define QMINESWEEPER_QMSFLIGHTRECORDER_HPP
+
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/* QmsFlightRecorder : The last EVENT_COUNT() game and UI events (board input, cascades, saves,
+ * loads, paints, stalls), each with a timestamp, a kind, the cell it concerns and how long it took,
+ * kept in a fixed ring in memory. Recording claims a slot with one atomic increment and fills it in
+ * with relaxed stores, so it is always on, and nothing is written anywhere until dump() is called:
+ * from the signal handler, when the program crashes or is killed (or on SIGUSR2, to look at a hang).
+ * dump() only uses async signal safe calls (open, write, close) and formats into the stack */
+class QmsFlightRecorder {
+public:
+    static void initializeInstance(const QString &dumpFilePath);
+
+    static void record(const char *kind, int columnIndex, int rowIndex,
+                       std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+    static void record(const char *kind, int columnIndex = -1, int rowIndex = -1);
+    static void dump(int signalNumber);
+
+    static size_t EVENT_COUNT();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<int64_t> timestamp;
+        std::atomic<int64_t> duration;
+        std::atomic<const char *> kind;
+        std::atomic<int32_t> columnIndex;
+        std::atomic<int32_t> rowIndex;
+    };
+
+    static const size_t s_EVENT_COUNT{4096};
+    static const size_t s_MAXIMUM_PATH_LENGTH{1024};
+
+    static std::array<Slot, s_EVENT_COUNT> s_slots;
+    static std::atomic<uint64_t> s_nextSequence;
+    static std::chrono::steady_clock::time_point s_startTime;
+    static char s_dumpFilePath[s_MAXIMUM_PATH_LENGTH];
+};
+
+#endif //QMINESWEEPER_QMSFLIGHTRECORDER_HPP
@@ -0,0 +1,103 @@
+#ifndef QMINESWEEPER_QMSFORMAT_HPP
+#define QMINESWEEPER_QMSFORMAT_HPP
+
+#include <QString>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace QmsFormat {
+
+    /* INTEGER_CHARACTER_COUNT : Enough for any long long, sign included */
+    static const size_t constexpr INTEGER_CHARACTER_COUNT{20};
+
+    /* integerToChars() : Writes value in decimal to [first, last), zero padded to at least
+     * minimumWidth digits, the way std::to_chars() would (which is C++17). Returns the end of
+     * what was written, or nullptr (and writes nothing) when the range is too small */
+    inline char *integerToChars(char *first, char *last, long long value, int minimumWidth = 0) {
+        char digits[INTEGER_CHARACTER_COUNT];
+        char *digit{digits + INTEGER_CHARACTER_COUNT};
+        auto magnitude = (value < 0) ? (0ULL - static_cast<unsigned long long>(value)) : static_cast<unsigned long long>(value);
+        do {
+            *--digit = static_cast<char>('0' + (magnitude % 10));
+            magnitude /= 10;
+        } while (magnitude != 0);
+        const auto digitCount = static_cast<size_t>((digits + INTEGER_CHARACTER_COUNT) - digit);
+        const size_t paddingCount{(minimumWidth > 0) && (static_cast<size_t>(minimumWidth) > digitCount) ?
+                                  static_cast<size_t>(minimumWidth) - digitCount : 0};
+        const size_t totalCount{(value < 0 ? 1 : 0) + paddingCount + digitCount};
+        if (static_cast<size_t>(last - first) < totalCount) {
+            return nullptr;
+        }
+        if (value < 0) {
+            *first++ = '-';
+        }
+        std::memset(first, '0', paddingCount);
+        std::memcpy(first + paddingCount, digit, digitCount);
+        return first + paddingCount + digitCount;
+    }
+}
+
+/* QmsFormatBuffer : Short text (coordinates, times) built up in a fixed array, so usually on the
+ * stack. Nothing is allocated until the text is copied out, and for text this short a std::string
+ * keeps it inline anyway. Text that does not fit in Capacity characters is cut off */
+template<size_t Capacity>
+class QmsFormatBuffer {
+public:
+    QmsFormatBuffer() :
+            m_length{0},
+            m_buffer{} {
+
+    }
+
+    QmsFormatBuffer &append(char character) {
+        if (this->m_length < Capacity) {
+            this->m_buffer[this->m_length++] = character;
+        }
+        return *this;
+    }
+
+    QmsFormatBuffer &append(const char *text) {
+        const size_t length{std::min(std::strlen(text), Capacity - this->m_length)};
+        std::memcpy(this->m_buffer + this->m_length, text, length);
+        this->m_length += length;
+        return *this;
+    }
+
+    QmsFormatBuffer &appendInteger(long long value, int minimumWidth = 0) {
+        char *end{QmsFormat::integerToChars(this->m_buffer + this->m_length, this->m_buffer + Capacity, value, minimumWidth)};
+        if (end) {
+            this->m_length = static_cast<size_t>(end - this->m_buffer);
+        }
+        return *this;
+    }
+
+    QmsFormatBuffer &truncate(size_t length) {
+        this->m_length = std::min(this->m_length, length);
+        return *this;
+    }
+
+    const char *data() const {
+        return this->m_buffer;
+    }
+
+    size_t length() const {
+        return this->m_length;
+    }
+
+    std::string toStdString() const {
+        return std::string(this->m_buffer, this->m_length);
+    }
+
+    QString toQString() const {
+        return QString::fromLatin1(this->m_buffer, static_cast<int>(this->m_length));
+    }
+
+private:
+    size_t m_length;
+    char m_buffer[Capacity];
+};
+
+#endif //QMINESWEEPER_QMSFORMAT_HPP
@@ -1,8 +1,10 @@
 #include "QmsGameState.hpp"
 #include "QmsStrings.hpp"
 #include "GlobalDefinitions.hpp"
-#include "QmsButton.hpp"
+#include "MineCoordinates.hpp"
 #include "QmsUtilities.hpp"
+#include "QmsInstrumentation.hpp"
+#include "QmsMetrics.hpp"
 
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
@@ -20,6 +22,8 @@ QmsGameState::QmsGameState() :
 
 QmsGameState::QmsGameState(int columnCount, int rowCount) :
         m_playTimer{},
+        m_mineCoordinates{},
+        m_cells{columnCount, rowCount},
         m_numberOfMines{0},
         m_userDisplayNumberOfMines{0},
         m_initialClickFlag{true},
@@ -31,7 +35,10 @@ QmsGameState::QmsGameState(int columnCount, int rowCount) :
         m_totalButtonCount{this->m_numberOfColumns * this->m_numberOfRows},
         m_unopenedMineCount{this->m_numberOfColumns * this->m_numberOfRows},
         m_customMineRatio{nullptr},
-        m_filePath{""} {
+        m_filePath{""},
+        m_stateHash{},
+        m_savedStateHash{0},
+        m_undoLog{} {
     using namespace QmsUtilities;
     this->m_numberOfMines = ((this->m_numberOfColumns * this->m_numberOfRows) < this->CELL_TO_MINE_THRESHOLD) ?
                             roundIntuitively(
@@ -41,125 +48,27 @@ QmsGameState::QmsGameState(int columnCount, int rowCount) :
     this->m_userDisplayNumberOfMines = this->m_numberOfMines;
 }
 
-QmsGameState::QmsGameState(const QmsGameState &rhs) :
-        m_playTimer{rhs.m_playTimer},
-        m_numberOfMines{rhs.m_numberOfMines},
-        m_userDisplayNumberOfMines{rhs.m_userDisplayNumberOfMines},
-        m_initialClickFlag{rhs.m_initialClickFlag},
-        m_numberOfColumns{rhs.m_numberOfColumns},
-        m_numberOfRows{rhs.m_numberOfRows},
-        m_numberOfMovesMade{rhs.m_numberOfMovesMade},
-        m_gameState{rhs.m_gameState},
-        m_gameOver{rhs.m_gameOver},
-        m_totalButtonCount{rhs.m_totalButtonCount},
-        m_unopenedMineCount{rhs.m_unopenedMineCount},
-        m_customMineRatio{nullptr},
-        m_filePath{rhs.m_filePath} {
-    if (rhs.m_customMineRatio) {
-        this->m_customMineRatio.reset(new float{*rhs.m_customMineRatio});
-    }
-    this->m_mineCoordinates.clear();
-    for (const auto &it : rhs.m_mineCoordinates) {
-        this->m_mineCoordinates.emplace(it);
-    }
-
-    this->m_mineSweeperButtons.clear();
-    for (const auto &it : rhs.m_mineSweeperButtons) {
-        this->m_mineSweeperButtons.emplace(it);
-    }
-
-}
-
-QmsGameState::QmsGameState(QmsGameState &&rhs) noexcept :
-        m_playTimer{std::move(rhs.m_playTimer)},
-        m_numberOfMines{rhs.m_numberOfMines},
-        m_userDisplayNumberOfMines{rhs.m_userDisplayNumberOfMines},
-        m_initialClickFlag{rhs.m_initialClickFlag},
-        m_numberOfColumns{rhs.m_numberOfColumns},
-        m_numberOfRows{rhs.m_numberOfRows},
-        m_numberOfMovesMade{rhs.m_numberOfMovesMade},
-        m_gameState{rhs.m_gameState},
-        m_gameOver{rhs.m_gameOver},
-        m_totalButtonCount{rhs.m_totalButtonCount},
-        m_unopenedMineCount{rhs.m_unopenedMineCount},
-        m_customMineRatio{std::move(rhs.m_customMineRatio)},
-        m_filePath{rhs.m_filePath} {
-    this->m_mineCoordinates.clear();
-    for (const auto &it : rhs.m_mineCoordinates) {
-        this->m_mineCoordinates.emplace(it);
-    }
-
-    this->m_mineSweeperButtons.clear();
-    for (const auto &it : rhs.m_mineSweeperButtons) {
-        this->m_mineSweeperButtons.emplace(it);
-    }
-
-}
-
 QString QmsGameState::filePath() const {
     return this->m_filePath;
 }
 
-QmsGameState &QmsGameState::operator=(const QmsGameState &rhs) {
-    this->m_mineCoordinates.clear();
-    for (const auto &it : rhs.m_mineCoordinates) {
-        this->m_mineCoordinates.emplace(it);
-    }
-
-    this->m_mineSweeperButtons.clear();
-    for (const auto &it : rhs.m_mineSweeperButtons) {
-        this->m_mineSweeperButtons.emplace(it);
-    }
-
-    this->m_playTimer = rhs.m_playTimer;
-    this->m_numberOfMines = rhs.m_numberOfMines;
-    this->m_userDisplayNumberOfMines = rhs.m_userDisplayNumberOfMines;
-    this->m_initialClickFlag = rhs.m_initialClickFlag;
-    this->m_numberOfColumns = rhs.m_numberOfColumns;
-    this->m_numberOfRows = rhs.m_numberOfRows;
-    this->m_gameState = rhs.m_gameState;
-    this->m_gameOver = rhs.m_gameOver;
-    this->m_totalButtonCount = rhs.m_totalButtonCount;
-    this->m_unopenedMineCount = rhs.m_unopenedMineCount;
-    if (rhs.m_customMineRatio) {
-        this->m_customMineRatio.reset(new float{*rhs.m_customMineRatio});
-    }
-    this->m_filePath = rhs.m_filePath;
-    return *this;
+int QmsGameState::numberOfColumns() const {
+    return this->m_numberOfColumns;
 }
 
-QmsGameState &QmsGameState::operator=(QmsGameState &&rhs) {
-    this->m_mineCoordinates.clear();
-    for (const auto &it : rhs.m_mineCoordinates) {
-        this->m_mineCoordinates.emplace(it);
-    }
-
-    this->m_mineSweeperButtons.clear();
-    for (const auto &it : rhs.m_mineSweeperButtons) {
-        this->m_mineSweeperButtons.emplace(it);
-    }
-
-    this->m_playTimer = rhs.m_playTimer;
-    this->m_numberOfMines = rhs.m_numberOfMines;
-    this->m_userDisplayNumberOfMines = rhs.m_userDisplayNumberOfMines;
-    this->m_initialClickFlag = rhs.m_initialClickFlag;
-    this->m_numberOfColumns = rhs.m_numberOfColumns;
-    this->m_numberOfRows = rhs.m_numberOfRows;
-    this->m_gameState = rhs.m_gameState;
-    this->m_gameOver = rhs.m_gameOver;
-    this->m_totalButtonCount = rhs.m_totalButtonCount;
-    this->m_unopenedMineCount = rhs.m_unopenedMineCount;
-    this->m_customMineRatio = std::move(rhs.m_customMineRatio);
-    this->m_filePath = rhs.m_filePath;
+int QmsGameState::numberOfRows() const {
+    return this->m_numberOfRows;
+}
 
-    return *this;
+const QmsCellGrid &QmsGameState::cells() const {
+    return this->m_cells;
 }
 
 std::pair<LoadGameStateResult, std::string> QmsGameState::loadGameInPlace(const QString &filePath) {
     QmsGameState loadedState;
     const auto result = QmsGameState::loadFromFile(filePath, loadedState);
     if (result.first == LoadGameStateResult::Success) {
-        *this = loadedState;
+        *this = std::move(loadedState);
     }
     return result;
 }
@@ -167,6 +76,7 @@ std::pair<LoadGameStateResult, std::string> QmsGameState::loadGameInPlace(const
 std::pair<LoadGameStateResult, std::string> QmsGameState::loadFromFile(const QString &filePath,
                                                                        QmsGameState &targetState) {
     Q_UNUSED(targetState);
+    QMS_INSTRUMENT_SCOPE("Read game state");
     using namespace QmsUtilities;
     QFile inputFile{filePath};
     QXmlStreamReader reader{};
@@ -194,6 +104,7 @@ std::pair<LoadGameStateResult, std::string> QmsGameState::loadFromFile(const QSt
     reader.setDevice(&inputFile);
     inputFile.seek(0);
     targetState.m_filePath = filePath;
+    std::list<std::pair<MineCoordinates, QmsCellState>> cellList{};
 
     while (!reader.atEnd() && !reader.hasError()) {
         reader.readNext();
@@ -219,13 +130,10 @@ std::pair<LoadGameStateResult, std::string> QmsGameState::loadFromFile(const QSt
         } else if (reader.name() == MINE_COORDINATE_LIST_XML_KEY) {
             auto coordinateList = readMineCoordinateListFromXmlFile(reader);
             for (const auto &it : coordinateList) {
-                targetState.m_mineCoordinates.insert(it);
+                targetState.m_mineCoordinates.write().insert(it);
             }
         } else if (reader.name() == QMS_BUTTON_LIST_START_ELEMENT_XML_KEY) {
-            auto buttonList = readQmsButtonListFromXmlFile(reader);
-            for (const auto &it : buttonList) {
-                targetState.m_mineSweeperButtons.insert(it);
-            }
+            cellList = readQmsButtonListFromXmlFile(reader);
         }
         //LOG_DEBUG() << QString{"element name: %1, text: %2"}.arg(reader.name().toString(), reader.readElementText(QXmlStreamReader::ReadElementTextBehaviour::IncludeChildElements));
     }
@@ -234,8 +142,29 @@ std::pair<LoadGameStateResult, std::string> QmsGameState::loadFromFile(const QSt
         inputFile.close();
         return std::make_pair(LoadGameStateResult::XmlParseFailed, QString{"Parsing XML file failed with the following error: \"%1\""}.arg(reader.errorString()).toStdString());
     }
+    QmsMetrics::gamesLoaded.add();
+    QmsMetrics::bytesLoaded.add(static_cast<uint64_t>(inputFile.size()));
     inputFile.close();
 
+    /* The cells are only placed once the whole file has been read, because the board
+     * dimensions are not guaranteed to come before the button list. The hash is established
+     * here too, while every cell is being touched by the load anyway. From this point on
+     * it is only ever updated incrementally by GameController */
+    targetState.m_cells = QmsCellGrid{targetState.m_numberOfColumns, targetState.m_numberOfRows};
+    targetState.m_totalButtonCount = targetState.m_cells.size();
+    targetState.m_stateHash.reset();
+    for (const auto &it : cellList) {
+        if (!targetState.m_cells.inBounds(it.first.X(), it.first.Y())) {
+            return std::make_pair(LoadGameStateResult::XmlParseFailed, QString{"Button %1 lies outside of the %2x%3 board"}.arg(it.first.toQString(), QS_NUMBER(targetState.m_numberOfColumns), QS_NUMBER(targetState.m_numberOfRows)).toStdString());
+        }
+        int cellIndex{targetState.m_cells.indexOf(it.first.X(), it.first.Y())};
+        targetState.m_cells.set(cellIndex, it.second);
+        targetState.m_stateHash.toggleCell(cellIndex, it.second.visibility());
+        if (it.second.hasMine()) {
+            targetState.m_stateHash.toggleMine(cellIndex);
+        }
+    }
+    targetState.m_savedStateHash = targetState.m_stateHash.value();
     targetState.m_initialClickFlag = false;
     return std::make_pair(LoadGameStateResult::Success, "");
 }
@@ -257,9 +186,8 @@ std::list<MineCoordinates> QmsGameState::readMineCoordinateListFromXmlFile(QXmlS
     return returnList;
 }
 
-std::list<std::pair<MineCoordinates, std::shared_ptr<QmsButton>>>
-QmsGameState::readQmsButtonListFromXmlFile(QXmlStreamReader &reader) {
-    auto returnList = std::list<std::pair<MineCoordinates, std::shared_ptr<QmsButton>>>{};
+std::list<std::pair<MineCoordinates, QmsCellState>> QmsGameState::readQmsButtonListFromXmlFile(QXmlStreamReader &reader) {
+    auto returnList = std::list<std::pair<MineCoordinates, QmsCellState>>{};
     while (!reader.atEnd() && !reader.hasError()) {
         reader.readNext();
         if (reader.name().isEmpty()) {
@@ -274,10 +202,10 @@ QmsGameState::readQmsButtonListFromXmlFile(QXmlStreamReader &reader) {
     return returnList;
 }
 
-std::pair<MineCoordinates, std::shared_ptr<QmsButton>> QmsGameState::readQmsButtonFromXmlFile(QXmlStreamReader &reader) {
+std::pair<MineCoordinates, QmsCellState> QmsGameState::readQmsButtonFromXmlFile(QXmlStreamReader &reader) {
     using namespace QmsUtilities;
     MineCoordinates coordinates{0, 0};
-    std::shared_ptr<QmsButton> button{std::make_shared<QmsButton>(0, 0, nullptr)};
+    QmsCellState cellState{};
     while (!reader.atEnd() && !reader.hasError()) {
         reader.readNext();
         if (reader.name().isEmpty()) {
@@ -286,26 +214,24 @@ std::pair<MineCoordinates, std::shared_ptr<QmsButton>> QmsGameState::readQmsButt
         QString elementText{reader.readElementText()};
         if (reader.name() == QMS_BUTTON_MINE_COORDINATES_XML_KEY) {
             coordinates = MineCoordinates::parse(elementText.toStdString());
-            button->setCoordinates(coordinates);
         } else if (reader.name() == QMS_BUTTON_IS_BLOCKING_CLICKS_XML_KEY) {
-            button->setBlockClicks(toBool(elementText));
+            //Clicks are blocked by the game being over, not by the cell itself
+            continue;
         } else if (reader.name() == QMS_BUTTON_SURROUNDING_MINE_COUNT_XML_KEY) {
-            button->setNumberOfSurroundingMines(elementText.toInt());
+            cellState.setNumberOfSurroundingMines(elementText.toInt());
         } else if (reader.name() == QMS_BUTTON_IS_CHECKED_XML_KEY) {
-            button->setChecked(toBool(elementText));
+            continue;
         } else if (reader.name() == QMS_BUTTON_HAS_FLAG_XML_KEY) {
-            button->setHasFlag(toBool(elementText));
+            cellState.setHasFlag(toBool(elementText));
         } else if (reader.name() == QMS_BUTTON_HAS_MINE_XML_KEY) {
-            button->setHasMine(toBool(elementText));
+            cellState.setHasMine(toBool(elementText));
         } else if (reader.name() == QMS_BUTTON_IS_REVEALED_XML_KEY) {
-            button->setChecked(toBool(elementText));
-            button->setIsRevealed(toBool(elementText));
+            cellState.setIsRevealed(toBool(elementText));
         } else {
             break;
         }
     }
-    //std::cout << "coordinates = " << coordinates.toString() << ", QmsButton = " << button->toString() << std::endl;
-    return std::make_pair(coordinates, button);
+    return std::make_pair(coordinates, cellState);
 }
 
 SteadyEventTimer QmsGameState::readEventTimerFromXmlFile(QXmlStreamReader &reader) {
@@ -334,6 +260,7 @@ SteadyEventTimer QmsGameState::readEventTimerFromXmlFile(QXmlStreamReader &reade
 }
 
 std::pair<SaveGameStateResult, std::string> QmsGameState::saveToFile(const QString &filePath) {
+    QMS_INSTRUMENT_SCOPE("Write game state");
     this->m_filePath = filePath;
     QFile outputFile{filePath};
     if (outputFile.exists()) {
@@ -363,14 +290,16 @@ std::pair<SaveGameStateResult, std::string> QmsGameState::saveToFile(const QStri
     writeToFile.writeEndElement(); //PlayTime
 
     writeToFile.writeStartElement(MINE_COORDINATE_LIST_XML_KEY);
-    for (auto &it: this->m_mineCoordinates) {
-        writeToFile.writeTextElement(MINE_COORDINATES_XML_KEY, QString{MineCoordinates{it}.toString().c_str()});
+    for (auto &it: this->m_mineCoordinates.read()) {
+        writeToFile.writeTextElement(MINE_COORDINATES_XML_KEY, MineCoordinates{it}.toQString());
     }
     writeToFile.writeEndElement(); //MineCoordinates
 
     writeToFile.writeStartElement(QMS_BUTTON_LIST_START_ELEMENT_XML_KEY);
-    for (auto &it : this->m_mineSweeperButtons) {
-        writeQmsButtonToXmlStream(writeToFile, it.first, it.second);
+    for (int rowIndex = 0; rowIndex < this->m_cells.numberOfRows(); rowIndex++) {
+        for (int columnIndex = 0; columnIndex < this->m_cells.numberOfColumns(); columnIndex++) {
+            writeQmsButtonToXmlStream(writeToFile, MineCoordinates{columnIndex, rowIndex}, this->m_cells.at(columnIndex, rowIndex));
+        }
     }
     writeToFile.writeEndElement(); //MineSweeperButtons
     writeToFile.writeEndElement(); //QmsGameState
@@ -402,22 +331,23 @@ std::pair<SaveGameStateResult, std::string> QmsGameState::saveToFile(const QStri
     hashFile.write(fileHash);
     hashFile.close();
     */
+    QmsMetrics::gamesSaved.add();
+    QmsMetrics::bytesSaved.add(static_cast<uint64_t>(outputFile.size()));
     outputFile.close();
     return std::make_pair(SaveGameStateResult::Success, "");
 }
 
 void QmsGameState::writeQmsButtonToXmlStream(QXmlStreamWriter &writeToFile, const MineCoordinates &coordinates,
-                                             std::shared_ptr<QmsButton> targetButton) {
+                                             QmsCellState cellState) {
     using namespace QmsUtilities;
     writeToFile.writeStartElement(QMS_BUTTON_START_ELEMENT_XML_KEY);
-    writeToFile.writeTextElement(QMS_BUTTON_MINE_COORDINATES_XML_KEY, QString{coordinates.toString().c_str()});
-    writeToFile.writeTextElement(QMS_BUTTON_IS_BLOCKING_CLICKS_XML_KEY,
-                                 boolToQString(targetButton->isBlockingClicks()));
+    writeToFile.writeTextElement(QMS_BUTTON_MINE_COORDINATES_XML_KEY, coordinates.toQString());
+    writeToFile.writeTextElement(QMS_BUTTON_IS_BLOCKING_CLICKS_XML_KEY, boolToQString(this->m_gameOver));
     writeToFile.writeTextElement(QMS_BUTTON_SURROUNDING_MINE_COUNT_XML_KEY,
-                                 QS_NUMBER(targetButton->numberOfSurroundingMines()));
-    writeToFile.writeTextElement(QMS_BUTTON_IS_CHECKED_XML_KEY, boolToQString(targetButton->isChecked()));
-    writeToFile.writeTextElement(QMS_BUTTON_HAS_FLAG_XML_KEY, boolToQString(targetButton->hasFlag()));
-    writeToFile.writeTextElement(QMS_BUTTON_HAS_MINE_XML_KEY, boolToQString(targetButton->hasMine()));
-    writeToFile.writeTextElement(QMS_BUTTON_IS_REVEALED_XML_KEY, boolToQString(targetButton->isRevealed()));
+                                 QS_NUMBER(cellState.numberOfSurroundingMines()));
+    writeToFile.writeTextElement(QMS_BUTTON_IS_CHECKED_XML_KEY, boolToQString(cellState.isRevealed()));
+    writeToFile.writeTextElement(QMS_BUTTON_HAS_FLAG_XML_KEY, boolToQString(cellState.hasFlag()));
+    writeToFile.writeTextElement(QMS_BUTTON_HAS_MINE_XML_KEY, boolToQString(cellState.hasMine()));
+    writeToFile.writeTextElement(QMS_BUTTON_IS_REVEALED_XML_KEY, boolToQString(cellState.isRevealed()));
     writeToFile.writeEndElement(); //QmsButton
 }
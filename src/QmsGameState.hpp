@@ -12,13 +12,15 @@
 #include "MineCoordinateHash.hpp"
 #include "EventTimer.hpp"
 #include "ChangeAwareValue.hpp"
+#include "ZobristHash.hpp"
+#include "QmsCellGrid.hpp"
+#include "CopyOnWrite.hpp"
+#include "QmsUndoLog.hpp"
 
 class QString;
-class QmsButton;
 class MineCoordinates;
 class QXmlStreamWriter;
 
-using ButtonContainer = std::unordered_map<MineCoordinates, std::shared_ptr<QmsButton>, MineCoordinateHash>;
 enum class GameState {
     GameActive,
     GameInactive,
@@ -45,25 +47,29 @@ enum class LoadGameStateResult {
 
 class QmsGameState {
     friend class GameController;
+    friend class QmsReplaySimulator;
 
 public:
     QmsGameState();
     QmsGameState(int columnCount, int rowCount);
-    QmsGameState(const QmsGameState &);
-    QmsGameState(QmsGameState &&rhs) noexcept;
-    QmsGameState &operator=(const QmsGameState &);
-    QmsGameState &operator=(QmsGameState &&rhs);
+    QmsGameState(const QmsGameState &) = default;
+    QmsGameState(QmsGameState &&rhs) noexcept = default;
+    QmsGameState &operator=(const QmsGameState &) = default;
+    QmsGameState &operator=(QmsGameState &&rhs) noexcept = default;
     ~QmsGameState() = default;
 
     std::pair<LoadGameStateResult, std::string> loadGameInPlace(const QString &filePath);
     std::pair<SaveGameStateResult, std::string> saveToFile(const QString &filePath);
 
     QString filePath() const;
+    int numberOfColumns() const;
+    int numberOfRows() const;
+    const QmsCellGrid &cells() const;
 
 private:
     SteadyEventTimer m_playTimer;
-    std::set<MineCoordinates> m_mineCoordinates;
-    ButtonContainer m_mineSweeperButtons;
+    CopyOnWrite<std::set<MineCoordinates>> m_mineCoordinates;
+    QmsCellGrid m_cells;
     int m_numberOfMines;
     ChangeAwareInt m_userDisplayNumberOfMines;
     bool m_initialClickFlag;
@@ -74,19 +80,21 @@ private:
     bool m_gameOver;
     int m_totalButtonCount;
     int m_unopenedMineCount;
-    std::unique_ptr<float> m_customMineRatio;
+    std::shared_ptr<const float> m_customMineRatio;
     QString m_filePath;
+    ZobristHash m_stateHash;
+    uint64_t m_savedStateHash;
+    QmsUndoLog m_undoLog;
 
     void writeQmsButtonToXmlStream(QXmlStreamWriter &writeToFile, const MineCoordinates &coordinates,
-                                   std::shared_ptr<QmsButton> targetButton);
+                                   QmsCellState cellState);
 
     static const std::pair<double, double> CELL_TO_MINE_RATIOS;
     static const int CELL_TO_MINE_THRESHOLD;
 
     static std::pair<LoadGameStateResult, std::string> loadFromFile(const QString &filePath, QmsGameState &targetState);
-    static std::pair<MineCoordinates, std::shared_ptr<QmsButton>> readQmsButtonFromXmlFile(QXmlStreamReader &reader);
-    static std::list<std::pair<MineCoordinates, std::shared_ptr<QmsButton>>>
-    readQmsButtonListFromXmlFile(QXmlStreamReader &reader);
+    static std::pair<MineCoordinates, QmsCellState> readQmsButtonFromXmlFile(QXmlStreamReader &reader);
+    static std::list<std::pair<MineCoordinates, QmsCellState>> readQmsButtonListFromXmlFile(QXmlStreamReader &reader);
     static SteadyEventTimer readEventTimerFromXmlFile(QXmlStreamReader &reader);
     static std::list<MineCoordinates> readMineCoordinateListFromXmlFile(QXmlStreamReader &reader);
 
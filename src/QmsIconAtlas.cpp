@@ -0,0 +1,303 @@
+#include "QmsIconAtlas.hpp"
+#include "QmsStrings.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QPainter>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QColor>
+
+#include <algorithm>
+
+const int QmsIconAtlas::s_GLYPH_COUNT{13};
+
+namespace {
+
+    /* AtlasRenderTask : Renders an atlas on the render pool, handing the result back to
+     * the QmsIconAtlas on the GUI thread. Only QImage is used off the GUI thread, as
+     * QPixmap is not safe to use there on every platform */
+    class AtlasRenderTask : public QRunnable {
+    public:
+        AtlasRenderTask(QmsIconAtlas *atlas, IconPalette palette, int glyphExtent, qreal devicePixelRatio, int generation) :
+                m_atlas{atlas},
+                m_palette{palette},
+                m_glyphExtent{glyphExtent},
+                m_devicePixelRatio{devicePixelRatio},
+                m_generation{generation} {
+
+        }
+
+        void run() override {
+            const QImage atlasImage{QmsIconAtlas::renderAtlas(this->m_palette, this->m_glyphExtent)};
+            QMetaObject::invokeMethod(this->m_atlas, "onAtlasRendered", Qt::QueuedConnection,
+                                      Q_ARG(QImage, atlasImage), Q_ARG(int, this->m_glyphExtent),
+                                      Q_ARG(qreal, this->m_devicePixelRatio), Q_ARG(int, this->m_generation));
+        }
+
+    private:
+        QmsIconAtlas *m_atlas;
+        IconPalette m_palette;
+        int m_glyphExtent;
+        qreal m_devicePixelRatio;
+        int m_generation;
+    };
+
+    /* glyphSourcePath() : The mine is available in several sizes, so the smallest one
+     * that is at least as big as the glyph is scaled down, rather than scaling one up */
+    const char *glyphSourcePath(CellGlyph glyph, int glyphExtent) {
+        using namespace QmsStrings;
+        switch (glyph) {
+            case CellGlyph::Count1: return COUNT_MINES_1_PATH;
+            case CellGlyph::Count2: return COUNT_MINES_2_PATH;
+            case CellGlyph::Count3: return COUNT_MINES_3_PATH;
+            case CellGlyph::Count4: return COUNT_MINES_4_PATH;
+            case CellGlyph::Count5: return COUNT_MINES_5_PATH;
+            case CellGlyph::Count6: return COUNT_MINES_6_PATH;
+            case CellGlyph::Count7: return COUNT_MINES_7_PATH;
+            case CellGlyph::Count8: return COUNT_MINES_8_PATH;
+            case CellGlyph::Flag: return STATUS_ICON_FLAG_PATH;
+            case CellGlyph::QuestionMark: return STATUS_ICON_QUESTION_PATH;
+            case CellGlyph::FlagCheck: return STATUS_ICON_FLAG_CHECK_PATH;
+            case CellGlyph::FlagX: return STATUS_ICON_FLAG_X_PATH;
+            case CellGlyph::Mine: break;
+            case CellGlyph::None: return nullptr;
+        }
+        const std::pair<int, const char *> mineSources[]{{16, MINE_ICON_16_PATH}, {24, MINE_ICON_24_PATH},
+                                                         {32, MINE_ICON_32_PATH}, {48, MINE_ICON_48_PATH},
+                                                         {64, MINE_ICON_64_PATH}, {72, MINE_ICON_72_PATH},
+                                                         {96, MINE_ICON_96_PATH}};
+        for (const auto &it : mineSources) {
+            if (it.first >= glyphExtent) {
+                return it.second;
+            }
+        }
+        return MINE_ICON_128_PATH;
+    }
+
+    /* highContrastColor() : The surrounding mine counts in the traditional minesweeper colors,
+     * at full strength, and solid flags and question marks. Glyphs that rely on more than one
+     * color to make sense (the mine, and the checked or crossed out flags) are left alone */
+    QColor highContrastColor(CellGlyph glyph) {
+        switch (glyph) {
+            case CellGlyph::Count1: return QColor{0, 0, 255};
+            case CellGlyph::Count2: return QColor{0, 128, 0};
+            case CellGlyph::Count3: return QColor{255, 0, 0};
+            case CellGlyph::Count4: return QColor{0, 0, 128};
+            case CellGlyph::Count5: return QColor{128, 0, 0};
+            case CellGlyph::Count6: return QColor{0, 128, 128};
+            case CellGlyph::Count7: return QColor{0, 0, 0};
+            case CellGlyph::Count8: return QColor{128, 128, 128};
+            case CellGlyph::Flag: return QColor{255, 0, 0};
+            case CellGlyph::QuestionMark: return QColor{0, 0, 0};
+            default: return QColor{};
+        }
+    }
+
+}
+
+QmsIconAtlas::QmsIconAtlas(QObject *parent) :
+        QObject{parent},
+        m_atlases{},
+        m_renderingKeys{},
+        m_iconPalette{IconPalette::Classic},
+        m_preparedKey{0, 1.0},
+        m_generation{0},
+        m_renderPool{} {
+    this->m_renderPool.setMaxThreadCount(1);
+}
+
+/* ~QmsIconAtlas() : The render pool is destroyed first, waiting for a render
+ * still in progress, so no task is left holding a pointer to this atlas */
+QmsIconAtlas::~QmsIconAtlas() = default;
+
+IconPalette QmsIconAtlas::iconPalette() const {
+    return this->m_iconPalette;
+}
+
+/* setIconPalette() : Only the atlas of the prepared glyph size is rendered again (in the
+ * background), the atlases for other sizes are dropped and rendered again if they are ever
+ * needed. The old atlas is drawn until the new one is ready */
+void QmsIconAtlas::setIconPalette(IconPalette palette) {
+    if (palette == this->m_iconPalette) {
+        return;
+    }
+    LOG_INFO() << QString{"Changing icon palette to %1"}.arg(QmsIconAtlas::iconPaletteToString(palette));
+    this->m_iconPalette = palette;
+    this->m_generation++;
+    this->m_renderPool.clear();
+    this->m_renderingKeys.clear();
+    auto currentAtlas = this->m_atlases.find(this->m_preparedKey);
+    if (currentAtlas == this->m_atlases.end()) {
+        this->m_atlases.clear();
+        emit(atlasChanged());
+        return;
+    }
+    QPixmap previousAtlas{currentAtlas->second};
+    this->m_atlases.clear();
+    this->m_atlases.emplace(this->m_preparedKey, previousAtlas);
+    this->startRender(this->m_preparedKey);
+}
+
+/* prepareGlyphSize() : Called whenever the size the QmsButtons draw their glyphs at changes
+ * (a new board, a zoom step), before they are painted at it. Renders still waiting for the
+ * worker are dropped, as they are for sizes zoomed straight past */
+void QmsIconAtlas::prepareGlyphSize(const QSize &glyphSize, qreal devicePixelRatio) {
+    const AtlasKey key{QmsIconAtlas::glyphExtent(glyphSize, devicePixelRatio), devicePixelRatio};
+    if (key.first <= 0) {
+        return;
+    }
+    this->m_preparedKey = key;
+    if ((this->m_atlases.count(key) != 0) || (this->m_renderingKeys.count(key) != 0)) {
+        return;
+    }
+    if (this->m_atlases.empty()) {
+        LOG_DEBUG() << QString{"Rendering the first icon atlas, for %1px glyphs"}.arg(QS_NUMBER(key.first));
+        this->m_atlases.emplace(key, QmsIconAtlas::toAtlasPixmap(QmsIconAtlas::renderAtlas(this->m_iconPalette, key.first),
+                                                                 key.second));
+        return;
+    }
+    this->m_renderPool.clear();
+    this->m_renderingKeys.clear();
+    this->startRender(key);
+}
+
+/* drawGlyph() : Draws glyph centered in cellRect, glyphSize being the logical size of the glyph
+ * (the button's icon size). With the atlas for that size, it is a single unscaled blit. Without
+ * it, the atlas is asked for, and the glyph is scaled out of the prepared atlas in the meantime */
+void QmsIconAtlas::drawGlyph(QPainter *painter, const QRect &cellRect, CellGlyph glyph, const QSize &glyphSize, qreal devicePixelRatio) {
+    if (glyph == CellGlyph::None) {
+        return;
+    }
+    const AtlasKey key{QmsIconAtlas::glyphExtent(glyphSize, devicePixelRatio), devicePixelRatio};
+    if (key.first <= 0) {
+        return;
+    }
+    auto found = this->m_atlases.find(key);
+    if (found == this->m_atlases.end()) {
+        if (this->m_atlases.empty()) {
+            this->prepareGlyphSize(glyphSize, devicePixelRatio);
+            found = this->m_atlases.find(key);
+        } else {
+            if (this->m_renderingKeys.count(key) == 0) {
+                this->startRender(key);
+            }
+            found = this->m_atlases.find(this->m_preparedKey);
+            if (found == this->m_atlases.end()) {
+                found = this->m_atlases.begin();
+            }
+        }
+    }
+    const int atlasExtent{found->first.first};
+    const QRect sourceRect{(static_cast<int>(glyph) - 1) * atlasExtent, 0, atlasExtent, atlasExtent};
+    const qreal logicalExtent{key.first / devicePixelRatio};
+    const QPoint topLeft{cellRect.x() + qRound((cellRect.width() - logicalExtent) / 2.0),
+                         cellRect.y() + qRound((cellRect.height() - logicalExtent) / 2.0)};
+    if (atlasExtent == key.first) {
+        painter->drawPixmap(topLeft, found->second, sourceRect);
+    } else {
+        painter->drawPixmap(QRectF{QPointF{topLeft}, QSizeF{logicalExtent, logicalExtent}}, found->second, QRectF{sourceRect});
+    }
+}
+
+/* onAtlasRendered() : Keeps the new atlas and the prepared one, and drops the rest, as
+ * the sizes zoomed past (and screens moved off of) would otherwise pile up */
+void QmsIconAtlas::onAtlasRendered(QImage atlasImage, int glyphExtent, qreal devicePixelRatio, int generation) {
+    if (generation != this->m_generation) {
+        return;
+    }
+    const AtlasKey key{glyphExtent, devicePixelRatio};
+    this->m_renderingKeys.erase(key);
+    this->m_atlases[key] = QmsIconAtlas::toAtlasPixmap(atlasImage, devicePixelRatio);
+    for (auto it = this->m_atlases.begin(); it != this->m_atlases.end();) {
+        if ((it->first == key) || (it->first == this->m_preparedKey)) {
+            ++it;
+        } else {
+            it = this->m_atlases.erase(it);
+        }
+    }
+    emit(atlasChanged());
+}
+
+void QmsIconAtlas::startRender(const AtlasKey &key) {
+    this->m_renderingKeys.insert(key);
+    this->m_renderPool.start(new AtlasRenderTask{this, this->m_iconPalette, key.first, key.second, this->m_generation});
+}
+
+int QmsIconAtlas::glyphExtent(const QSize &glyphSize, qreal devicePixelRatio) {
+    return qRound(std::min(glyphSize.width(), glyphSize.height()) * devicePixelRatio);
+}
+
+QPixmap QmsIconAtlas::toAtlasPixmap(const QImage &atlasImage, qreal devicePixelRatio) {
+    QPixmap atlasPixmap{QPixmap::fromImage(atlasImage)};
+    atlasPixmap.setDevicePixelRatio(devicePixelRatio);
+    return atlasPixmap;
+}
+
+/* renderAtlas() : Lays every glyph out left to right, each one scaled (once) to fit a
+ * glyphExtent x glyphExtent square and centered in it. Safe to call off the GUI thread */
+QImage QmsIconAtlas::renderAtlas(IconPalette palette, int glyphExtent) {
+    QImage atlasImage{glyphExtent * QmsIconAtlas::s_GLYPH_COUNT, glyphExtent, QImage::Format_ARGB32_Premultiplied};
+    atlasImage.fill(Qt::transparent);
+    QPainter atlasPainter{&atlasImage};
+    for (int slot = 0; slot < QmsIconAtlas::s_GLYPH_COUNT; slot++) {
+        const auto glyph = static_cast<CellGlyph>(slot + 1);
+        QImage glyphImage{QImage{glyphSourcePath(glyph, glyphExtent)}.scaled(glyphExtent, glyphExtent, Qt::KeepAspectRatio,
+                                                                             Qt::SmoothTransformation)};
+        if (glyphImage.isNull()) {
+            continue;
+        }
+        glyphImage = glyphImage.convertToFormat(QImage::Format_ARGB32);
+        if (palette == IconPalette::Monochrome) {
+            for (int y = 0; y < glyphImage.height(); y++) {
+                auto *line = reinterpret_cast<QRgb *>(glyphImage.scanLine(y));
+                for (int x = 0; x < glyphImage.width(); x++) {
+                    const int gray{qGray(line[x])};
+                    line[x] = qRgba(gray, gray, gray, qAlpha(line[x]));
+                }
+            }
+        } else if (palette == IconPalette::HighContrast) {
+            const QColor tint{highContrastColor(glyph)};
+            if (tint.isValid()) {
+                QPainter tintPainter{&glyphImage};
+                tintPainter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+                tintPainter.fillRect(glyphImage.rect(), tint);
+            }
+        }
+        atlasPainter.drawImage(QPoint{(slot * glyphExtent) + ((glyphExtent - glyphImage.width()) / 2),
+                                      (glyphExtent - glyphImage.height()) / 2},
+                               glyphImage);
+    }
+    return atlasImage;
+}
+
+CellGlyph QmsIconAtlas::countGlyph(int numberOfSurroundingMines) {
+    if ((numberOfSurroundingMines < 1) || (numberOfSurroundingMines > 8)) {
+        return CellGlyph::None;
+    }
+    return static_cast<CellGlyph>(static_cast<int>(CellGlyph::Count1) + numberOfSurroundingMines - 1);
+}
+
+bool QmsIconAtlas::tryParseIconPalette(int value, IconPalette &palette) {
+    if ((value < static_cast<int>(IconPalette::Classic)) || (value > static_cast<int>(IconPalette::Monochrome))) {
+        return false;
+    }
+    palette = static_cast<IconPalette>(value);
+    return true;
+}
+
+const char *QmsIconAtlas::iconPaletteToString(IconPalette palette) {
+    using namespace QmsStrings;
+    if (palette == IconPalette::Classic) {
+        return CLASSIC_PALETTE_STRING;
+    } else if (palette == IconPalette::HighContrast) {
+        return HIGH_CONTRAST_PALETTE_STRING;
+    } else if (palette == IconPalette::Monochrome) {
+        return MONOCHROME_PALETTE_STRING;
+    } else {
+        Q_UNREACHABLE();
+    }
+}
+
+int QmsIconAtlas::GLYPH_COUNT() {
+    return QmsIconAtlas::s_GLYPH_COUNT;
+}
@@ -0,0 +1,92 @@
+#ifndef QMINESWEEPER_QMSICONATLAS_HPP
+#define QMINESWEEPER_QMSICONATLAS_HPP
+
+#include <QObject>
+#include <QPixmap>
+#include <QImage>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+class QPainter;
+class QRect;
+class QSize;
+
+/* CellGlyph : Everything that can be drawn on top of a QmsButton, in atlas order */
+enum class CellGlyph : uint8_t {
+    None,
+    Count1,
+    Count2,
+    Count3,
+    Count4,
+    Count5,
+    Count6,
+    Count7,
+    Count8,
+    Flag,
+    QuestionMark,
+    FlagCheck,
+    FlagX,
+    Mine
+};
+
+enum class IconPalette : int {
+    Classic,
+    HighContrast,
+    Monochrome
+};
+
+/* QmsIconAtlas : Every cell glyph pre-rendered once per glyph size and device pixel ratio
+ * into a single pixmap, one glyph next to the other. Drawing a glyph is then one unscaled
+ * blit out of the atlas, instead of QIcon scaling the source image for every button it paints.
+ * Atlases are rendered on a worker thread, ahead of the paints that need them: when the glyph
+ * size changes (prepareGlyphSize()) and when the palette changes. Until the new atlas is ready,
+ * the one drawn before it is drawn scaled, and atlasChanged() is emitted once it is. Only the
+ * very first atlas, with nothing to draw in the meantime, is rendered on the GUI thread. At most
+ * two atlases are kept, the prepared one and the one rendered last */
+class QmsIconAtlas : public QObject {
+Q_OBJECT
+public:
+    explicit QmsIconAtlas(QObject *parent = nullptr);
+    ~QmsIconAtlas() override;
+    QmsIconAtlas(const QmsIconAtlas &rhs) = delete;
+    QmsIconAtlas &operator=(const QmsIconAtlas &rhs) = delete;
+
+    IconPalette iconPalette() const;
+    void setIconPalette(IconPalette palette);
+    void prepareGlyphSize(const QSize &glyphSize, qreal devicePixelRatio);
+    void drawGlyph(QPainter *painter, const QRect &cellRect, CellGlyph glyph, const QSize &glyphSize, qreal devicePixelRatio);
+
+    static CellGlyph countGlyph(int numberOfSurroundingMines);
+    static bool tryParseIconPalette(int value, IconPalette &palette);
+    static const char *iconPaletteToString(IconPalette palette);
+    static QImage renderAtlas(IconPalette palette, int glyphExtent);
+    static int GLYPH_COUNT();
+
+signals:
+    void atlasChanged();
+
+private slots:
+    void onAtlasRendered(QImage atlasImage, int glyphExtent, qreal devicePixelRatio, int generation);
+
+private:
+    using AtlasKey = std::pair<int, qreal>;
+
+    std::map<AtlasKey, QPixmap> m_atlases;
+    std::set<AtlasKey> m_renderingKeys;
+    IconPalette m_iconPalette;
+    AtlasKey m_preparedKey;
+    int m_generation;
+    QThreadPool m_renderPool;
+
+    void startRender(const AtlasKey &key);
+    static int glyphExtent(const QSize &glyphSize, qreal devicePixelRatio);
+    static QPixmap toAtlasPixmap(const QImage &atlasImage, qreal devicePixelRatio);
+
+    static const int s_GLYPH_COUNT;
+};
+
+#endif //QMINESWEEPER_QMSICONATLAS_HPP
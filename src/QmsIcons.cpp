@@ -27,19 +27,7 @@ QmsIcons::QmsIcons() :
         FACE_ICON_SLEEPY{QIcon{FACE_ICON_SLEEPY_PATH}},
         FACE_ICON_SMILEY{QIcon{FACE_ICON_SMILEY_PATH}},
         FACE_ICON_WINKY{QIcon{FACE_ICON_WINKY_PATH}},
-        COUNT_MINES_0{QIcon{}},
-        COUNT_MINES_1{QIcon{COUNT_MINES_1_PATH}},
-        COUNT_MINES_2{QIcon{COUNT_MINES_2_PATH}},
-        COUNT_MINES_3{QIcon{COUNT_MINES_3_PATH}},
-        COUNT_MINES_4{QIcon{COUNT_MINES_4_PATH}},
-        COUNT_MINES_5{QIcon{COUNT_MINES_5_PATH}},
-        COUNT_MINES_6{QIcon{COUNT_MINES_6_PATH}},
-        COUNT_MINES_7{QIcon{COUNT_MINES_7_PATH}},
-        COUNT_MINES_8{QIcon{COUNT_MINES_8_PATH}},
-        STATUS_ICON_FLAG{QIcon{STATUS_ICON_FLAG_PATH}},
-        STATUS_ICON_QUESTION{QIcon{STATUS_ICON_QUESTION_PATH}},
-        STATUS_ICON_FLAG_CHECK{QIcon{STATUS_ICON_FLAG_CHECK_PATH}},
-        STATUS_ICON_FLAG_X{QIcon{STATUS_ICON_FLAG_X_PATH}} {
+        m_iconAtlas{new QmsIconAtlas{}} {
     //Constructor
 }
 
@@ -50,12 +38,21 @@ QmsIcons *QmsIcons::initializeInstance() {
     return applicationIcons;
 }
 
-QmsIcons &QmsIcons::changeIconPalette(QIcon *icon) {
-    //TODO: Implement
-    Q_UNUSED(icon);
+/* changeIconPalette() : Recolors the glyphs drawn on the QmsButtons. The atlas
+ * in use is rendered again in the background, see QmsIconAtlas::setIconPalette() */
+QmsIcons &QmsIcons::changeIconPalette(IconPalette palette) {
+    this->m_iconAtlas->setIconPalette(palette);
     return *this;
 }
 
+IconPalette QmsIcons::iconPalette() const {
+    return this->m_iconAtlas->iconPalette();
+}
+
+QmsIconAtlas *QmsIcons::iconAtlas() const {
+    return this->m_iconAtlas.get();
+}
+
 /* ~QmsIcons() : Destructor, empty by default */
 QmsIcons::~QmsIcons() {
     //Destructor
@@ -3,6 +3,10 @@
 
 #include <QIcon>
 
+#include <memory>
+
+#include "QmsIconAtlas.hpp"
+
 class QmsIcons {
 public:
     const QIcon MINE_ICON_16;
@@ -21,26 +25,15 @@ public:
     const QIcon FACE_ICON_SMILEY;
     const QIcon FACE_ICON_WINKY;
 
-    const QIcon COUNT_MINES_0;
-    const QIcon COUNT_MINES_1;
-    const QIcon COUNT_MINES_2;
-    const QIcon COUNT_MINES_3;
-    const QIcon COUNT_MINES_4;
-    const QIcon COUNT_MINES_5;
-    const QIcon COUNT_MINES_6;
-    const QIcon COUNT_MINES_7;
-    const QIcon COUNT_MINES_8;
-
-    const QIcon STATUS_ICON_FLAG;
-    const QIcon STATUS_ICON_QUESTION;
-    const QIcon STATUS_ICON_FLAG_CHECK;
-    const QIcon STATUS_ICON_FLAG_X;
-
     static QmsIcons *initializeInstance();
 
-    QmsIcons &changeIconPalette(QIcon *icon);
+    QmsIcons &changeIconPalette(IconPalette palette);
+    IconPalette iconPalette() const;
+    QmsIconAtlas *iconAtlas() const;
 
 private:
+    std::unique_ptr<QmsIconAtlas> m_iconAtlas;
+
     QmsIcons();
     ~QmsIcons();
     QmsIcons(const QmsIcons &) = delete;
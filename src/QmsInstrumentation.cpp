@@ -0,0 +1,54 @@
+#include "QmsInstrumentation.hpp"
+#include "QmsTraceRecorder.hpp"
+#include "QmsFlightRecorder.hpp"
+#include "QmsEventLoopWatchdog.hpp"
+
+QmsInstrumentationSite::QmsInstrumentationSite(const char *name) :
+        m_latencyHistogram{name},
+        m_allocationRegion{name} {
+
+}
+
+const char *QmsInstrumentationSite::name() const {
+    return this->m_latencyHistogram.name();
+}
+
+QmsLatencyHistogram &QmsInstrumentationSite::latencyHistogram() {
+    return this->m_latencyHistogram;
+}
+
+QmsAllocationRegion &QmsInstrumentationSite::allocationRegion() {
+    return this->m_allocationRegion;
+}
+
+/* QmsInstrumentationScope() : The clock is read last, so
+ * that entering the stall context is not part of the measurement */
+QmsInstrumentationScope::QmsInstrumentationScope(QmsInstrumentationSite &site) :
+        m_site{site},
+        m_isGuiThread{QmsEventLoopWatchdog::isGuiThread()},
+        m_startAllocationCount{QmsAllocationTracker::threadAllocationCount()},
+        m_startAllocatedBytes{QmsAllocationTracker::threadAllocatedBytes()},
+        m_startTime{} {
+    if (this->m_isGuiThread) {
+        QmsEventLoopWatchdog::enterContext(site.name());
+    }
+    this->m_startTime = std::chrono::steady_clock::now();
+}
+
+/* ~QmsInstrumentationScope() : Everything worth a histogram is worth a span in the
+ * trace and an event in the flight recorder too */
+QmsInstrumentationScope::~QmsInstrumentationScope() {
+    const auto endTime = std::chrono::steady_clock::now();
+    this->m_site.latencyHistogram().record(endTime - this->m_startTime);
+    QmsFlightRecorder::record(this->m_site.name(), -1, -1, this->m_startTime, endTime);
+    if (QmsTraceRecorder::isEnabled()) {
+        QmsTraceRecorder::recordSpan(this->m_site.name(), "game", this->m_startTime, endTime);
+    }
+#if defined(QMS_ALLOCATION_TRACKING)
+    this->m_site.allocationRegion().addEntry(QmsAllocationTracker::threadAllocationCount() - this->m_startAllocationCount,
+                                             QmsAllocationTracker::threadAllocatedBytes() - this->m_startAllocatedBytes);
+#endif
+    if (this->m_isGuiThread) {
+        QmsEventLoopWatchdog::leaveContext();
+    }
+}
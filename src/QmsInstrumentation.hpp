@@ -0,0 +1,53 @@
+#ifndef QMINESWEEPER_QMSINSTRUMENTATION_HPP
+#define QMINESWEEPER_QMSINSTRUMENTATION_HPP
+
+#include "QmsLatencyHistogram.hpp"
+#include "QmsAllocationTracker.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+/* QmsInstrumentationSite : A piece of work that is measured (a handler, a save, a paint), created
+ * by QMS_INSTRUMENT_SCOPE() as a function static. Its name is the one the work goes by everywhere
+ * it is reported, and it owns the latency histogram and allocation region its scopes record to */
+class QmsInstrumentationSite {
+public:
+    explicit QmsInstrumentationSite(const char *name);
+    QmsInstrumentationSite(const QmsInstrumentationSite &rhs) = delete;
+    QmsInstrumentationSite &operator=(const QmsInstrumentationSite &rhs) = delete;
+
+    const char *name() const;
+    QmsLatencyHistogram &latencyHistogram();
+    QmsAllocationRegion &allocationRegion();
+
+private:
+    QmsLatencyHistogram m_latencyHistogram;
+    QmsAllocationRegion m_allocationRegion;
+};
+
+/* QmsInstrumentationScope : Measures the work from its construction to its destruction, reading
+ * the clock once at each end, and feeds that one measurement to everything that reports on it:
+ * the site's latency histogram (for the latency overlay and the metrics snapshots), the flight
+ * recorder, the trace (while one is recorded) and, with QMS_ALLOCATION_TRACKING, the allocation
+ * report. On the GUI thread, the site's name is also the context that stall warnings and flight
+ * recorder dumps name while the work is in progress. Scopes nest */
+class QmsInstrumentationScope {
+public:
+    explicit QmsInstrumentationScope(QmsInstrumentationSite &site);
+    ~QmsInstrumentationScope();
+    QmsInstrumentationScope(const QmsInstrumentationScope &rhs) = delete;
+    QmsInstrumentationScope &operator=(const QmsInstrumentationScope &rhs) = delete;
+
+private:
+    QmsInstrumentationSite &m_site;
+    bool m_isGuiThread;
+    uint64_t m_startAllocationCount;
+    uint64_t m_startAllocatedBytes;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+#define QMS_INSTRUMENT_SCOPE(scopeName) \
+    static QmsInstrumentationSite qmsInstrumentationSite{scopeName}; \
+    QmsInstrumentationScope qmsInstrumentationScope{qmsInstrumentationSite}
+
+#endif //QMINESWEEPER_QMSINSTRUMENTATION_HPP
@@ -0,0 +1,124 @@
+#include "QmsLatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+std::atomic<int64_t> QmsInputLatency::s_pendingInputTime{0};
+
+QmsLatencyHistogram::QmsLatencyHistogram(const char *name, Unit unit) :
+        QmsRegistered{},
+        m_name{name},
+        m_unit{unit},
+        m_buckets{},
+        m_count{0},
+        m_sum{0},
+        m_maximum{0},
+        m_last{0} {
+    for (auto &it : this->m_buckets) {
+        it.store(0, std::memory_order_relaxed);
+    }
+}
+
+void QmsLatencyHistogram::record(std::chrono::steady_clock::duration duration) {
+    this->recordValue(static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count())));
+}
+
+/* recordValue() : In microseconds, or as is for a histogram of Unit::Value */
+void QmsLatencyHistogram::recordValue(uint64_t value) {
+    this->m_buckets[static_cast<size_t>(QmsLatencyHistogram::bucketIndex(value))].fetch_add(1, std::memory_order_relaxed);
+    this->m_count.fetch_add(1, std::memory_order_relaxed);
+    this->m_sum.fetch_add(value, std::memory_order_relaxed);
+    this->m_last.store(value, std::memory_order_relaxed);
+    uint64_t maximum{this->m_maximum.load(std::memory_order_relaxed)};
+    while ((value > maximum) &&
+           (!this->m_maximum.compare_exchange_weak(maximum, value, std::memory_order_relaxed))) {}
+}
+
+const char *QmsLatencyHistogram::name() const {
+    return this->m_name;
+}
+
+QmsLatencyHistogram::Unit QmsLatencyHistogram::unit() const {
+    return this->m_unit;
+}
+
+uint64_t QmsLatencyHistogram::count() const {
+    return this->m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsLatencyHistogram::sum() const {
+    return this->m_sum.load(std::memory_order_relaxed);
+}
+
+/* percentile() : In microseconds, the upper bound of the bucket holding the sample at that
+ * fraction of all of them (0.99 for the 99th percentile), but never more than the maximum */
+uint64_t QmsLatencyHistogram::percentile(double fraction) const {
+    const uint64_t count{this->count()};
+    if (count == 0) {
+        return 0;
+    }
+    const auto targetRank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+    uint64_t rank{0};
+    for (int bucketIndex = 0; bucketIndex < QmsLatencyHistogram::s_BUCKET_COUNT; bucketIndex++) {
+        rank += this->m_buckets[static_cast<size_t>(bucketIndex)].load(std::memory_order_relaxed);
+        if (rank >= targetRank) {
+            return std::min(QmsLatencyHistogram::bucketUpperBound(bucketIndex), this->maximum());
+        }
+    }
+    return this->maximum();
+}
+
+uint64_t QmsLatencyHistogram::maximum() const {
+    return this->m_maximum.load(std::memory_order_relaxed);
+}
+
+uint64_t QmsLatencyHistogram::last() const {
+    return this->m_last.load(std::memory_order_relaxed);
+}
+
+/* bucketIndex() : Past the linear buckets, the position of the highest set bit picks the
+ * power of two, and the SUB_BUCKET_BITS bits below it pick one of the buckets inside it */
+int QmsLatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(QmsLatencyHistogram::s_LINEAR_BUCKET_COUNT)) {
+        return static_cast<int>(value);
+    }
+    int highestBit{0};
+    while ((value >> (highestBit + 1)) != 0) {
+        highestBit++;
+    }
+    const auto subBucket = static_cast<int>((value >> (highestBit - QmsLatencyHistogram::s_SUB_BUCKET_BITS)) &
+                                            ((1U << QmsLatencyHistogram::s_SUB_BUCKET_BITS) - 1));
+    return QmsLatencyHistogram::s_LINEAR_BUCKET_COUNT + ((highestBit - 4) << QmsLatencyHistogram::s_SUB_BUCKET_BITS) + subBucket;
+}
+
+uint64_t QmsLatencyHistogram::bucketUpperBound(int bucketIndex) {
+    if (bucketIndex < QmsLatencyHistogram::s_LINEAR_BUCKET_COUNT) {
+        return static_cast<uint64_t>(bucketIndex);
+    }
+    const int logarithmicIndex{bucketIndex - QmsLatencyHistogram::s_LINEAR_BUCKET_COUNT};
+    const int highestBit{(logarithmicIndex >> QmsLatencyHistogram::s_SUB_BUCKET_BITS) + 4};
+    const auto subBucket = static_cast<uint64_t>(logarithmicIndex & ((1 << QmsLatencyHistogram::s_SUB_BUCKET_BITS) - 1));
+    const int bucketWidthBits{highestBit - QmsLatencyHistogram::s_SUB_BUCKET_BITS};
+    const uint64_t lowerBound{((1ULL << QmsLatencyHistogram::s_SUB_BUCKET_BITS) + subBucket) << bucketWidthBits};
+    return lowerBound + ((1ULL << bucketWidthBits) - 1);
+}
+
+int QmsLatencyHistogram::BUCKET_COUNT() {
+    return QmsLatencyHistogram::s_BUCKET_COUNT;
+}
+
+void QmsInputLatency::markInput() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    QmsInputLatency::s_pendingInputTime.store(std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+                                              std::memory_order_relaxed);
+}
+
+/* markPainted() : Only the first paint after an input counts, later ones are not waiting on it */
+void QmsInputLatency::markPainted() {
+    static QmsLatencyHistogram inputToPaintHistogram{"Input to paint"};
+    const int64_t inputTime{QmsInputLatency::s_pendingInputTime.exchange(0, std::memory_order_relaxed)};
+    if (inputTime != 0) {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        inputToPaintHistogram.record(now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds{inputTime}));
+    }
+}
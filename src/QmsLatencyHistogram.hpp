@@ -0,0 +1,70 @@
+#ifndef QMINESWEEPER_QMSLATENCYHISTOGRAM_HPP
+#define QMINESWEEPER_QMSLATENCYHISTOGRAM_HPP
+
+#include "QmsRegistry.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/* QmsLatencyHistogram : How long one kind of work (a mouse release, a save, a paint) took, in
+ * fixed buckets: one per microsecond below 16 microseconds, then eight per power of two, so a
+ * percentile read back is never more than an eighth above the true value. Recording is a few
+ * relaxed atomic increments, so histograms are always on. Each QMS_INSTRUMENT_SCOPE() has one,
+ * and they are registered (see QmsRegistered) for the QmsLatencyOverlay and the metrics
+ * snapshots. A histogram of Unit::Value holds plain numbers instead of microseconds (the cells
+ * uncovered by a cascade), in the same buckets */
+class QmsLatencyHistogram : public QmsRegistered<QmsLatencyHistogram> {
+public:
+    enum class Unit {
+        Microseconds,
+        Value
+    };
+
+    explicit QmsLatencyHistogram(const char *name, Unit unit = Unit::Microseconds);
+    QmsLatencyHistogram(const QmsLatencyHistogram &rhs) = delete;
+    QmsLatencyHistogram &operator=(const QmsLatencyHistogram &rhs) = delete;
+
+    void record(std::chrono::steady_clock::duration duration);
+    void recordValue(uint64_t value);
+
+    const char *name() const;
+    Unit unit() const;
+    uint64_t count() const;
+    uint64_t sum() const;
+    uint64_t percentile(double fraction) const;
+    uint64_t maximum() const;
+    uint64_t last() const;
+
+    static int BUCKET_COUNT();
+
+private:
+    static const int s_LINEAR_BUCKET_COUNT{16};
+    static const int s_SUB_BUCKET_BITS{3};
+    static const int s_BUCKET_COUNT{s_LINEAR_BUCKET_COUNT + ((64 - 4) << s_SUB_BUCKET_BITS)};
+
+    const char *m_name;
+    Unit m_unit;
+    std::array<std::atomic<uint32_t>, s_BUCKET_COUNT> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_maximum;
+    std::atomic<uint64_t> m_last;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int bucketIndex);
+};
+
+/* QmsInputLatency : The time from a mouse release on the board to the end of the first paint
+ * of the window after it, which is how long the player waits to see a click take effect */
+class QmsInputLatency {
+public:
+    static void markInput();
+    static void markPainted();
+
+private:
+    static std::atomic<int64_t> s_pendingInputTime;
+};
+
+#endif //QMINESWEEPER_QMSLATENCYHISTOGRAM_HPP
@@ -0,0 +1,104 @@
+#include "QmsLatencyOverlay.hpp"
+#include "QmsLatencyHistogram.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QFontDatabase>
+#include <QFontMetrics>
+
+#include <algorithm>
+
+const int QmsLatencyOverlay::s_REFRESH_INTERVAL{500};
+const int QmsLatencyOverlay::s_MARGIN{6};
+const char *QmsLatencyOverlay::s_FRAME_HISTOGRAM_NAME{"Window paint"};
+
+QmsLatencyOverlay::QmsLatencyOverlay(QWidget *parent) :
+        QWidget{parent},
+        m_refreshTimer{},
+        m_lines{} {
+    this->setAttribute(Qt::WA_TransparentForMouseEvents);
+    this->setAttribute(Qt::WA_NoSystemBackground);
+    this->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    this->m_refreshTimer.setInterval(QmsLatencyOverlay::s_REFRESH_INTERVAL);
+    connect(&this->m_refreshTimer, &QTimer::timeout, this, &QmsLatencyOverlay::refresh);
+    this->hide();
+}
+
+QSize QmsLatencyOverlay::sizeHint() const {
+    const QFontMetrics fontMetrics{this->font()};
+    int width{0};
+    for (const auto &it : this->m_lines) {
+        width = std::max(width, fontMetrics.width(it));
+    }
+    return QSize{width + (2 * QmsLatencyOverlay::s_MARGIN),
+                 (fontMetrics.lineSpacing() * this->m_lines.size()) + (2 * QmsLatencyOverlay::s_MARGIN)};
+}
+
+void QmsLatencyOverlay::paintEvent(QPaintEvent *paintEvent) {
+    Q_UNUSED(paintEvent);
+    QPainter painter{this};
+    painter.fillRect(this->rect(), QColor{0, 0, 0, 180});
+    painter.setPen(Qt::white);
+    const QFontMetrics fontMetrics{this->font()};
+    int y{QmsLatencyOverlay::s_MARGIN + fontMetrics.ascent()};
+    for (const auto &it : this->m_lines) {
+        painter.drawText(QmsLatencyOverlay::s_MARGIN, y, it);
+        y += fontMetrics.lineSpacing();
+    }
+}
+
+void QmsLatencyOverlay::showEvent(QShowEvent *showEvent) {
+    this->refresh();
+    this->m_refreshTimer.start();
+    QWidget::showEvent(showEvent);
+}
+
+void QmsLatencyOverlay::hideEvent(QHideEvent *hideEvent) {
+    this->m_refreshTimer.stop();
+    QWidget::hideEvent(hideEvent);
+}
+
+/* refresh() : The histograms are listed in the order they were first used */
+void QmsLatencyOverlay::refresh() {
+    QStringList histogramLines{};
+    uint64_t framePaintTime{0};
+    for (const QmsLatencyHistogram *histogram = QmsLatencyHistogram::first(); histogram != nullptr; histogram = histogram->next()) {
+        if ((histogram->count() == 0) || (histogram->unit() != QmsLatencyHistogram::Unit::Microseconds)) {
+            continue;
+        }
+        if (qstrcmp(histogram->name(), QmsLatencyOverlay::s_FRAME_HISTOGRAM_NAME) == 0) {
+            framePaintTime = histogram->last();
+        }
+        histogramLines.prepend(QString{"%1 %2 %3 %4 %5 %6"}.arg(QString{histogram->name()}, -16)
+                                       .arg(formatMicroseconds(histogram->percentile(0.50)), 9)
+                                       .arg(formatMicroseconds(histogram->percentile(0.95)), 9)
+                                       .arg(formatMicroseconds(histogram->percentile(0.99)), 9)
+                                       .arg(formatMicroseconds(histogram->maximum()), 9)
+                                       .arg(histogram->count(), 7));
+    }
+    this->m_lines.clear();
+    this->m_lines.append(QString{"Frame %1"}.arg(formatMicroseconds(framePaintTime)));
+    this->m_lines.append(QString{"%1 %2 %3 %4 %5 %6"}.arg(QString{}, -16).arg("p50", 9).arg("p95", 9)
+                                 .arg("p99", 9).arg("max", 9).arg("count", 7));
+    this->m_lines.append(histogramLines);
+    this->resize(this->sizeHint());
+    this->raise();
+    this->update();
+}
+
+QString QmsLatencyOverlay::formatMicroseconds(uint64_t microseconds) {
+    if (microseconds < 1000) {
+        return QString{"%1 us"}.arg(microseconds);
+    }
+    return QString{"%1 ms"}.arg(static_cast<double>(microseconds) / 1000.0, 0, 'f', 2);
+}
+
+int QmsLatencyOverlay::REFRESH_INTERVAL() {
+    return QmsLatencyOverlay::s_REFRESH_INTERVAL;
+}
+
+/* FRAME_HISTOGRAM_NAME() : The histogram of whole window paints, whose
+ * latest sample is shown as the frame time at the top of the overlay */
+const char *QmsLatencyOverlay::FRAME_HISTOGRAM_NAME() {
+    return QmsLatencyOverlay::s_FRAME_HISTOGRAM_NAME;
+}
@@ -0,0 +1,46 @@
+#ifndef QMINESWEEPER_QMSLATENCYOVERLAY_HPP
+#define QMINESWEEPER_QMSLATENCYOVERLAY_HPP
+
+#include <QWidget>
+#include <QTimer>
+#include <QStringList>
+
+class QPaintEvent;
+class QShowEvent;
+class QHideEvent;
+
+/* QmsLatencyOverlay : A small translucent panel in the corner of the board, listing the p50,
+ * p95 and p99 and the maximum of every QmsLatencyHistogram that has samples, along with the
+ * time the last paint of the window took. Mouse events go through it to the board. It reads
+ * the histograms a couple of times a second while shown, and costs nothing while hidden */
+class QmsLatencyOverlay : public QWidget {
+Q_OBJECT
+public:
+    explicit QmsLatencyOverlay(QWidget *parent);
+    ~QmsLatencyOverlay() override = default;
+
+    QSize sizeHint() const override;
+
+    static int REFRESH_INTERVAL();
+    static const char *FRAME_HISTOGRAM_NAME();
+
+protected:
+    void paintEvent(QPaintEvent *paintEvent) override;
+    void showEvent(QShowEvent *showEvent) override;
+    void hideEvent(QHideEvent *hideEvent) override;
+
+private slots:
+    void refresh();
+
+private:
+    QTimer m_refreshTimer;
+    QStringList m_lines;
+
+    static QString formatMicroseconds(uint64_t microseconds);
+
+    static const int s_REFRESH_INTERVAL;
+    static const int s_MARGIN;
+    static const char *s_FRAME_HISTOGRAM_NAME;
+};
+
+#endif //QMINESWEEPER_QMSLATENCYOVERLAY_HPP
@@ -0,0 +1,14 @@
+#include "QmsLogLevel.hpp"
+
+namespace QmsLogging {
+
+    std::atomic<int> currentMinimumLevel{static_cast<int>(QmsLogLevel::Info)};
+
+    void setMinimumLevel(QmsLogLevel logLevel) {
+        currentMinimumLevel.store(static_cast<int>(logLevel), std::memory_order_relaxed);
+    }
+
+    QmsLogLevel minimumLevel() {
+        return static_cast<QmsLogLevel>(currentMinimumLevel.load(std::memory_order_relaxed));
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef QMINESWEEPER_QMSLOGLEVEL_HPP
+#define QMINESWEEPER_QMSLOGLEVEL_HPP
+
+#include <atomic>
+
+/* QMS_COMPILED_LOG_LEVEL : The lowest level that is compiled in at all (0 for debug, 1 for info,
+ * 2 for warning, 3 for critical). Set by CMake: debug builds keep everything, other builds start
+ * at info, so none of the debug logging is left in a release binary. Fatal is never removed */
+#ifndef QMS_COMPILED_LOG_LEVEL
+#    define QMS_COMPILED_LOG_LEVEL 0
+#endif
+
+enum class QmsLogLevel : int {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Critical = 3,
+    Fatal = 4
+};
+
+/* QmsLogging : The lowest level logged at runtime, checked by the LOG_* macros before anything
+ * of the message is built. Starts at info, and is lowered to debug by the --verbose switch */
+namespace QmsLogging {
+    extern std::atomic<int> currentMinimumLevel;
+
+    inline bool isEnabled(QmsLogLevel logLevel) {
+        return static_cast<int>(logLevel) >= currentMinimumLevel.load(std::memory_order_relaxed);
+    }
+
+    void setMinimumLevel(QmsLogLevel logLevel);
+    QmsLogLevel minimumLevel();
+}
+
+#endif //QMINESWEEPER_QMSLOGLEVEL_HPP
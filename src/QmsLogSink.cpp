@@ -0,0 +1,361 @@
+#include "QmsLogSink.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+std::atomic<QmsLogSink *> logSink{nullptr};
+
+const size_t QmsLogSink::s_RECORD_TEXT_CAPACITY;
+const size_t QmsLogSink::s_RECORD_COUNT{1024};
+const long QmsLogSink::s_MAXIMUM_FILE_SIZE{4 * 1024 * 1024};
+const int QmsLogSink::s_MAXIMUM_ROTATED_FILES{3};
+const size_t QmsLogSink::s_FILE_BUFFER_SIZE{64 * 1024};
+
+QmsLogSink::QmsLogSink(const QString &logFilePath) :
+        m_records{new Record[QmsLogSink::s_RECORD_COUNT]},
+        m_recordMask{QmsLogSink::s_RECORD_COUNT - 1},
+        m_enqueuePosition{0},
+        m_dequeuePosition{0},
+        m_writtenPosition{0},
+        m_droppedCount{0},
+        m_reportedDroppedCount{0},
+        m_consumerSleeping{false},
+        m_stopping{false},
+        m_wakeMutex{},
+        m_wakeCondition{},
+        m_flushCondition{},
+        m_filePath{QFile::encodeName(logFilePath).toStdString()},
+        m_file{nullptr},
+        m_fileSize{0},
+        m_line{},
+        m_thread{} {
+    for (size_t index = 0; index < QmsLogSink::s_RECORD_COUNT; index++) {
+        this->m_records[index].sequence.store(index, std::memory_order_relaxed);
+    }
+    this->m_line.reserve(QmsLogSink::s_RECORD_TEXT_CAPACITY + 32);
+    this->openFile();
+    this->m_thread = std::thread{&QmsLogSink::run, this};
+}
+
+QmsLogSink::~QmsLogSink() {
+    this->stop();
+}
+
+/* initializeInstance() : Not every way out of the program (exit() after an error box) returns
+ * from main(), so whatever is still in the ring is also flushed at exit. That is all that
+ * happens there: the consumer thread is only ever stopped and joined from main() */
+void QmsLogSink::initializeInstance(const QString &logFilePath) {
+    if (logSink.load() == nullptr) {
+        logSink.store(new QmsLogSink{logFilePath});
+        std::atexit(QmsLogSink::flushInstance);
+    }
+}
+
+/* shutdownInstance() : Other threads (the watchdog, the atlas pool) may still be inside push()
+ * with the old pointer, so the sink is stopped but never deleted. Anything logged from here on
+ * is written directly by globalLogHandler(), and anything that still lands in the ring is lost */
+void QmsLogSink::shutdownInstance() {
+    QmsLogSink *sink{logSink.exchange(nullptr)};
+    if (sink) {
+        sink->stop();
+    }
+}
+
+/* flushInstance() : The consumer thread cannot wait for itself, and
+ * a consumer stuck on a write is not waited on for longer than a second */
+void QmsLogSink::flushInstance() {
+    QmsLogSink *sink{logSink.load()};
+    if ((sink) && (std::this_thread::get_id() != sink->m_thread.get_id())) {
+        sink->flush(std::chrono::seconds{1});
+    }
+}
+
+/* stop() : Everything pushed before the sink is stopped is still written out */
+void QmsLogSink::stop() {
+    {
+        std::lock_guard<std::mutex> lock{this->m_wakeMutex};
+        if (this->m_stopping) {
+            return;
+        }
+        this->m_stopping = true;
+    }
+    this->m_wakeCondition.notify_one();
+    this->m_flushCondition.notify_all();
+    if ((this->m_thread.joinable()) && (std::this_thread::get_id() != this->m_thread.get_id())) {
+        this->m_thread.join();
+        if (this->m_file) {
+            std::fclose(this->m_file);
+            this->m_file = nullptr;
+        }
+    }
+}
+
+/* push() : The producer side of the ring (a bounded MPMC queue, of which only one consumer is
+ * used): a slot is claimed by advancing the enqueue position, filled, then published by moving
+ * its sequence number on. A slot still waiting to be drained means the ring is full. Critical and
+ * fatal messages also get the source location, like they used to */
+bool QmsLogSink::push(QtMsgType messageType, const QChar *message, int messageLength,
+                      const char *fileName, int sourceFileLine, const char *functionName) {
+    const qint64 timestamp{QDateTime::currentMSecsSinceEpoch()};
+    size_t position{this->m_enqueuePosition.load(std::memory_order_relaxed)};
+    Record *record{nullptr};
+    for (;;) {
+        record = &this->m_records[position & this->m_recordMask];
+        const size_t sequence{record->sequence.load(std::memory_order_acquire)};
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (this->m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            this->m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = this->m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    record->messageType = messageType;
+    record->timestamp = timestamp;
+    size_t length{QmsLogSink::encodeUtf8(message, messageLength, record->text, QmsLogSink::s_RECORD_TEXT_CAPACITY)};
+    if ((messageType == QtCriticalMsg) || (messageType == QtFatalMsg)) {
+        const int written{std::snprintf(record->text + length, QmsLogSink::s_RECORD_TEXT_CAPACITY - length, " (%s:%d, %s)",
+                                        fileName ? fileName : "", sourceFileLine, functionName ? functionName : "")};
+        if (written > 0) {
+            length = std::min(QmsLogSink::s_RECORD_TEXT_CAPACITY - 1, length + static_cast<size_t>(written));
+        }
+    }
+    record->length = length;
+    record->sequence.store(position + 1, std::memory_order_release);
+    this->wakeConsumer();
+    return true;
+}
+
+/* flush() : Blocks until everything pushed so far has been written and flushed to the file, or
+ * until the timeout passes. Only used before the program aborts or exits, when whatever is still
+ * in the ring would be lost */
+void QmsLogSink::flush(std::chrono::milliseconds timeout) {
+    const size_t target{this->m_enqueuePosition.load(std::memory_order_acquire)};
+    std::unique_lock<std::mutex> lock{this->m_wakeMutex};
+    this->m_wakeCondition.notify_one();
+    this->m_flushCondition.wait_for(lock, timeout, [this, target]() {
+        return this->m_stopping || (this->m_writtenPosition.load(std::memory_order_acquire) >= target);
+    });
+}
+
+uint64_t QmsLogSink::droppedCount() const {
+    return this->m_droppedCount.load(std::memory_order_relaxed);
+}
+
+/* formatLine() : The same format the log always had, "[12:34:56] - [I]: message" */
+std::string QmsLogSink::formatLine(QtMsgType messageType, qint64 timestamp, const char *text, size_t textLength) {
+    const char *levelTag{"[I]"};
+    switch (messageType) {
+        case QtDebugMsg:
+            levelTag = "[D]";
+            break;
+        case QtInfoMsg:
+            levelTag = "[I]";
+            break;
+        case QtWarningMsg:
+            levelTag = "[W]";
+            break;
+        case QtCriticalMsg:
+            levelTag = "[C]";
+            break;
+        case QtFatalMsg:
+            levelTag = "[F]";
+            break;
+    }
+    const QByteArray time{QDateTime::fromMSecsSinceEpoch(timestamp).time().toString().toLatin1()};
+    std::string line{};
+    line.reserve(textLength + 24);
+    line.append("[").append(time.constData(), static_cast<size_t>(time.size())).append("] - ").append(levelTag).append(": ");
+    line.append(text, textLength);
+    if (line.back() != '\n' && line.back() != '\r') {
+        line.push_back('\n');
+    }
+    return line;
+}
+
+/* run() : The consumer thread. With nothing to write it sleeps until a producer wakes it, so
+ * an idle program does not wake up for logging. The sleeping flag is set before the ring is
+ * checked, and read by producers after they publish, so no wake up is missed. A producer that
+ * clears the flag may have published a slot past the next one to drain (another producer is
+ * still filling that in), so the flag is set again every time the consumer goes back to sleep */
+void QmsLogSink::run() {
+    for (;;) {
+        if (this->drain() > 0) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock{this->m_wakeMutex};
+        if (this->m_stopping) {
+            lock.unlock();
+            this->drain();
+            break;
+        }
+        this->m_consumerSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while ((!this->m_stopping) && (!this->hasPendingRecord())) {
+            this->m_wakeCondition.wait(lock);
+            this->m_consumerSleeping.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        this->m_consumerSleeping.store(false);
+    }
+}
+
+void QmsLogSink::wakeConsumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_consumerSleeping.load(std::memory_order_relaxed) && this->m_consumerSleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock{this->m_wakeMutex};
+        this->m_wakeCondition.notify_one();
+    }
+}
+
+bool QmsLogSink::hasPendingRecord() const {
+    const Record &record = this->m_records[this->m_dequeuePosition & this->m_recordMask];
+    return record.sequence.load(std::memory_order_acquire) == (this->m_dequeuePosition + 1);
+}
+
+/* drain() : Each record is formatted and its slot handed back before the line is written,
+ * so producers get room back as early as possible. The file is flushed once per batch */
+size_t QmsLogSink::drain() {
+    size_t drainedCount{0};
+    while (this->hasPendingRecord()) {
+        Record &record = this->m_records[this->m_dequeuePosition & this->m_recordMask];
+        const QtMsgType messageType{record.messageType};
+        this->m_line = QmsLogSink::formatLine(messageType, record.timestamp, record.text, record.length);
+        record.sequence.store(this->m_dequeuePosition + this->m_recordMask + 1, std::memory_order_release);
+        this->m_dequeuePosition++;
+        this->writeLine(messageType, this->m_line);
+        drainedCount++;
+    }
+    const uint64_t droppedCount{this->m_droppedCount.load(std::memory_order_relaxed)};
+    if (droppedCount != this->m_reportedDroppedCount) {
+        const std::string message{std::to_string(droppedCount - this->m_reportedDroppedCount) +
+                                  " log messages were dropped, because the log buffer was full"};
+        this->writeLine(QtWarningMsg, QmsLogSink::formatLine(QtWarningMsg, QDateTime::currentMSecsSinceEpoch(),
+                                                             message.c_str(), message.length()));
+        this->m_reportedDroppedCount = droppedCount;
+        drainedCount++;
+    }
+    if (drainedCount > 0) {
+        if (this->m_file) {
+            std::fflush(this->m_file);
+        }
+        std::cout.flush();
+        {
+            std::lock_guard<std::mutex> lock{this->m_wakeMutex};
+            this->m_writtenPosition.store(this->m_dequeuePosition, std::memory_order_release);
+        }
+        this->m_flushCondition.notify_all();
+    }
+    return drainedCount;
+}
+
+void QmsLogSink::writeLine(QtMsgType messageType, const std::string &line) {
+    std::ostream *outputStream{&std::cout};
+    if (messageType == QtInfoMsg) {
+        outputStream = &std::clog;
+    } else if ((messageType == QtCriticalMsg) || (messageType == QtFatalMsg)) {
+        outputStream = &std::cerr;
+    }
+    outputStream->write(line.data(), static_cast<std::streamsize>(line.length()));
+    if (!this->m_file) {
+        return;
+    }
+    if ((this->m_fileSize > 0) && (this->m_fileSize + static_cast<long>(line.length()) > QmsLogSink::s_MAXIMUM_FILE_SIZE)) {
+        this->rotateFile();
+    }
+    if ((this->m_file) && (std::fwrite(line.data(), 1, line.length(), this->m_file) == line.length())) {
+        this->m_fileSize += static_cast<long>(line.length());
+    }
+}
+
+/* openFile() : A log file that cannot be opened is reported once; the
+ * program keeps running with the console as the only place logs go */
+void QmsLogSink::openFile() {
+    this->m_file = std::fopen(this->m_filePath.c_str(), "a");
+    if (!this->m_file) {
+        std::cerr << "Failed to open log file \"" << this->m_filePath << "\", logging to the console only" << std::endl;
+        return;
+    }
+    std::setvbuf(this->m_file, nullptr, _IOFBF, QmsLogSink::s_FILE_BUFFER_SIZE);
+    std::fseek(this->m_file, 0, SEEK_END);
+    this->m_fileSize = std::max(0L, std::ftell(this->m_file));
+}
+
+/* rotateFile() : file.log becomes file.log.1, file.log.1 becomes file.log.2 and so
+ * on, keeping at most MAXIMUM_ROTATED_FILES() old files next to the current one */
+void QmsLogSink::rotateFile() {
+    std::fclose(this->m_file);
+    this->m_file = nullptr;
+    std::remove((this->m_filePath + "." + std::to_string(QmsLogSink::s_MAXIMUM_ROTATED_FILES)).c_str());
+    for (int index = QmsLogSink::s_MAXIMUM_ROTATED_FILES - 1; index >= 1; index--) {
+        std::rename((this->m_filePath + "." + std::to_string(index)).c_str(),
+                    (this->m_filePath + "." + std::to_string(index + 1)).c_str());
+    }
+    std::rename(this->m_filePath.c_str(), (this->m_filePath + ".1").c_str());
+    this->m_fileSize = 0;
+    this->openFile();
+}
+
+/* encodeUtf8() : QString::toUtf8() allocates, which the producer side must not do. Stops at
+ * the last whole character that fits, always leaving one byte free (for snprintf()'s NUL) */
+size_t QmsLogSink::encodeUtf8(const QChar *message, int messageLength, char *destination, size_t capacity) {
+    size_t length{0};
+    for (int index = 0; index < messageLength; index++) {
+        uint32_t codePoint{message[index].unicode()};
+        if (QChar::isHighSurrogate(codePoint) && ((index + 1) < messageLength) && message[index + 1].isLowSurrogate()) {
+            codePoint = QChar::surrogateToUcs4(static_cast<ushort>(codePoint), message[index + 1].unicode());
+            index++;
+        } else if (QChar::isSurrogate(codePoint)) {
+            codePoint = '?';
+        }
+        char encoded[4];
+        size_t encodedLength{0};
+        if (codePoint < 0x80) {
+            encoded[encodedLength++] = static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            encoded[encodedLength++] = static_cast<char>(0xC0 | (codePoint >> 6));
+            encoded[encodedLength++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            encoded[encodedLength++] = static_cast<char>(0xE0 | (codePoint >> 12));
+            encoded[encodedLength++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            encoded[encodedLength++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            encoded[encodedLength++] = static_cast<char>(0xF0 | (codePoint >> 18));
+            encoded[encodedLength++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            encoded[encodedLength++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            encoded[encodedLength++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        if ((length + encodedLength) >= capacity) {
+            break;
+        }
+        std::memcpy(destination + length, encoded, encodedLength);
+        length += encodedLength;
+    }
+    return length;
+}
+
+size_t QmsLogSink::RECORD_COUNT() {
+    return QmsLogSink::s_RECORD_COUNT;
+}
+
+size_t QmsLogSink::RECORD_TEXT_CAPACITY() {
+    return QmsLogSink::s_RECORD_TEXT_CAPACITY;
+}
+
+long QmsLogSink::MAXIMUM_FILE_SIZE() {
+    return QmsLogSink::s_MAXIMUM_FILE_SIZE;
+}
+
+int QmsLogSink::MAXIMUM_ROTATED_FILES() {
+    return QmsLogSink::s_MAXIMUM_ROTATED_FILES;
+}
@@ -0,0 +1,97 @@
+#ifndef QMINESWEEPER_QMSLOGSINK_HPP
+#define QMINESWEEPER_QMSLOGSINK_HPP
+
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/* QmsLogSink : Where globalLogHandler() sends every message. The calling thread only claims a
+ * slot of a fixed size ring buffer (lock-free, for any number of producers), copies the message
+ * into it as UTF-8 along with a timestamp, and returns; it never allocates, formats a date or
+ * touches a stream. One background thread drains the ring: it formats each record, writes it to
+ * the console and to a buffered log file, and rotates that file once it passes
+ * MAXIMUM_FILE_SIZE(). When the ring is full, messages are dropped rather than waited on, and the
+ * number dropped is written to the log the next time the background thread gets to run */
+class QmsLogSink {
+public:
+    ~QmsLogSink();
+    QmsLogSink(const QmsLogSink &rhs) = delete;
+    QmsLogSink &operator=(const QmsLogSink &rhs) = delete;
+
+    static void initializeInstance(const QString &logFilePath);
+    static void shutdownInstance();
+    static void flushInstance();
+
+    bool push(QtMsgType messageType, const QChar *message, int messageLength,
+              const char *fileName, int sourceFileLine, const char *functionName);
+    void flush(std::chrono::milliseconds timeout);
+    uint64_t droppedCount() const;
+
+    static std::string formatLine(QtMsgType messageType, qint64 timestamp, const char *text, size_t textLength);
+
+    static size_t RECORD_COUNT();
+    static size_t RECORD_TEXT_CAPACITY();
+    static long MAXIMUM_FILE_SIZE();
+    static int MAXIMUM_ROTATED_FILES();
+
+private:
+    static const size_t s_RECORD_TEXT_CAPACITY{480};
+
+    struct Record {
+        std::atomic<size_t> sequence;
+        QtMsgType messageType;
+        qint64 timestamp;
+        size_t length;
+        char text[s_RECORD_TEXT_CAPACITY];
+    };
+
+    std::unique_ptr<Record[]> m_records;
+    size_t m_recordMask;
+    std::atomic<size_t> m_enqueuePosition;
+    size_t m_dequeuePosition;
+    std::atomic<size_t> m_writtenPosition;
+    std::atomic<uint64_t> m_droppedCount;
+    uint64_t m_reportedDroppedCount;
+    std::atomic<bool> m_consumerSleeping;
+    bool m_stopping;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_flushCondition;
+    std::string m_filePath;
+    std::FILE *m_file;
+    long m_fileSize;
+    std::string m_line;
+    std::thread m_thread;
+
+    explicit QmsLogSink(const QString &logFilePath);
+
+    void run();
+    void stop();
+    bool hasPendingRecord() const;
+    size_t drain();
+    void writeLine(QtMsgType messageType, const std::string &line);
+    void openFile();
+    void rotateFile();
+    void wakeConsumer();
+
+    static size_t encodeUtf8(const QChar *message, int messageLength, char *destination, size_t capacity);
+
+    static const size_t s_RECORD_COUNT;
+    static const long s_MAXIMUM_FILE_SIZE;
+    static const int s_MAXIMUM_ROTATED_FILES;
+    static const size_t s_FILE_BUFFER_SIZE;
+};
+
+extern std::atomic<QmsLogSink *> logSink;
+
+#endif //QMINESWEEPER_QMSLOGSINK_HPP
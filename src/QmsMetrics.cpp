@@ -0,0 +1,228 @@
+#include "QmsMetrics.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+QmsMetricsWriter *metricsWriter{nullptr};
+
+const size_t QmsMetricShards::s_SHARD_COUNT;
+std::atomic<size_t> QmsMetricShards::s_nextShard{0};
+const int QmsMetricsWriter::s_DEFAULT_INTERVAL_SECONDS{10};
+
+namespace QmsMetrics {
+    QmsMetricCounter gamesStarted{"games.started"};
+    QmsMetricCounter gamesWon{"games.won"};
+    QmsMetricCounter gamesLost{"games.lost"};
+    QmsMetricCounter cellsRevealed{"cells.revealed"};
+    QmsMetricCounter movesMade{"moves.made"};
+    QmsMetricCounter gamesSaved{"save.count"};
+    QmsMetricCounter bytesSaved{"save.bytes"};
+    QmsMetricCounter gamesLoaded{"load.count"};
+    QmsMetricCounter bytesLoaded{"load.bytes"};
+
+    QmsMetricGauge currentMovesMade{"game.moves_made"};
+    QmsMetricGauge currentUnopenedCells{"game.unopened_cells"};
+    QmsMetricGauge peakResidentSetBytes{"process.peak_rss_bytes"};
+
+    QmsLatencyHistogram cascadeSize{"cascade.cells", QmsLatencyHistogram::Unit::Value};
+}
+
+size_t QmsMetricShards::currentShard() {
+    static thread_local size_t shard{QmsMetricShards::s_nextShard.fetch_add(1, std::memory_order_relaxed) % QmsMetricShards::s_SHARD_COUNT};
+    return shard;
+}
+
+size_t QmsMetricShards::SHARD_COUNT() {
+    return QmsMetricShards::s_SHARD_COUNT;
+}
+
+QmsMetricCounter::QmsMetricCounter(const char *name) :
+        QmsRegistered{},
+        m_name{name},
+        m_shards{} {
+    for (auto &it : this->m_shards) {
+        it.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char *QmsMetricCounter::name() const {
+    return this->m_name;
+}
+
+uint64_t QmsMetricCounter::value() const {
+    uint64_t total{0};
+    for (const auto &it : this->m_shards) {
+        total += it.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+QmsMetricGauge::QmsMetricGauge(const char *name) :
+        QmsRegistered{},
+        m_name{name},
+        m_value{0} {
+
+}
+
+const char *QmsMetricGauge::name() const {
+    return this->m_name;
+}
+
+int64_t QmsMetricGauge::value() const {
+    return this->m_value.load(std::memory_order_relaxed);
+}
+
+QmsMetricsWriter::QmsMetricsWriter(const QString &metricsFilePath, int intervalSeconds) :
+        m_metricsFilePath{metricsFilePath},
+        m_interval{std::max(1, intervalSeconds)},
+        m_previousCounterValues{},
+        m_previousSnapshotTime{std::chrono::steady_clock::now()},
+        m_stopping{false},
+        m_stopMutex{},
+        m_stopCondition{},
+        m_thread{} {
+    this->m_thread = std::thread{&QmsMetricsWriter::run, this};
+}
+
+/* ~QmsMetricsWriter() : The last snapshot is taken after the thread has stopped */
+QmsMetricsWriter::~QmsMetricsWriter() {
+    {
+        std::lock_guard<std::mutex> stopLock{this->m_stopMutex};
+        this->m_stopping = true;
+    }
+    this->m_stopCondition.notify_one();
+    if (this->m_thread.joinable()) {
+        this->m_thread.join();
+    }
+    this->writeSnapshot();
+}
+
+void QmsMetricsWriter::initializeInstance(const QString &metricsFilePath, int intervalSeconds) {
+    if (metricsWriter == nullptr) {
+        metricsWriter = new QmsMetricsWriter{metricsFilePath, intervalSeconds};
+        LOG_INFO() << QString{"Writing a metrics snapshot to %1 every %2 seconds"}.arg(metricsFilePath, QS_NUMBER(std::max(1, intervalSeconds)));
+    }
+}
+
+/* shutdownInstance() : Only called from main() once the event loop has returned. Never from
+ * exit(), which may be running on the writer's own thread, which could then not be joined */
+void QmsMetricsWriter::shutdownInstance() {
+    QmsMetricsWriter *writer{metricsWriter};
+    metricsWriter = nullptr;
+    delete writer;
+}
+
+void QmsMetricsWriter::run() {
+    std::unique_lock<std::mutex> stopLock{this->m_stopMutex};
+    while (!this->m_stopCondition.wait_for(stopLock, this->m_interval, [this]() { return this->m_stopping; })) {
+        stopLock.unlock();
+        this->writeSnapshot();
+        stopLock.lock();
+    }
+}
+
+/* writeSnapshot() : Only ever called by one thread at a time, the writer's own thread while it
+ * runs and the destructor after it has stopped, so the previous counter values need no lock */
+void QmsMetricsWriter::writeSnapshot() {
+    const auto now = std::chrono::steady_clock::now();
+    const QJsonObject snapshot{QmsMetricsWriter::snapshot(now - this->m_previousSnapshotTime, this->m_previousCounterValues)};
+    this->m_previousSnapshotTime = now;
+    QFile metricsFile{this->m_metricsFilePath};
+    if (!metricsFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        LOG_WARNING() << QString{"Could not open metrics file %1 for writing"}.arg(this->m_metricsFilePath);
+        return;
+    }
+    metricsFile.write(QJsonDocument{snapshot}.toJson(QJsonDocument::Compact));
+    metricsFile.write("\n");
+}
+
+/* snapshot() : Every metric as it is now. The rate of each counter is measured from the values
+ * in previousCounterValues, which are then replaced with the ones just read */
+QJsonObject QmsMetricsWriter::snapshot(std::chrono::steady_clock::duration sincePreviousSnapshot,
+                                       std::unordered_map<const QmsMetricCounter *, uint64_t> &previousCounterValues) {
+    QmsMetrics::peakResidentSetBytes.set(QmsMetricsWriter::peakResidentSetBytes());
+    const double elapsedSeconds{std::chrono::duration_cast<std::chrono::duration<double>>(sincePreviousSnapshot).count()};
+
+    QJsonObject counters{};
+    QJsonObject rates{};
+    for (const QmsMetricCounter *it = QmsMetricCounter::first(); it != nullptr; it = it->next()) {
+        const uint64_t value{it->value()};
+        uint64_t &previousValue = previousCounterValues[it];
+        counters.insert(it->name(), static_cast<double>(value));
+        rates.insert(it->name(), (elapsedSeconds > 0.0) ? static_cast<double>(value - previousValue) / elapsedSeconds : 0.0);
+        previousValue = value;
+    }
+    QJsonObject gauges{};
+    for (const QmsMetricGauge *it = QmsMetricGauge::first(); it != nullptr; it = it->next()) {
+        gauges.insert(it->name(), static_cast<double>(it->value()));
+    }
+    QJsonObject histograms{};
+    QJsonObject latencies{};
+    for (const QmsLatencyHistogram *it = QmsLatencyHistogram::first(); it != nullptr; it = it->next()) {
+        if (it->unit() == QmsLatencyHistogram::Unit::Value) {
+            QJsonObject histogram{};
+            histogram.insert("count", static_cast<double>(it->count()));
+            histogram.insert("sum", static_cast<double>(it->sum()));
+            histogram.insert("p50", static_cast<double>(it->percentile(0.50)));
+            histogram.insert("p90", static_cast<double>(it->percentile(0.90)));
+            histogram.insert("p99", static_cast<double>(it->percentile(0.99)));
+            histogram.insert("max", static_cast<double>(it->maximum()));
+            histograms.insert(it->name(), histogram);
+            continue;
+        }
+        QJsonObject latency{};
+        latency.insert("count", static_cast<double>(it->count()));
+        latency.insert("p50Microseconds", static_cast<double>(it->percentile(0.50)));
+        latency.insert("p90Microseconds", static_cast<double>(it->percentile(0.90)));
+        latency.insert("p99Microseconds", static_cast<double>(it->percentile(0.99)));
+        latency.insert("maxMicroseconds", static_cast<double>(it->maximum()));
+        latencies.insert(it->name(), latency);
+    }
+
+    QJsonObject snapshot{};
+    snapshot.insert("timestamp", QDateTime::currentDateTime().toString(Qt::ISODate));
+    snapshot.insert("intervalSeconds", elapsedSeconds);
+    snapshot.insert("counters", counters);
+    snapshot.insert("ratesPerSecond", rates);
+    snapshot.insert("gauges", gauges);
+    snapshot.insert("histograms", histograms);
+    snapshot.insert("latencies", latencies);
+    return snapshot;
+}
+
+/* peakResidentSetBytes() : The most memory the process has had resident at once.
+ * Linux reports it in kilobytes, macOS in bytes */
+int64_t QmsMetricsWriter::peakResidentSetBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memoryCounters{};
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) {
+        return static_cast<int64_t>(memoryCounters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<int64_t>(usage.ru_maxrss);
+#else
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+int QmsMetricsWriter::DEFAULT_INTERVAL_SECONDS() {
+    return QmsMetricsWriter::s_DEFAULT_INTERVAL_SECONDS;
+}
@@ -0,0 +1,137 @@
+#ifndef QMINESWEEPER_QMSMETRICS_HPP
+#define QMINESWEEPER_QMSMETRICS_HPP
+
+#include "QmsRegistry.hpp"
+#include "QmsLatencyHistogram.hpp"
+
+#include <QString>
+#include <QJsonObject>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/* QmsMetricShards : Counters are split into SHARD_COUNT() shards, each on a cache
+ * line of its own, and every thread writes to one of them (handed out in turn the first time a
+ * thread records anything), so threads never contend for a cache line. Reads add the shards up */
+class QmsMetricShards {
+public:
+    static size_t currentShard();
+    static size_t SHARD_COUNT();
+
+private:
+    static const size_t s_SHARD_COUNT{8};
+    static std::atomic<size_t> s_nextShard;
+
+    friend class QmsMetricCounter;
+};
+
+/* QmsMetricCounter : A count that only goes up (games won, cells revealed, bytes saved) */
+class QmsMetricCounter : public QmsRegistered<QmsMetricCounter> {
+public:
+    explicit QmsMetricCounter(const char *name);
+    QmsMetricCounter(const QmsMetricCounter &rhs) = delete;
+    QmsMetricCounter &operator=(const QmsMetricCounter &rhs) = delete;
+
+    inline void add(uint64_t amount = 1) {
+        this->m_shards[QmsMetricShards::currentShard()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    const char *name() const;
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value;
+    };
+
+    const char *m_name;
+    std::array<Shard, QmsMetricShards::s_SHARD_COUNT> m_shards;
+};
+
+/* QmsMetricGauge : A value that is set rather than added to (the moves made in the current
+ * game), so it is a single atomic: the last value set is the one read */
+class QmsMetricGauge : public QmsRegistered<QmsMetricGauge> {
+public:
+    explicit QmsMetricGauge(const char *name);
+    QmsMetricGauge(const QmsMetricGauge &rhs) = delete;
+    QmsMetricGauge &operator=(const QmsMetricGauge &rhs) = delete;
+
+    inline void set(int64_t value) {
+        this->m_value.store(value, std::memory_order_relaxed);
+    }
+
+    const char *name() const;
+    int64_t value() const;
+
+private:
+    const char *m_name;
+    std::atomic<int64_t> m_value;
+};
+
+/* QmsMetricsWriter : With --metrics-file, appends a snapshot of every metric to the file as one
+ * line of JSON every few seconds (and once more when the program quits), from a thread of its
+ * own, so a soak run leaves a trend to look at and a stalled GUI thread does not stall the
+ * snapshots. Each snapshot also carries how fast every counter went up since the one before it,
+ * and the peak RSS */
+class QmsMetricsWriter {
+public:
+    ~QmsMetricsWriter();
+    QmsMetricsWriter(const QmsMetricsWriter &rhs) = delete;
+    QmsMetricsWriter &operator=(const QmsMetricsWriter &rhs) = delete;
+
+    static void initializeInstance(const QString &metricsFilePath, int intervalSeconds);
+    static void shutdownInstance();
+
+    static QJsonObject snapshot(std::chrono::steady_clock::duration sincePreviousSnapshot,
+                                std::unordered_map<const QmsMetricCounter *, uint64_t> &previousCounterValues);
+    static int64_t peakResidentSetBytes();
+
+    static int DEFAULT_INTERVAL_SECONDS();
+
+private:
+    QString m_metricsFilePath;
+    std::chrono::seconds m_interval;
+    std::unordered_map<const QmsMetricCounter *, uint64_t> m_previousCounterValues;
+    std::chrono::steady_clock::time_point m_previousSnapshotTime;
+    bool m_stopping;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    std::thread m_thread;
+
+    QmsMetricsWriter(const QString &metricsFilePath, int intervalSeconds);
+
+    void run();
+    void writeSnapshot();
+
+    static const int s_DEFAULT_INTERVAL_SECONDS;
+};
+
+/* QmsMetrics : Everything the game publishes. They are defined in one place, rather than as
+ * function statics like the latency histograms, as most of them are updated from several */
+namespace QmsMetrics {
+    extern QmsMetricCounter gamesStarted;
+    extern QmsMetricCounter gamesWon;
+    extern QmsMetricCounter gamesLost;
+    extern QmsMetricCounter cellsRevealed;
+    extern QmsMetricCounter movesMade;
+    extern QmsMetricCounter gamesSaved;
+    extern QmsMetricCounter bytesSaved;
+    extern QmsMetricCounter gamesLoaded;
+    extern QmsMetricCounter bytesLoaded;
+
+    extern QmsMetricGauge currentMovesMade;
+    extern QmsMetricGauge currentUnopenedCells;
+    extern QmsMetricGauge peakResidentSetBytes;
+
+    extern QmsLatencyHistogram cascadeSize;
+}
+
+extern QmsMetricsWriter *metricsWriter;
+
+#endif //QMINESWEEPER_QMSMETRICS_HPP
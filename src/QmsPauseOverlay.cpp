@@ -0,0 +1,56 @@
+#include "QmsPauseOverlay.hpp"
+#include "QmsStrings.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+
+QmsPauseOverlay::QmsPauseOverlay(QWidget *parent) :
+        QWidget{parent} {
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+    this->setAttribute(Qt::WA_NoSystemBackground);
+    this->setGeometry(parent->rect());
+    parent->installEventFilter(this);
+    this->hide();
+}
+
+/* setPaused() : Raised on every show, because buttons added to the
+ * mine field after the overlay was created are stacked above it */
+void QmsPauseOverlay::setPaused(bool paused) {
+    if (paused) {
+        this->setGeometry(this->parentWidget()->rect());
+        this->raise();
+        this->show();
+    } else {
+        this->hide();
+    }
+}
+
+/* eventFilter() : Follows the size of the mine field, which is not laid out by a layout */
+bool QmsPauseOverlay::eventFilter(QObject *watched, QEvent *event) {
+    if ((watched == this->parentWidget()) && (event->type() == QEvent::Resize) && this->isVisible()) {
+        this->setGeometry(this->parentWidget()->rect());
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void QmsPauseOverlay::paintEvent(QPaintEvent *paintEvent) {
+    QPainter painter{this};
+    painter.fillRect(paintEvent->rect(), this->palette().window());
+    QFont pausedFont{this->font()};
+    if (pausedFont.pointSize() > 0) {
+        pausedFont.setPointSize(pausedFont.pointSize() * 2);
+    }
+    pausedFont.setBold(true);
+    painter.setFont(pausedFont);
+    painter.setPen(this->palette().windowText().color());
+    painter.drawText(this->rect(), Qt::AlignCenter, QmsPauseOverlay::tr(QmsStrings::GAME_PAUSED_OVERLAY_TEXT));
+}
+
+void QmsPauseOverlay::mousePressEvent(QMouseEvent *mouseEvent) {
+    mouseEvent->accept();
+}
+
+void QmsPauseOverlay::mouseReleaseEvent(QMouseEvent *mouseEvent) {
+    mouseEvent->accept();
+}
@@ -0,0 +1,28 @@
+#ifndef QMINESWEEPER_QMSPAUSEOVERLAY_HPP
+#define QMINESWEEPER_QMSPAUSEOVERLAY_HPP
+
+#include <QWidget>
+
+class QPaintEvent;
+class QMouseEvent;
+
+/* QmsPauseOverlay : An opaque widget covering the mine field while the game is paused.
+ * Being a single child on top of the QmsButtons, showing or hiding it costs the same
+ * for any size of board: it takes every click meant for the board, and since it paints
+ * all of its pixels, none of the buttons underneath are repainted while it is shown */
+class QmsPauseOverlay : public QWidget {
+Q_OBJECT
+public:
+    explicit QmsPauseOverlay(QWidget *parent);
+    ~QmsPauseOverlay() override = default;
+
+    void setPaused(bool paused);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    void paintEvent(QPaintEvent *paintEvent) override;
+    void mousePressEvent(QMouseEvent *mouseEvent) override;
+    void mouseReleaseEvent(QMouseEvent *mouseEvent) override;
+};
+
+#endif //QMINESWEEPER_QMSPAUSEOVERLAY_HPP
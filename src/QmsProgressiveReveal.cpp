@@ -0,0 +1,165 @@
+#include "QmsProgressiveReveal.hpp"
+#include "QmsButton.hpp"
+#include "QmsIconAtlas.hpp"
+#include "QmsInstrumentation.hpp"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdlib>
+
+const int QmsProgressiveReveal::s_FRAME_BUDGET{4};
+const int QmsProgressiveReveal::s_FRAME_INTERVAL{16};
+const int QmsProgressiveReveal::s_RIPPLE_DURATION{400};
+const int QmsProgressiveReveal::s_CELLS_PER_BUDGET_CHECK{32};
+
+QmsProgressiveReveal::QmsProgressiveReveal(QObject *parent) :
+        QObject{parent},
+        m_rings{},
+        m_pendingCount{0},
+        m_currentRing{0},
+        m_currentIndex{0},
+        m_ringLimit{0},
+        m_ringsPerFrame{0},
+        m_originColumn{0},
+        m_originRow{0},
+        m_rippleEnabled{false},
+        m_frameTimer{} {
+    this->m_frameTimer.setSingleShot(true);
+    connect(&this->m_frameTimer, &QTimer::timeout, this, &QmsProgressiveReveal::applyNextSlice);
+}
+
+/* enqueue() : The first slice is applied on the next pass of the event loop, which for any
+ * cascade that fits in the frame budget means the whole reveal shows up at once. With the
+ * ripple enabled, a cell queued while an earlier ripple is still spreading joins the ring
+ * being applied if its own ring has already gone by */
+void QmsProgressiveReveal::enqueue(QmsButton *msbp) {
+    if (this->m_pendingCount == 0) {
+        this->m_originColumn = msbp->columnIndex();
+        this->m_originRow = msbp->rowIndex();
+    }
+    size_t ring{0};
+    if (this->m_rippleEnabled) {
+        ring = static_cast<size_t>(std::max(std::abs(msbp->columnIndex() - this->m_originColumn),
+                                            std::abs(msbp->rowIndex() - this->m_originRow)));
+        ring = std::max(ring, this->m_currentRing);
+    }
+    if (ring >= this->m_rings.size()) {
+        this->m_rings.resize(ring + 1);
+    }
+    this->m_rings[ring].push_back(msbp);
+    this->m_pendingCount++;
+    if (!this->m_frameTimer.isActive()) {
+        this->m_frameTimer.start(0);
+    }
+}
+
+/* finish() : Applies every cell still queued right away. Called before anything else
+ * changes how the board looks (the end of a game, an undo), so it never works from
+ * buttons that are still missing part of a reveal */
+void QmsProgressiveReveal::finish() {
+    if (this->m_pendingCount == 0) {
+        return;
+    }
+    for (size_t ringIndex = this->m_currentRing; ringIndex < this->m_rings.size(); ringIndex++) {
+        const auto &ring = this->m_rings[ringIndex];
+        for (size_t index = (ringIndex == this->m_currentRing ? this->m_currentIndex : 0); index < ring.size(); index++) {
+            QmsProgressiveReveal::applyReveal(ring[index]);
+        }
+    }
+    this->reset();
+}
+
+/* cancel() : Drops every cell still queued, for when the buttons are about to be reset */
+void QmsProgressiveReveal::cancel() {
+    this->reset();
+}
+
+bool QmsProgressiveReveal::isPending() const {
+    return this->m_pendingCount > 0;
+}
+
+void QmsProgressiveReveal::setRippleEnabled(bool rippleEnabled) {
+    if (rippleEnabled != this->m_rippleEnabled) {
+        this->finish();
+        this->m_rippleEnabled = rippleEnabled;
+    }
+}
+
+bool QmsProgressiveReveal::rippleEnabled() const {
+    return this->m_rippleEnabled;
+}
+
+/* applyNextSlice() : Applying a single cell is cheap, so the budget is only checked
+ * every few cells. With the ripple enabled, each frame also lets the ripple spread by
+ * enough rings to cover the whole cascade in about RIPPLE_DURATION() milliseconds */
+void QmsProgressiveReveal::applyNextSlice() {
+    QMS_INSTRUMENT_SCOPE("Reveal slice");
+    QElapsedTimer sliceTimer{};
+    sliceTimer.start();
+    if (this->m_rippleEnabled) {
+        if (this->m_ringsPerFrame == 0) {
+            const size_t ringCount{this->m_rings.size()};
+            this->m_ringsPerFrame = std::max<size_t>(1, (ringCount * QmsProgressiveReveal::s_FRAME_INTERVAL) /
+                                                        QmsProgressiveReveal::s_RIPPLE_DURATION);
+            this->m_ringLimit = 0;
+        } else {
+            this->m_ringLimit += this->m_ringsPerFrame;
+        }
+    } else {
+        this->m_ringLimit = this->m_rings.size();
+    }
+    int cellsSinceBudgetCheck{0};
+    while ((this->m_currentRing < this->m_rings.size()) && (this->m_currentRing <= this->m_ringLimit)) {
+        auto &ring = this->m_rings[this->m_currentRing];
+        while (this->m_currentIndex < ring.size()) {
+            QmsProgressiveReveal::applyReveal(ring[this->m_currentIndex++]);
+            this->m_pendingCount--;
+            if (++cellsSinceBudgetCheck == QmsProgressiveReveal::s_CELLS_PER_BUDGET_CHECK) {
+                cellsSinceBudgetCheck = 0;
+                if (sliceTimer.elapsed() >= QmsProgressiveReveal::s_FRAME_BUDGET) {
+                    this->m_frameTimer.start(QmsProgressiveReveal::s_FRAME_INTERVAL);
+                    return;
+                }
+            }
+        }
+        std::vector<QmsButton *>{}.swap(ring);
+        this->m_currentRing++;
+        this->m_currentIndex = 0;
+    }
+    if (this->m_pendingCount == 0) {
+        this->reset();
+    } else {
+        this->m_frameTimer.start(QmsProgressiveReveal::s_FRAME_INTERVAL);
+    }
+}
+
+void QmsProgressiveReveal::reset() {
+    this->m_frameTimer.stop();
+    this->m_rings.clear();
+    this->m_pendingCount = 0;
+    this->m_currentRing = 0;
+    this->m_currentIndex = 0;
+    this->m_ringLimit = 0;
+    this->m_ringsPerFrame = 0;
+}
+
+/* applyReveal() : How a revealed cell looks, whether it was just uncovered or restored
+ * from a saved game or an undo */
+void QmsProgressiveReveal::applyReveal(QmsButton *msbp) {
+    msbp->setGlyph(QmsIconAtlas::countGlyph(msbp->numberOfSurroundingMines()));
+    msbp->setFlat(true);
+    msbp->setChecked(true);
+}
+
+int QmsProgressiveReveal::FRAME_BUDGET() {
+    return QmsProgressiveReveal::s_FRAME_BUDGET;
+}
+
+int QmsProgressiveReveal::FRAME_INTERVAL() {
+    return QmsProgressiveReveal::s_FRAME_INTERVAL;
+}
+
+int QmsProgressiveReveal::RIPPLE_DURATION() {
+    return QmsProgressiveReveal::s_RIPPLE_DURATION;
+}
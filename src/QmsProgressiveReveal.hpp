@@ -0,0 +1,60 @@
+#ifndef QMINESWEEPER_QMSPROGRESSIVEREVEAL_HPP
+#define QMINESWEEPER_QMSPROGRESSIVEREVEAL_HPP
+
+#include <QObject>
+#include <QTimer>
+
+#include <vector>
+
+class QmsButton;
+
+/* QmsProgressiveReveal : Applies revealed cells to their QmsButtons (count glyph, flat and
+ * checked) a slice at a time, spending at most FRAME_BUDGET() milliseconds per frame, so a
+ * click that opens a huge cascade does not freeze the UI until every cell is drawn. The game
+ * logic has already revealed the cells by the time they are queued here, only their looks
+ * are deferred. With the ripple enabled, cells are applied in rings around the first cell
+ * queued (the one that was clicked), spreading out over about RIPPLE_DURATION() milliseconds */
+class QmsProgressiveReveal : public QObject {
+Q_OBJECT
+public:
+    explicit QmsProgressiveReveal(QObject *parent = nullptr);
+    ~QmsProgressiveReveal() override = default;
+    QmsProgressiveReveal(const QmsProgressiveReveal &rhs) = delete;
+    QmsProgressiveReveal &operator=(const QmsProgressiveReveal &rhs) = delete;
+
+    void enqueue(QmsButton *msbp);
+    void finish();
+    void cancel();
+    bool isPending() const;
+    void setRippleEnabled(bool rippleEnabled);
+    bool rippleEnabled() const;
+
+    static void applyReveal(QmsButton *msbp);
+    static int FRAME_BUDGET();
+    static int FRAME_INTERVAL();
+    static int RIPPLE_DURATION();
+
+private slots:
+    void applyNextSlice();
+
+private:
+    std::vector<std::vector<QmsButton *>> m_rings;
+    size_t m_pendingCount;
+    size_t m_currentRing;
+    size_t m_currentIndex;
+    size_t m_ringLimit;
+    size_t m_ringsPerFrame;
+    int m_originColumn;
+    int m_originRow;
+    bool m_rippleEnabled;
+    QTimer m_frameTimer;
+
+    void reset();
+
+    static const int s_FRAME_BUDGET;
+    static const int s_FRAME_INTERVAL;
+    static const int s_RIPPLE_DURATION;
+    static const int s_CELLS_PER_BUDGET_CHECK;
+};
+
+#endif //QMINESWEEPER_QMSPROGRESSIVEREVEAL_HPP
@@ -0,0 +1,43 @@
+#ifndef QMINESWEEPER_QMSREGISTRY_HPP
+#define QMINESWEEPER_QMSREGISTRY_HPP
+
+#include <atomic>
+
+/* QmsRegistered : The base of everything that is reported on without being handed to a
+ * reporter: allocation regions, latency histograms and metrics. Each one links itself into a
+ * list of its type when it is constructed, without allocating and without a lock, so they can
+ * be function statics or globals in any translation unit, and are never removed. The list head
+ * is constant initialized, so globals can link themselves in during dynamic initialization */
+template<typename EntryType>
+class QmsRegistered {
+public:
+    QmsRegistered(const QmsRegistered &rhs) = delete;
+    QmsRegistered &operator=(const QmsRegistered &rhs) = delete;
+
+    inline const EntryType *next() const {
+        return static_cast<const EntryType *>(this->m_next);
+    }
+
+    static inline const EntryType *first() {
+        return static_cast<const EntryType *>(QmsRegistered::s_first.load(std::memory_order_acquire));
+    }
+
+protected:
+    inline QmsRegistered() :
+            m_next{QmsRegistered::s_first.load(std::memory_order_relaxed)} {
+        while (!QmsRegistered::s_first.compare_exchange_weak(this->m_next, this, std::memory_order_release,
+                                                             std::memory_order_relaxed)) {}
+    }
+
+    ~QmsRegistered() = default;
+
+private:
+    QmsRegistered *m_next;
+
+    static std::atomic<QmsRegistered *> s_first;
+};
+
+template<typename EntryType>
+std::atomic<QmsRegistered<EntryType> *> QmsRegistered<EntryType>::s_first{nullptr};
+
+#endif //QMINESWEEPER_QMSREGISTRY_HPP
@@ -0,0 +1,210 @@
+#include "QmsReplay.hpp"
+#include "QmsVarInt.hpp"
+
+#include <QFile>
+#include <QString>
+
+#include <algorithm>
+#include <cstring>
+
+const char *const QmsReplay::s_MAGIC_NUMBER{"QMSR"};
+const uint8_t QmsReplay::s_FORMAT_VERSION{1};
+const int QmsReplay::s_MAXIMUM_DIMENSION{4096};
+
+QmsReplay::QmsReplay() :
+        QmsReplay{0, 0} {
+
+}
+
+QmsReplay::QmsReplay(int columnCount, int rowCount) :
+        m_numberOfColumns{columnCount},
+        m_numberOfRows{rowCount},
+        m_mineCells{},
+        m_events{} {
+
+}
+
+int QmsReplay::numberOfColumns() const {
+    return this->m_numberOfColumns;
+}
+
+int QmsReplay::numberOfRows() const {
+    return this->m_numberOfRows;
+}
+
+const std::vector<int> &QmsReplay::mineCells() const {
+    return this->m_mineCells;
+}
+
+void QmsReplay::setMineCells(std::vector<int> mineCells) {
+    std::sort(mineCells.begin(), mineCells.end());
+    mineCells.erase(std::unique(mineCells.begin(), mineCells.end()), mineCells.end());
+    this->m_mineCells = std::move(mineCells);
+}
+
+const std::vector<QmsReplayEvent> &QmsReplay::events() const {
+    return this->m_events;
+}
+
+/* appendEvent() : Timestamps never go backwards, so the
+ * delta encoding and the player's seeking can rely on it */
+void QmsReplay::appendEvent(const QmsReplayEvent &event) {
+    QmsReplayEvent appendedEvent{event};
+    if (!this->m_events.empty()) {
+        appendedEvent.timestamp = std::max(appendedEvent.timestamp, this->m_events.back().timestamp);
+    }
+    this->m_events.push_back(appendedEvent);
+}
+
+int64_t QmsReplay::duration() const {
+    return (this->m_events.empty() ? 0 : this->m_events.back().timestamp);
+}
+
+bool QmsReplay::isEmpty() const {
+    return this->m_events.empty();
+}
+
+std::vector<uint8_t> QmsReplay::encode() const {
+    std::vector<uint8_t> output{};
+    output.reserve(16 + this->m_mineCells.size() * 2 + this->m_events.size() * 4);
+    output.insert(output.end(), s_MAGIC_NUMBER, s_MAGIC_NUMBER + std::strlen(s_MAGIC_NUMBER));
+    output.push_back(s_FORMAT_VERSION);
+    QmsVarInt::encode(output, static_cast<uint64_t>(this->m_numberOfColumns));
+    QmsVarInt::encode(output, static_cast<uint64_t>(this->m_numberOfRows));
+
+    QmsVarInt::encode(output, this->m_mineCells.size());
+    int previousMineCell{-1};
+    for (const auto &it : this->m_mineCells) {
+        QmsVarInt::encode(output, static_cast<uint64_t>(it - previousMineCell - 1));
+        previousMineCell = it;
+    }
+
+    QmsVarInt::encode(output, this->m_events.size());
+    int64_t previousTimestamp{0};
+    int previousCellIndex{0};
+    for (const auto &it : this->m_events) {
+        QmsVarInt::encode(output, static_cast<uint64_t>(it.timestamp - previousTimestamp));
+        output.push_back(static_cast<uint8_t>(it.kind));
+        QmsVarInt::encodeSigned(output, static_cast<int64_t>(it.cellIndex) - previousCellIndex);
+        previousTimestamp = it.timestamp;
+        previousCellIndex = it.cellIndex;
+    }
+    return output;
+}
+
+/* decode() : Every count and index is checked against the board and against the bytes
+ * left before anything is allocated, so a truncated or hostile file is rejected rather
+ * than producing a replay that would reference cells that do not exist */
+bool QmsReplay::decode(const uint8_t *data, size_t size, QmsReplay &targetReplay) {
+    const size_t magicNumberLength{std::strlen(s_MAGIC_NUMBER)};
+    if ((size < magicNumberLength + 1) || (std::memcmp(data, s_MAGIC_NUMBER, magicNumberLength) != 0) ||
+        (data[magicNumberLength] != s_FORMAT_VERSION)) {
+        return false;
+    }
+    const uint8_t *cursor{data + magicNumberLength + 1};
+    const uint8_t *end{data + size};
+
+    uint64_t columnCount{0};
+    uint64_t rowCount{0};
+    if (!QmsVarInt::decode(cursor, end, columnCount) || !QmsVarInt::decode(cursor, end, rowCount) ||
+        (columnCount == 0) || (rowCount == 0) ||
+        (columnCount > static_cast<uint64_t>(s_MAXIMUM_DIMENSION)) ||
+        (rowCount > static_cast<uint64_t>(s_MAXIMUM_DIMENSION))) {
+        return false;
+    }
+    QmsReplay decodedReplay{static_cast<int>(columnCount), static_cast<int>(rowCount)};
+    const uint64_t cellCount{columnCount * rowCount};
+
+    uint64_t mineCount{0};
+    if (!QmsVarInt::decode(cursor, end, mineCount) || (mineCount >= cellCount) ||
+        (mineCount > static_cast<uint64_t>(end - cursor))) {
+        return false;
+    }
+    decodedReplay.m_mineCells.reserve(static_cast<size_t>(mineCount));
+    uint64_t nextMineCell{0};
+    for (uint64_t i = 0; i < mineCount; i++) {
+        uint64_t gap{0};
+        if (!QmsVarInt::decode(cursor, end, gap) || (gap >= cellCount - nextMineCell)) {
+            return false;
+        }
+        nextMineCell += gap;
+        decodedReplay.m_mineCells.push_back(static_cast<int>(nextMineCell));
+        nextMineCell++;
+    }
+
+    //Each event takes at least three bytes (time, kind, cell)
+    uint64_t eventCount{0};
+    if (!QmsVarInt::decode(cursor, end, eventCount) || (eventCount > static_cast<uint64_t>(end - cursor) / 3)) {
+        return false;
+    }
+    decodedReplay.m_events.reserve(static_cast<size_t>(eventCount));
+    int64_t timestamp{0};
+    int64_t cellIndex{0};
+    for (uint64_t i = 0; i < eventCount; i++) {
+        uint64_t timeDelta{0};
+        int64_t cellDelta{0};
+        if (!QmsVarInt::decode(cursor, end, timeDelta) || (timeDelta > (static_cast<uint64_t>(1) << 40)) ||
+            (cursor == end) || (*cursor > static_cast<uint8_t>(ReplayEventKind::Redo))) {
+            return false;
+        }
+        const auto kind = static_cast<ReplayEventKind>(*cursor++);
+        if (!QmsVarInt::decodeSigned(cursor, end, cellDelta)) {
+            return false;
+        }
+        timestamp += static_cast<int64_t>(timeDelta);
+        cellIndex += cellDelta;
+        if ((cellIndex < 0) || (static_cast<uint64_t>(cellIndex) >= cellCount)) {
+            return false;
+        }
+        decodedReplay.m_events.push_back(QmsReplayEvent{timestamp, kind, static_cast<int>(cellIndex)});
+    }
+    if (cursor != end) {
+        return false;
+    }
+    targetReplay = std::move(decodedReplay);
+    return true;
+}
+
+std::pair<SaveReplayResult, std::string> QmsReplay::saveToFile(const QString &filePath) const {
+    QFile outputFile{filePath};
+    if (!outputFile.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Truncate)) {
+        return std::make_pair(SaveReplayResult::UnableToOpenFile, QString{"Could not open file \"%1\" (permission problem?)"}.arg(filePath).toStdString());
+    }
+    const std::vector<uint8_t> encodedReplay{this->encode()};
+    const auto bytesWritten = outputFile.write(reinterpret_cast<const char *>(encodedReplay.data()),
+                                               static_cast<qint64>(encodedReplay.size()));
+    outputFile.close();
+    if (bytesWritten != static_cast<qint64>(encodedReplay.size())) {
+        return std::make_pair(SaveReplayResult::UnableToWriteFile, QString{"Could not write to file \"%1\" (%2)"}.arg(filePath, outputFile.errorString()).toStdString());
+    }
+    return std::make_pair(SaveReplayResult::Success, "");
+}
+
+std::pair<LoadReplayResult, std::string> QmsReplay::loadFromFile(const QString &filePath, QmsReplay &targetReplay) {
+    QFile inputFile{filePath};
+    if (!inputFile.exists()) {
+        return std::make_pair(LoadReplayResult::FileDoesNotExist, QString{"File \"%1\" does not exist"}.arg(filePath).toStdString());
+    }
+    if (!inputFile.open(QIODevice::OpenModeFlag::ReadOnly)) {
+        return std::make_pair(LoadReplayResult::UnableToOpenFile, QString{"Could not open file \"%1\""}.arg(filePath).toStdString());
+    }
+    const QByteArray fileContents{inputFile.readAll()};
+    inputFile.close();
+    if (!QmsReplay::decode(reinterpret_cast<const uint8_t *>(fileContents.constData()),
+                           static_cast<size_t>(fileContents.size()), targetReplay)) {
+        return std::make_pair(LoadReplayResult::InvalidFormat, QString{"File \"%1\" is not a valid replay"}.arg(filePath).toStdString());
+    }
+    return std::make_pair(LoadReplayResult::Success, "");
+}
+
+const char *QmsReplay::MAGIC_NUMBER() {
+    return QmsReplay::s_MAGIC_NUMBER;
+}
+
+uint8_t QmsReplay::FORMAT_VERSION() {
+    return QmsReplay::s_FORMAT_VERSION;
+}
+
+int QmsReplay::MAXIMUM_DIMENSION() {
+    return QmsReplay::s_MAXIMUM_DIMENSION;
+}
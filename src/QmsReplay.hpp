@@ -0,0 +1,84 @@
+#ifndef QMINESWEEPER_QMSREPLAY_HPP
+#define QMINESWEEPER_QMSREPLAY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QString;
+
+/* ReplayEventKind : One per BoardInputKind, plus the Edit menu actions */
+enum class ReplayEventKind : uint8_t {
+    LeftClicked,
+    RightClicked,
+    LeftClickReleased,
+    RightClickReleased,
+    LongLeftClickReleased,
+    LongRightClickReleased,
+    Undo,
+    Redo
+};
+
+struct QmsReplayEvent {
+    int64_t timestamp;
+    ReplayEventKind kind;
+    int cellIndex;
+};
+
+enum class SaveReplayResult {
+    Success,
+    UnableToOpenFile,
+    UnableToWriteFile
+};
+
+enum class LoadReplayResult {
+    Success,
+    FileDoesNotExist,
+    UnableToOpenFile,
+    InvalidFormat
+};
+
+/* QmsReplay : A recorded game, being the board size, the mine layout (as sorted cell
+ * indices) and every player input with its time in milliseconds since the first one.
+ * On disk, after a magic number and version byte, everything is a varint: mines are
+ * stored as gaps from the previous mine, and each event as the time since the previous
+ * event, its kind and the zigzag distance from the previous event's cell. A typical
+ * event costs three or four bytes, so a whole game fits in a few kilobytes */
+class QmsReplay {
+public:
+    QmsReplay();
+    QmsReplay(int columnCount, int rowCount);
+
+    int numberOfColumns() const;
+    int numberOfRows() const;
+    const std::vector<int> &mineCells() const;
+    void setMineCells(std::vector<int> mineCells);
+    const std::vector<QmsReplayEvent> &events() const;
+    void appendEvent(const QmsReplayEvent &event);
+    int64_t duration() const;
+    bool isEmpty() const;
+
+    std::vector<uint8_t> encode() const;
+    static bool decode(const uint8_t *data, size_t size, QmsReplay &targetReplay);
+
+    std::pair<SaveReplayResult, std::string> saveToFile(const QString &filePath) const;
+    static std::pair<LoadReplayResult, std::string> loadFromFile(const QString &filePath, QmsReplay &targetReplay);
+
+    static const char *MAGIC_NUMBER();
+    static uint8_t FORMAT_VERSION();
+    static int MAXIMUM_DIMENSION();
+
+private:
+    int m_numberOfColumns;
+    int m_numberOfRows;
+    std::vector<int> m_mineCells;
+    std::vector<QmsReplayEvent> m_events;
+
+    static const char *const s_MAGIC_NUMBER;
+    static const uint8_t s_FORMAT_VERSION;
+    static const int s_MAXIMUM_DIMENSION;
+};
+
+#endif //QMINESWEEPER_QMSREPLAY_HPP
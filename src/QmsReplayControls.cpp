@@ -0,0 +1,84 @@
+#include "QmsReplayControls.hpp"
+#include "QmsReplayPlayer.hpp"
+
+#include <QPushButton>
+#include <QComboBox>
+#include <QSlider>
+#include <QLabel>
+#include <QHBoxLayout>
+
+#include <algorithm>
+#include <limits>
+
+QmsReplayControls::QmsReplayControls(QmsReplayPlayer *player, QWidget *parent) :
+        QWidget{parent},
+        m_player{player},
+        m_layout{new QHBoxLayout{}},
+        m_playPauseButton{new QPushButton{}},
+        m_speedComboBox{new QComboBox{}},
+        m_seekSlider{new QSlider{Qt::Orientation::Horizontal}},
+        m_timeLabel{new QLabel{}},
+        m_closeButton{new QPushButton{}} {
+
+    this->m_playPauseButton->setText(QmsReplayControls::tr("Play"));
+    this->m_closeButton->setText(QmsReplayControls::tr("Close Replay"));
+    for (const auto &it : {1, 2, 5, 10, 25, 50, 100}) {
+        if ((it >= QmsReplayPlayer::MINIMUM_SPEED()) && (it <= QmsReplayPlayer::MAXIMUM_SPEED())) {
+            this->m_speedComboBox->addItem(QString{"%1x"}.arg(it), it);
+        }
+    }
+    this->m_seekSlider->setRange(0, static_cast<int>(std::min(player->duration(),
+                                                              static_cast<int64_t>(std::numeric_limits<int>::max()))));
+    this->m_seekSlider->setMinimumWidth(150);
+    this->onPositionChanged(player->position());
+
+    this->m_layout->setContentsMargins(0, 0, 0, 0);
+    this->m_layout->addWidget(this->m_playPauseButton.get());
+    this->m_layout->addWidget(this->m_speedComboBox.get());
+    this->m_layout->addWidget(this->m_seekSlider.get());
+    this->m_layout->addWidget(this->m_timeLabel.get());
+    this->m_layout->addWidget(this->m_closeButton.get());
+    this->setLayout(this->m_layout.get());
+
+    connect(this->m_playPauseButton.get(), &QPushButton::clicked, this, &QmsReplayControls::onPlayPauseClicked);
+    connect(this->m_speedComboBox.get(), static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &QmsReplayControls::onSpeedSelected);
+    connect(this->m_seekSlider.get(), &QSlider::sliderMoved, player, &QmsReplayPlayer::seek);
+    connect(this->m_closeButton.get(), &QPushButton::clicked, this, &QmsReplayControls::closeRequested);
+    connect(player, &QmsReplayPlayer::positionChanged, this, &QmsReplayControls::onPositionChanged);
+    connect(player, &QmsReplayPlayer::playingChanged, this, &QmsReplayControls::onPlayingChanged);
+}
+
+QmsReplayControls::~QmsReplayControls() = default;
+
+void QmsReplayControls::onPlayPauseClicked() {
+    if (this->m_player->isPlaying()) {
+        this->m_player->pause();
+    } else {
+        this->m_player->play();
+    }
+}
+
+void QmsReplayControls::onSpeedSelected(int index) {
+    this->m_player->setSpeed(this->m_speedComboBox->itemData(index).toInt());
+}
+
+/* onPositionChanged() : The slider is only moved while the user is not dragging
+ * it, so playback does not fight with a seek that is in progress */
+void QmsReplayControls::onPositionChanged(qint64 position) {
+    if (!this->m_seekSlider->isSliderDown()) {
+        this->m_seekSlider->setValue(static_cast<int>(std::min(position, static_cast<qint64>(std::numeric_limits<int>::max()))));
+    }
+    this->m_timeLabel->setText(QString{"%1 / %2"}.arg(QmsReplayControls::formatTime(position),
+                                                      QmsReplayControls::formatTime(this->m_player->duration())));
+}
+
+void QmsReplayControls::onPlayingChanged(bool isPlaying) {
+    this->m_playPauseButton->setText(isPlaying ? QmsReplayControls::tr("Pause") : QmsReplayControls::tr("Play"));
+}
+
+QString QmsReplayControls::formatTime(qint64 milliseconds) {
+    return QString{"%1:%2.%3"}.arg(QString::number(milliseconds / 60000),
+                                   QString::number((milliseconds / 1000) % 60).rightJustified(2, '0'),
+                                   QString::number((milliseconds / 100) % 10));
+}
@@ -0,0 +1,44 @@
+#ifndef QMINESWEEPER_QMSREPLAYCONTROLS_HPP
+#define QMINESWEEPER_QMSREPLAYCONTROLS_HPP
+
+#include <QWidget>
+
+#include <memory>
+
+class QmsReplayPlayer;
+class QPushButton;
+class QComboBox;
+class QSlider;
+class QLabel;
+class QHBoxLayout;
+
+/* QmsReplayControls : Play/pause, speed and seek controls for a QmsReplayPlayer,
+ * shown in the status bar for as long as a replay is being watched */
+class QmsReplayControls : public QWidget {
+Q_OBJECT
+public:
+    explicit QmsReplayControls(QmsReplayPlayer *player, QWidget *parent = nullptr);
+    ~QmsReplayControls() override;
+
+signals:
+    void closeRequested();
+
+private slots:
+    void onPlayPauseClicked();
+    void onSpeedSelected(int index);
+    void onPositionChanged(qint64 position);
+    void onPlayingChanged(bool isPlaying);
+
+private:
+    QmsReplayPlayer *m_player;
+    std::unique_ptr<QHBoxLayout> m_layout;
+    std::unique_ptr<QPushButton> m_playPauseButton;
+    std::unique_ptr<QComboBox> m_speedComboBox;
+    std::unique_ptr<QSlider> m_seekSlider;
+    std::unique_ptr<QLabel> m_timeLabel;
+    std::unique_ptr<QPushButton> m_closeButton;
+
+    static QString formatTime(qint64 milliseconds);
+};
+
+#endif //QMINESWEEPER_QMSREPLAYCONTROLS_HPP
@@ -0,0 +1,154 @@
+#include "QmsReplayPlayer.hpp"
+#include "QmsReplaySimulator.hpp"
+#include "GameController.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <algorithm>
+
+const int QmsReplayPlayer::s_MINIMUM_SPEED{1};
+const int QmsReplayPlayer::s_MAXIMUM_SPEED{100};
+const size_t QmsReplayPlayer::s_KEYFRAME_INTERVAL{32};
+const int QmsReplayPlayer::s_TICK_INTERVAL{16};
+
+QmsReplayPlayer::QmsReplayPlayer(QmsReplay replay, QObject *parent) :
+        QObject{parent},
+        m_replay{std::move(replay)},
+        m_keyframes{},
+        m_nextEvent{0},
+        m_position{0},
+        m_speed{QmsReplayPlayer::s_MINIMUM_SPEED},
+        m_tickTimer{},
+        m_wallClock{} {
+    this->buildKeyframes();
+    this->m_tickTimer.setInterval(QmsReplayPlayer::s_TICK_INTERVAL);
+    this->connect(&this->m_tickTimer, &QTimer::timeout, this, &QmsReplayPlayer::onTick);
+}
+
+const QmsReplay &QmsReplayPlayer::replay() const {
+    return this->m_replay;
+}
+
+int64_t QmsReplayPlayer::position() const {
+    return this->m_position;
+}
+
+int64_t QmsReplayPlayer::duration() const {
+    return this->m_replay.duration();
+}
+
+int QmsReplayPlayer::speed() const {
+    return this->m_speed;
+}
+
+bool QmsReplayPlayer::isPlaying() const {
+    return this->m_tickTimer.isActive();
+}
+
+void QmsReplayPlayer::play() {
+    if (this->isPlaying()) {
+        return;
+    }
+    if ((this->m_nextEvent == this->m_replay.events().size()) && (this->m_position >= this->duration())) {
+        this->seek(0);
+    }
+    this->m_wallClock.start();
+    this->m_tickTimer.start();
+    emit(playingChanged(true));
+}
+
+void QmsReplayPlayer::pause() {
+    if (!this->isPlaying()) {
+        return;
+    }
+    this->m_tickTimer.stop();
+    emit(playingChanged(false));
+}
+
+void QmsReplayPlayer::setSpeed(int speed) {
+    this->m_speed = std::min(std::max(speed, QmsReplayPlayer::s_MINIMUM_SPEED), QmsReplayPlayer::s_MAXIMUM_SPEED);
+}
+
+/* seek() : Going backwards, or far enough forwards that a newer keyframe is past the next
+ * event, restores the latest keyframe that is not past the target. Either way, what is
+ * left is at most KEYFRAME_INTERVAL() - 1 events to replay */
+void QmsReplayPlayer::seek(qint64 position) {
+    const int64_t targetPosition{std::min(std::max(static_cast<int64_t>(position), static_cast<int64_t>(0)), this->duration())};
+    const auto &events = this->m_replay.events();
+    const auto targetEvent = static_cast<size_t>(std::upper_bound(events.begin(), events.end(), targetPosition,
+                                                                  [](int64_t lhs, const QmsReplayEvent &rhs) {
+                                                                      return lhs < rhs.timestamp;
+                                                                  }) - events.begin());
+    const size_t keyframeIndex{std::min(targetEvent / QmsReplayPlayer::s_KEYFRAME_INTERVAL, this->m_keyframes.size() - 1)};
+    if ((targetEvent < this->m_nextEvent) || (this->m_keyframes[keyframeIndex].nextEvent > this->m_nextEvent)) {
+        this->restoreKeyframe(keyframeIndex);
+    }
+    this->advanceTo(targetPosition);
+    this->m_wallClock.restart();
+    emit(positionChanged(this->m_position));
+}
+
+void QmsReplayPlayer::onTick() {
+    const int64_t elapsed{this->m_wallClock.restart()};
+    this->advanceTo(std::min(this->m_position + (elapsed * this->m_speed), this->duration()));
+    emit(positionChanged(this->m_position));
+    if (this->m_nextEvent == this->m_replay.events().size()) {
+        this->pause();
+        emit(finished());
+    }
+}
+
+/* buildKeyframes() : Keyframe i holds the game just before event i * KEYFRAME_INTERVAL().
+ * Each one shares the cells, mines and undo history it has in common with the one before
+ * it, so together they cost little more than the cells that changed in between */
+void QmsReplayPlayer::buildKeyframes() {
+    const auto &events = this->m_replay.events();
+    QmsReplaySimulator simulator{this->m_replay, gameController->gameStateSnapshot()};
+    this->m_keyframes.reserve((events.size() / QmsReplayPlayer::s_KEYFRAME_INTERVAL) + 1);
+    for (size_t eventIndex = 0; eventIndex < events.size(); eventIndex++) {
+        if ((eventIndex % QmsReplayPlayer::s_KEYFRAME_INTERVAL) == 0) {
+            this->m_keyframes.push_back(Keyframe{eventIndex, simulator.gameState()});
+        }
+        simulator.apply(events[eventIndex]);
+    }
+    if (this->m_keyframes.empty()) {
+        this->m_keyframes.push_back(Keyframe{0, simulator.gameState()});
+    }
+    LOG_DEBUG() << QString{"Built %1 replay keyframes for %2 events"}.arg(QS_NUMBER(this->m_keyframes.size()),
+                                                                         QS_NUMBER(events.size()));
+}
+
+/* advanceTo() : Dispatches every event up to and including position */
+void QmsReplayPlayer::advanceTo(int64_t position) {
+    const auto &events = this->m_replay.events();
+    while ((this->m_nextEvent < events.size()) && (events[this->m_nextEvent].timestamp <= position)) {
+        gameController->dispatchReplayEvent(events[this->m_nextEvent]);
+        this->m_nextEvent++;
+    }
+    this->m_position = position;
+}
+
+void QmsReplayPlayer::restoreKeyframe(size_t keyframeIndex) {
+    const Keyframe &keyframe = this->m_keyframes[keyframeIndex];
+    LOG_DEBUG() << QString{"Restoring replay keyframe %1 (event %2)"}.arg(QS_NUMBER(keyframeIndex),
+                                                                         QS_NUMBER(keyframe.nextEvent));
+    gameController->applyGameState(keyframe.gameState);
+    this->m_nextEvent = keyframe.nextEvent;
+    this->m_position = (keyframe.nextEvent == 0) ? 0 : this->m_replay.events()[keyframe.nextEvent - 1].timestamp;
+    emit(stateRestored());
+}
+
+int QmsReplayPlayer::MINIMUM_SPEED() {
+    return QmsReplayPlayer::s_MINIMUM_SPEED;
+}
+
+int QmsReplayPlayer::MAXIMUM_SPEED() {
+    return QmsReplayPlayer::s_MAXIMUM_SPEED;
+}
+
+size_t QmsReplayPlayer::KEYFRAME_INTERVAL() {
+    return QmsReplayPlayer::s_KEYFRAME_INTERVAL;
+}
+
+int QmsReplayPlayer::TICK_INTERVAL() {
+    return QmsReplayPlayer::s_TICK_INTERVAL;
+}
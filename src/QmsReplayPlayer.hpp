@@ -0,0 +1,76 @@
+#ifndef QMINESWEEPER_QMSREPLAYPLAYER_HPP
+#define QMINESWEEPER_QMSREPLAYPLAYER_HPP
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <vector>
+#include <cstddef>
+
+#include "QmsReplay.hpp"
+#include "QmsGameState.hpp"
+
+/* QmsReplayPlayer : Feeds the events of a QmsReplay back through the GameController, at
+ * anywhere from 1x to 100x speed. When the replay is loaded, the whole game is played once
+ * on a QmsReplaySimulator, without the board, keeping a snapshot of it every KEYFRAME_INTERVAL()
+ * events, so any seek restores the nearest keyframe at or before the target and only replays
+ * the few events after it, instead of the whole game. The board must already be set up for
+ * the replay (GameController::beginReplayPlayback()) */
+class QmsReplayPlayer : public QObject {
+Q_OBJECT
+public:
+    explicit QmsReplayPlayer(QmsReplay replay, QObject *parent = nullptr);
+    ~QmsReplayPlayer() override = default;
+
+    const QmsReplay &replay() const;
+    int64_t position() const;
+    int64_t duration() const;
+    int speed() const;
+    bool isPlaying() const;
+
+    static int MINIMUM_SPEED();
+    static int MAXIMUM_SPEED();
+    static size_t KEYFRAME_INTERVAL();
+    static int TICK_INTERVAL();
+
+public slots:
+    void play();
+    void pause();
+    void setSpeed(int speed);
+    void seek(qint64 position);
+
+signals:
+    void positionChanged(qint64 position);
+    void playingChanged(bool isPlaying);
+    void stateRestored();
+    void finished();
+
+private slots:
+    void onTick();
+
+private:
+    struct Keyframe {
+        size_t nextEvent;
+        QmsGameState gameState;
+    };
+
+    QmsReplay m_replay;
+    std::vector<Keyframe> m_keyframes;
+    size_t m_nextEvent;
+    int64_t m_position;
+    int m_speed;
+    QTimer m_tickTimer;
+    QElapsedTimer m_wallClock;
+
+    void buildKeyframes();
+    void advanceTo(int64_t position);
+    void restoreKeyframe(size_t keyframeIndex);
+
+    static const int s_MINIMUM_SPEED;
+    static const int s_MAXIMUM_SPEED;
+    static const size_t s_KEYFRAME_INTERVAL;
+    static const int s_TICK_INTERVAL;
+};
+
+#endif //QMINESWEEPER_QMSREPLAYPLAYER_HPP
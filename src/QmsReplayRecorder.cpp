@@ -0,0 +1,82 @@
+#include "QmsReplayRecorder.hpp"
+#include "QmsUtilities.hpp"
+#include "QmsStrings.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QDir>
+#include <QDateTime>
+
+QmsReplayRecorder::QmsReplayRecorder(QObject *parent) :
+        QObject{parent},
+        m_replay{},
+        m_elapsedTimer{},
+        m_isRecording{false},
+        m_isEnabled{true} {
+
+}
+
+void QmsReplayRecorder::beginRecording(int columnCount, int rowCount) {
+    this->m_replay = QmsReplay{columnCount, rowCount};
+    this->m_elapsedTimer.invalidate();
+    this->m_isRecording = this->m_isEnabled;
+}
+
+void QmsReplayRecorder::recordEvent(ReplayEventKind kind, int cellIndex) {
+    if (!this->m_isRecording) {
+        return;
+    }
+    if (!this->m_elapsedTimer.isValid()) {
+        this->m_elapsedTimer.start();
+    }
+    this->m_replay.appendEvent(QmsReplayEvent{this->m_elapsedTimer.elapsed(), kind, cellIndex});
+}
+
+/* finishRecording() : Stops recording and saves the replay. A game that never
+ * got its first click has no mine layout, so there is nothing worth saving */
+void QmsReplayRecorder::finishRecording(std::vector<int> mineCells) {
+    using namespace QmsStrings;
+    if (!this->m_isRecording) {
+        return;
+    }
+    this->m_isRecording = false;
+    if (this->m_replay.isEmpty() || mineCells.empty()) {
+        return;
+    }
+    this->m_replay.setMineCells(std::move(mineCells));
+    QDir directory{QmsReplayRecorder::replayDirectory()};
+    if (!directory.mkpath(".")) {
+        LOG_WARNING() << QString{"Replay directory %1 could not be created, replay was not saved"}.arg(directory.path());
+        return;
+    }
+    const QString filePath{directory.filePath(QString{"replay-%1%2"}.arg(
+            QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"), REPLAY_FILE_EXTENSION))};
+    const auto result = this->m_replay.saveToFile(filePath);
+    if (result.first == SaveReplayResult::Success) {
+        LOG_INFO() << QString{"Saved replay of %1 events to %2"}.arg(QS_NUMBER(this->m_replay.events().size()), filePath);
+    } else {
+        LOG_WARNING() << QString{"Replay could not be saved (%1)"}.arg(result.second.c_str());
+    }
+}
+
+void QmsReplayRecorder::cancelRecording() {
+    this->m_isRecording = false;
+}
+
+bool QmsReplayRecorder::isRecording() const {
+    return this->m_isRecording;
+}
+
+void QmsReplayRecorder::setEnabled(bool enabled) {
+    this->m_isEnabled = enabled;
+    if (!enabled) {
+        this->m_isRecording = false;
+    }
+}
+
+bool QmsReplayRecorder::isEnabled() const {
+    return this->m_isEnabled;
+}
+
+QString QmsReplayRecorder::replayDirectory() {
+    return QmsUtilities::getProgramSettingsDirectory() + QmsStrings::REPLAY_DIRECTORY_NAME;
+}
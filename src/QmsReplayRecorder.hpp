@@ -0,0 +1,39 @@
+#ifndef QMINESWEEPER_QMSREPLAYRECORDER_HPP
+#define QMINESWEEPER_QMSREPLAYRECORDER_HPP
+
+#include <QObject>
+#include <QElapsedTimer>
+
+#include <vector>
+
+#include "QmsReplay.hpp"
+
+/* QmsReplayRecorder : The GameController hands it every input on the board (and every
+ * undo and redo), which it timestamps into a QmsReplay. The clock starts at the first input, so the time
+ * spent looking at a fresh board is not part of the replay. Once the game is over,
+ * the replay is written to the replay directory, provided the game got far enough
+ * to have mines. Nothing is recorded while it is disabled (during playback) */
+class QmsReplayRecorder : public QObject {
+Q_OBJECT
+public:
+    explicit QmsReplayRecorder(QObject *parent = nullptr);
+    ~QmsReplayRecorder() override = default;
+
+    void beginRecording(int columnCount, int rowCount);
+    void recordEvent(ReplayEventKind kind, int cellIndex);
+    void finishRecording(std::vector<int> mineCells);
+    void cancelRecording();
+    bool isRecording() const;
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    static QString replayDirectory();
+
+private:
+    QmsReplay m_replay;
+    QElapsedTimer m_elapsedTimer;
+    bool m_isRecording;
+    bool m_isEnabled;
+};
+
+#endif //QMINESWEEPER_QMSREPLAYRECORDER_HPP
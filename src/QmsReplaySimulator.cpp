@@ -0,0 +1,219 @@
+#include "QmsReplaySimulator.hpp"
+#include "MineCoordinates.hpp"
+
+#include <utility>
+
+/* QmsReplaySimulator() : The counters are copied without the LCDs listening
+ * to them, so nothing on screen follows the simulation */
+QmsReplaySimulator::QmsReplaySimulator(const QmsReplay &replay, const QmsGameState &initialState) :
+        m_replay{replay},
+        m_gameState{initialState},
+        m_emptyCellsToCheck{} {
+    this->m_gameState.m_userDisplayNumberOfMines = ChangeAwareInt{initialState.m_userDisplayNumberOfMines.value()};
+    this->m_gameState.m_numberOfMovesMade = ChangeAwareInt{initialState.m_numberOfMovesMade.value()};
+}
+
+void QmsReplaySimulator::apply(const QmsReplayEvent &event) {
+    if ((event.kind != ReplayEventKind::Undo) && (event.kind != ReplayEventKind::Redo) &&
+        ((event.cellIndex < 0) || (event.cellIndex >= this->m_gameState.m_cells.size()))) {
+        return;
+    }
+    switch (event.kind) {
+        case ReplayEventKind::LeftClicked:
+        case ReplayEventKind::RightClicked:
+            break;
+        case ReplayEventKind::LeftClickReleased:
+            this->onLeftClickReleased(event.cellIndex);
+            break;
+        case ReplayEventKind::RightClickReleased:
+        case ReplayEventKind::LongLeftClickReleased:
+        case ReplayEventKind::LongRightClickReleased:
+            this->onRightClickReleased(event.cellIndex);
+            break;
+        case ReplayEventKind::Undo:
+            this->onUndoOrRedo(true);
+            break;
+        case ReplayEventKind::Redo:
+            this->onUndoOrRedo(false);
+            break;
+    }
+}
+
+const QmsGameState &QmsReplaySimulator::gameState() const {
+    return this->m_gameState;
+}
+
+/* onLeftClickReleased() : GameController::onMineSweeperButtonLeftClickReleased(). A click on a
+ * revealed cell reveals it again, counting it once more, exactly as the board does */
+void QmsReplaySimulator::onLeftClickReleased(int cellIndex) {
+    QmsGameState &state = this->m_gameState;
+    if (state.m_gameOver) {
+        return;
+    }
+    state.m_undoLog.beginAction(this->currentCounters());
+    if (state.m_initialClickFlag) {
+        this->placeMines();
+    }
+    const QmsCellState cellState{state.m_cells.at(cellIndex)};
+    if ((cellState.hasFlag()) || (cellState.hasQuestionMark())) {
+        //
+    } else if (cellState.hasMine()) {
+        state.m_gameState = GameState::GameInactive;
+        state.m_gameOver = true;
+    } else if (cellState.isRevealed()) {
+        this->revealCell(cellIndex);
+    } else {
+        state.m_numberOfMovesMade++;
+        this->revealCell(cellIndex);
+    }
+    if (state.m_gameOver) {
+        this->revealAllCells();
+    }
+    state.m_undoLog.commitAction();
+}
+
+/* onRightClickReleased() : GameController::onMineSweeperButtonRightClickReleased(),
+ * cycling a covered cell through flag, question mark and nothing */
+void QmsReplaySimulator::onRightClickReleased(int cellIndex) {
+    QmsGameState &state = this->m_gameState;
+    if (state.m_gameOver) {
+        return;
+    }
+    state.m_undoLog.beginAction(this->currentCounters());
+    if (state.m_initialClickFlag) {
+        this->placeMines();
+    }
+    QmsCellState cellState{state.m_cells.at(cellIndex)};
+    if (cellState.isRevealed()) {
+        //
+    } else if (cellState.hasFlag()) {
+        cellState.setHasFlag(false).setHasQuestionMark(true);
+        state.m_userDisplayNumberOfMines++;
+    } else if (cellState.hasQuestionMark()) {
+        cellState.setHasQuestionMark(false);
+    } else {
+        cellState.setHasFlag(true);
+        state.m_userDisplayNumberOfMines--;
+    }
+    this->changeCell(cellIndex, cellState);
+    state.m_undoLog.commitAction();
+}
+
+/* onUndoOrRedo() : GameController::onUndoRequested() and onRedoRequested() */
+void QmsReplaySimulator::onUndoOrRedo(bool isUndo) {
+    QmsGameState &state = this->m_gameState;
+    if ((state.m_gameOver) || (state.m_initialClickFlag) || (state.m_undoLog.isRecording()) ||
+        (isUndo ? !state.m_undoLog.canUndo() : !state.m_undoLog.canRedo())) {
+        return;
+    }
+    const QmsStateDelta delta{isUndo ? state.m_undoLog.takeUndo() : state.m_undoLog.takeRedo()};
+    QmsStateDelta inverse{this->currentCounters()};
+    delta.forEachCell([&state, &inverse](int cellIndex, QmsCellState restoredState) {
+        const QmsCellState currentState{state.m_cells.at(cellIndex)};
+        inverse.appendCell(cellIndex, currentState);
+        state.m_cells.set(cellIndex, restoredState);
+        state.m_stateHash.changeCell(cellIndex, currentState.visibility(), restoredState.visibility());
+    });
+    state.m_userDisplayNumberOfMines = delta.counters().userDisplayNumberOfMines;
+    state.m_numberOfMovesMade = delta.counters().numberOfMovesMade;
+    state.m_unopenedMineCount = delta.counters().unopenedMineCount;
+    if (isUndo) {
+        state.m_undoLog.pushRedo(std::move(inverse));
+    } else {
+        state.m_undoLog.pushUndo(std::move(inverse));
+    }
+}
+
+/* placeMines() : The replay's mines are placed as recorded, along with the
+ * neighbor counts, as GameController::assignAllMines() and
+ * determineNeighborMineCounts() do, neither of which goes into the undo log */
+void QmsReplaySimulator::placeMines() {
+    QmsGameState &state = this->m_gameState;
+    QmsCellGrid &cells = state.m_cells;
+    for (const auto &mineCell : this->m_replay.mineCells()) {
+        if ((mineCell < 0) || (mineCell >= cells.size())) {
+            continue;
+        }
+        const MineCoordinates coordinates{mineCell % state.m_numberOfColumns, mineCell / state.m_numberOfColumns};
+        if (!state.m_mineCoordinates.write().emplace(coordinates).second) {
+            continue;
+        }
+        state.m_stateHash.toggleMine(mineCell);
+        QmsCellState cellState{cells.at(mineCell)};
+        cells.set(mineCell, cellState.setHasMine(true));
+        for (int columnI = coordinates.X() - 1; columnI <= coordinates.X() + 1; columnI++) {
+            for (int rowI = coordinates.Y() - 1; rowI <= coordinates.Y() + 1; rowI++) {
+                if (((columnI == coordinates.X()) && (rowI == coordinates.Y())) || (!cells.inBounds(columnI, rowI))) {
+                    continue;
+                }
+                QmsCellState neighborState{cells.at(columnI, rowI)};
+                cells.set(columnI, rowI, neighborState.setNumberOfSurroundingMines(neighborState.numberOfSurroundingMines() + 1));
+            }
+        }
+    }
+    state.m_initialClickFlag = false;
+    state.m_gameState = GameState::GameActive;
+}
+
+/* revealCell() : MainWindow::displayMineSquare() with GameController::onMineDisplayed() and
+ * checkForOtherEmptyMines(), uncovering the neighbors of every empty cell from a stack. Winning
+ * ends the game, but the cascade it happened in still runs to the end, as it does on the board */
+void QmsReplaySimulator::revealCell(int cellIndex) {
+    QmsGameState &state = this->m_gameState;
+    const QmsCellGrid &cells = state.m_cells;
+    const int columns{state.m_numberOfColumns};
+    const auto reveal = [this, &state, &cells](int index) {
+        QmsCellState cellState{cells.at(index)};
+        this->changeCell(index, cellState.setIsRevealed(true));
+        if ((--state.m_unopenedMineCount) == state.m_numberOfMines) {
+            state.m_gameState = GameState::GameInactive;
+            state.m_gameOver = true;
+        }
+        if (cellState.numberOfSurroundingMines() == 0) {
+            this->m_emptyCellsToCheck.push_back(index);
+        }
+    };
+    reveal(cellIndex);
+    while (!this->m_emptyCellsToCheck.empty()) {
+        const int emptyCell{this->m_emptyCellsToCheck.back()};
+        this->m_emptyCellsToCheck.pop_back();
+        for (int columnI = (emptyCell % columns) - 1; columnI <= (emptyCell % columns) + 1; columnI++) {
+            for (int rowI = (emptyCell / columns) - 1; rowI <= (emptyCell / columns) + 1; rowI++) {
+                if (((columnI == emptyCell % columns) && (rowI == emptyCell / columns)) || (!cells.inBounds(columnI, rowI))) {
+                    continue;
+                }
+                const QmsCellState neighborState{cells.at(columnI, rowI)};
+                if ((!neighborState.hasMine()) && (!neighborState.isRevealed()) &&
+                    (!neighborState.hasQuestionMark()) && (!neighborState.hasFlag())) {
+                    reveal(cells.indexOf(columnI, rowI));
+                }
+            }
+        }
+    }
+}
+
+/* revealAllCells() : MainWindow::onGameWon() and displayAllMines(), which uncover the
+ * whole board (flags included) once the game is won or lost */
+void QmsReplaySimulator::revealAllCells() {
+    for (int cellIndex = 0; cellIndex < this->m_gameState.m_cells.size(); cellIndex++) {
+        QmsCellState cellState{this->m_gameState.m_cells.at(cellIndex)};
+        this->changeCell(cellIndex, cellState.setIsRevealed(true));
+    }
+}
+
+/* changeCell() : GameController::notifyCellChanged() */
+void QmsReplaySimulator::changeCell(int cellIndex, QmsCellState newState) {
+    const QmsCellState previousState{this->m_gameState.m_cells.at(cellIndex)};
+    if (newState == previousState) {
+        return;
+    }
+    this->m_gameState.m_undoLog.recordCell(cellIndex, previousState);
+    this->m_gameState.m_cells.set(cellIndex, newState);
+    this->m_gameState.m_stateHash.changeCell(cellIndex, previousState.visibility(), newState.visibility());
+}
+
+QmsGameCounters QmsReplaySimulator::currentCounters() const {
+    return QmsGameCounters{this->m_gameState.m_userDisplayNumberOfMines.value(),
+                           this->m_gameState.m_numberOfMovesMade.value(),
+                           this->m_gameState.m_unopenedMineCount};
+}
@@ -0,0 +1,36 @@
+#ifndef QMINESWEEPER_QMSREPLAYSIMULATOR_HPP
+#define QMINESWEEPER_QMSREPLAYSIMULATOR_HPP
+
+#include <vector>
+
+#include "QmsReplay.hpp"
+#include "QmsGameState.hpp"
+
+/* QmsReplaySimulator : Plays the events of a QmsReplay on a QmsGameState alone, with the same
+ * rules the GameController applies to the board (mines placed on the first click, cascades, flags
+ * and question marks, undo and redo, the end of the game), but without touching a QmsButton or
+ * emitting anything. It lets QmsReplayPlayer build every keyframe of a replay when it is loaded.
+ * The play timer is not simulated, so it stays as it was in the state the simulation started from */
+class QmsReplaySimulator {
+public:
+    QmsReplaySimulator(const QmsReplay &replay, const QmsGameState &initialState);
+
+    void apply(const QmsReplayEvent &event);
+    const QmsGameState &gameState() const;
+
+private:
+    const QmsReplay &m_replay;
+    QmsGameState m_gameState;
+    std::vector<int> m_emptyCellsToCheck;
+
+    void onLeftClickReleased(int cellIndex);
+    void onRightClickReleased(int cellIndex);
+    void onUndoOrRedo(bool isUndo);
+    void placeMines();
+    void revealCell(int cellIndex);
+    void revealAllCells();
+    void changeCell(int cellIndex, QmsCellState newState);
+    QmsGameCounters currentCounters() const;
+};
+
+#endif //QMINESWEEPER_QMSREPLAYSIMULATOR_HPP
@@ -0,0 +1,48 @@
+#include "QmsScreenMetrics.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+QmsScreenMetrics::QmsScreenMetrics(QObject *parent) :
+        QObject{parent},
+        m_geometries{},
+        m_fallbackGeometry{QRect{}, 1.0, 96.0} {
+    connect(qApp, &QGuiApplication::screenRemoved, this, &QmsScreenMetrics::onScreenRemoved);
+}
+
+/* geometryOf() : A screen seen for the first time is read and watched for changes. Without
+ * any screen at all (which Qt allows while displays are reconfigured), an empty geometry
+ * is returned, which every caller already has to handle for very small screens */
+const QmsScreenGeometry &QmsScreenMetrics::geometryOf(QScreen *screen) {
+    if (!screen) {
+        screen = QGuiApplication::primaryScreen();
+    }
+    if (!screen) {
+        return this->m_fallbackGeometry;
+    }
+    auto found = this->m_geometries.find(screen);
+    if (found != this->m_geometries.end()) {
+        return found->second;
+    }
+    connect(screen, &QScreen::geometryChanged, this, &QmsScreenMetrics::onScreenChanged, Qt::UniqueConnection);
+    connect(screen, &QScreen::availableGeometryChanged, this, &QmsScreenMetrics::onScreenChanged, Qt::UniqueConnection);
+    connect(screen, &QScreen::logicalDotsPerInchChanged, this, &QmsScreenMetrics::onScreenChanged, Qt::UniqueConnection);
+    connect(screen, &QScreen::physicalDotsPerInchChanged, this, &QmsScreenMetrics::onScreenChanged, Qt::UniqueConnection);
+    return this->m_geometries.emplace(screen, QmsScreenGeometry{screen->availableGeometry(), screen->devicePixelRatio(),
+                                                                screen->logicalDotsPerInch()}).first->second;
+}
+
+/* onScreenChanged() : Several of a screen's signals fire for a single change (a new resolution
+ * changes both geometries), so the cached entry is only dropped and reported the first time */
+void QmsScreenMetrics::onScreenChanged() {
+    auto screen = qobject_cast<QScreen *>(this->sender());
+    if ((!screen) || (this->m_geometries.erase(screen) == 0)) {
+        return;
+    }
+    emit(screenMetricsChanged(screen));
+}
+
+void QmsScreenMetrics::onScreenRemoved(QScreen *screen) {
+    this->m_geometries.erase(screen);
+    disconnect(screen, nullptr, this, nullptr);
+}
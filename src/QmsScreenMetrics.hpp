@@ -0,0 +1,44 @@
+#ifndef QMINESWEEPER_QMSSCREENMETRICS_HPP
+#define QMINESWEEPER_QMSSCREENMETRICS_HPP
+
+#include <QObject>
+#include <QRect>
+
+#include <map>
+
+class QScreen;
+
+/* QmsScreenGeometry : What the layout of the main window depends on for one screen */
+struct QmsScreenGeometry {
+    QRect availableGeometry;
+    qreal devicePixelRatio;
+    qreal logicalDotsPerInch;
+};
+
+/* QmsScreenMetrics : The geometry of every screen the main window has been laid out on, read
+ * from the QScreen once and kept until the screen reports a change to its geometry or its DPI
+ * (or goes away). Each change is reported once through screenMetricsChanged(), which is the
+ * only time anything computed from these metrics (such as the size of a cell) needs redoing */
+class QmsScreenMetrics : public QObject {
+Q_OBJECT
+public:
+    explicit QmsScreenMetrics(QObject *parent = nullptr);
+    ~QmsScreenMetrics() override = default;
+    QmsScreenMetrics(const QmsScreenMetrics &rhs) = delete;
+    QmsScreenMetrics &operator=(const QmsScreenMetrics &rhs) = delete;
+
+    const QmsScreenGeometry &geometryOf(QScreen *screen);
+
+signals:
+    void screenMetricsChanged(QScreen *screen);
+
+private slots:
+    void onScreenChanged();
+    void onScreenRemoved(QScreen *screen);
+
+private:
+    std::map<QScreen *, QmsScreenGeometry> m_geometries;
+    QmsScreenGeometry m_fallbackGeometry;
+};
+
+#endif //QMINESWEEPER_QMSSCREENMETRICS_HPP
@@ -11,6 +11,10 @@ const int QmsSettingsLoader::DEFAULT_AUDIO_VOLUME{20};
 const char *QmsSettingsLoader::NUMBER_OF_COLUMNS_KEY{"columns"};
 const char *QmsSettingsLoader::NUMBER_OF_ROWS_KEY{"rows"};
 const char *QmsSettingsLoader::AUDIO_VOLUME_KEY{"volume"};
+const char *QmsSettingsLoader::ICON_PALETTE_KEY{"iconPalette"};
+const IconPalette QmsSettingsLoader::DEFAULT_ICON_PALETTE{IconPalette::Classic};
+const char *QmsSettingsLoader::RIPPLE_REVEAL_KEY{"rippleReveal"};
+const bool QmsSettingsLoader::DEFAULT_RIPPLE_REVEAL{false};
 
 const QmsSettingsLoader::SupportedLanguage QmsSettingsLoader::DEFAULT_LANGUAGE{
         QmsSettingsLoader::SupportedLanguage::English};
@@ -37,6 +41,8 @@ void QmsSettingsLoader::saveApplicationSettings(const QmsApplicationSettings &se
     settingsSaver.setValue(QmsSettingsLoader::NUMBER_OF_COLUMNS_KEY, settings.numberOfColumns());
     settingsSaver.setValue(QmsSettingsLoader::NUMBER_OF_ROWS_KEY, settings.numberOfRows());
     settingsSaver.setValue(QmsSettingsLoader::AUDIO_VOLUME_KEY, settings.audioVolume());
+    settingsSaver.setValue(QmsSettingsLoader::ICON_PALETTE_KEY, static_cast<int>(settings.iconPalette()));
+    settingsSaver.setValue(QmsSettingsLoader::RIPPLE_REVEAL_KEY, settings.rippleReveal());
     settingsSaver.sync();
     LOG_INFO() << "Successfully saved application settings";
 }
@@ -46,6 +52,11 @@ QmsApplicationSettings QmsSettingsLoader::loadApplicationSettings() {
     int columns{settingsLoader.value(QmsSettingsLoader::NUMBER_OF_COLUMNS_KEY).toInt()};
     int rows{settingsLoader.value(QmsSettingsLoader::NUMBER_OF_ROWS_KEY).toInt()};
     int volume{settingsLoader.value(QmsSettingsLoader::AUDIO_VOLUME_KEY).toInt()};
+    IconPalette iconPalette{QmsSettingsLoader::DEFAULT_ICON_PALETTE};
+    if (!QmsIconAtlas::tryParseIconPalette(settingsLoader.value(QmsSettingsLoader::ICON_PALETTE_KEY).toInt(), iconPalette)) {
+        iconPalette = QmsSettingsLoader::DEFAULT_ICON_PALETTE;
+    }
+    bool rippleReveal{settingsLoader.value(QmsSettingsLoader::RIPPLE_REVEAL_KEY, QmsSettingsLoader::DEFAULT_RIPPLE_REVEAL).toBool()};
     QmsApplicationSettings settings{};
     if (columns <= 0) {
         columns = QmsSettingsLoader::DEFAULT_COLUMN_COUNT;
@@ -59,6 +70,8 @@ QmsApplicationSettings QmsSettingsLoader::loadApplicationSettings() {
     settings.setNumberOfColumns(columns);
     settings.setNumberOfRows(rows);
     settings.setAudioVolume(volume);
+    settings.setIconPalette(iconPalette);
+    settings.setRippleReveal(rippleReveal);
     return settings;
 }
 
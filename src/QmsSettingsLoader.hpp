@@ -4,6 +4,8 @@
 #include <QObject>
 #include <utility>
 
+#include "QmsIconAtlas.hpp"
+
 class QmsApplicationSettings;
 
 class QmsSettingsLoader : public QObject {
@@ -24,11 +26,15 @@ public:
     static const int DEFAULT_COLUMN_COUNT;
     static const int DEFAULT_ROW_COUNT;
     static const int DEFAULT_AUDIO_VOLUME;
+    static const IconPalette DEFAULT_ICON_PALETTE;
+    static const bool DEFAULT_RIPPLE_REVEAL;
 
 private:
     static const char *NUMBER_OF_COLUMNS_KEY;
     static const char *NUMBER_OF_ROWS_KEY;
     static const char *AUDIO_VOLUME_KEY;
+    static const char *ICON_PALETTE_KEY;
+    static const char *RIPPLE_REVEAL_KEY;
 
     explicit QmsSettingsLoader(QObject *parent = nullptr);
     QmsSettingsLoader(const QmsSettingsLoader &) = delete;
@@ -9,6 +9,8 @@ namespace QmsStrings {
     const char *const START_NEW_GAME_WINDOW_TITLE{"Start new game?"};
     const char *const START_NEW_GAME_PROMPT{"Are you sure you'd like to reset the current game?"};
     const char *const START_NEW_GAME_INSTRUCTION{"Click on a minesweeper button to begin"};
+    const char *const GAME_PAUSED_OVERLAY_TEXT{"Paused"};
+    const char *const MINIMAP_DOCK_TITLE{"Minimap"};
     const char *const CLOSE_APPLICATION_WINDOW_TITLE{"Quit QMineSweeper?"};
     const char *const CLOSE_APPLICATION_WINDOW_PROMPT{"Are you sure you'd like to quit?"};
 
@@ -29,9 +31,6 @@ namespace QmsStrings {
     const char *const FAILED_TO_LOAD_GAME_STATE{"Load game failed with the following error: \"%1\""};
 
     const char *const WIN_DIALOG{"You win! It took %1 moves and your total play time was %2"};
-    const char *const UNCOVERED_NON_MINE_STYLESHEET{"color: rgb(200, 170, 255); background-color: rgb(200, 170, 255);"};
-    const char *const UNCOVERED_MINE_STYLESHEET{"color: rgb(255, 0, 0); background-color: rgb(255, 0, 0);"};
-    const char *const LONG_CLICKED_MINE_STYLESHEET{"color: rgb(0, 255, 0); background-color: rgb(0, 255, 0);"};
     const char *const LICENSE_PATH_KEY{"LicensePath"};
 
     const char *const ENGLISH_STRING{"English"};
@@ -39,9 +38,22 @@ namespace QmsStrings {
     const char *const SPANISH_STRING{"Spanish"};
     const char *const JAPANESE_STRING{"Japanese"};
 
+    const char *const CLASSIC_PALETTE_STRING{"Classic"};
+    const char *const HIGH_CONTRAST_PALETTE_STRING{"High Contrast"};
+    const char *const MONOCHROME_PALETTE_STRING{"Monochrome"};
+
     const char *const SAVED_GAME_FILE_EXTENSION{".qms"};
     const char *const SAVE_FILE_CAPTION{"Save game?"};
     const char *const OPEN_FILE_CAPTION{"Open existing game?"};
+    const char *const REPLAY_FILE_EXTENSION{".qmsr"};
+    const char *const REPLAY_DIRECTORY_NAME{"replays"};
+    const char *const OPEN_REPLAY_CAPTION{"Open replay?"};
+    const char *const ERROR_LOADING_REPLAY_TITLE{"Error Loading Replay"};
+    const char *const BOARD_PACK_FILE_EXTENSION{".qmsp"};
+    const char *const OPEN_BOARD_PACK_CAPTION{"Play from board pack?"};
+    const char *const CHOOSE_BOARD_PACK_INDEX_TITLE{"Choose Board"};
+    const char *const CHOOSE_BOARD_PACK_INDEX_PROMPT{"Board number (0 to %1):"};
+    const char *const ERROR_LOADING_BOARD_PACK_TITLE{"Error Loading Board Pack"};
 
     const char *const ABOUT_QT_WINDOW_TITLE{"About Qt"};
 
@@ -62,7 +74,6 @@ namespace QmsStrings {
     const char *const FACE_ICON_SLEEPY_PATH{":/face-icons/png/face-icons/sleepy-face.png"};
     const char *const FACE_ICON_SMILEY_PATH{":/face-icons/png/face-icons/smiley-face.png"};
     const char *const FACE_ICON_WINKY_PATH{":/face-icons/png/face-icons/winky-face.png"};
-    const char *const COUNT_MINES_0_PATH{};
     const char *const COUNT_MINES_1_PATH{":/surrounding-mine-icons/png/surrounding-mine-icons/1.png"};
     const char *const COUNT_MINES_2_PATH{":/surrounding-mine-icons/png/surrounding-mine-icons/2.png"};
     const char *const COUNT_MINES_3_PATH{":/surrounding-mine-icons/png/surrounding-mine-icons/3.png"};
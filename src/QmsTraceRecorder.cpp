@@ -0,0 +1,172 @@
+#include "QmsTraceRecorder.hpp"
+#include "GlobalDefinitions.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+
+#include <algorithm>
+
+std::atomic<QmsTraceRecorder *> traceRecorder{nullptr};
+
+std::atomic<bool> QmsTraceRecorder::s_enabled{false};
+const size_t QmsTraceRecorder::s_MAXIMUM_EVENTS_PER_THREAD{1000000};
+
+thread_local QmsTraceRecorder::ThreadBuffer *QmsTraceRecorder::s_currentThreadBuffer{nullptr};
+
+QmsTraceRecorder::QmsTraceRecorder(const QString &traceFilePath) :
+        m_traceFilePath{QFile::encodeName(traceFilePath).toStdString()},
+        m_startTime{std::chrono::steady_clock::now()},
+        m_buffersMutex{},
+        m_buffers{},
+        m_writeMutex{} {
+
+}
+
+void QmsTraceRecorder::initializeInstance(const QString &traceFilePath) {
+    if (traceRecorder.load() == nullptr) {
+        traceRecorder.store(new QmsTraceRecorder{traceFilePath});
+        QmsTraceRecorder::s_enabled.store(true, std::memory_order_release);
+        LOG_INFO() << QString{"Recording a trace to %1 (send SIGUSR1 to write it before exiting)"}.arg(traceFilePath);
+    }
+}
+
+/* shutdownInstance() : Only called from main() once the event loop has returned (never from
+ * exit(), which a signal handler may have interrupted a span holding a buffer lock to get to).
+ * The recorder is not deleted, since a pool thread still winding down may be using its buffer */
+void QmsTraceRecorder::shutdownInstance() {
+    QmsTraceRecorder *recorder{traceRecorder.exchange(nullptr)};
+    if (recorder == nullptr) {
+        return;
+    }
+    QmsTraceRecorder::s_enabled.store(false, std::memory_order_release);
+    recorder->writeTrace();
+}
+
+/* writeInstance() : Writes the trace recorded so far, if there is one, without stopping the
+ * recording. Called from the event loop when the process receives SIGUSR1 */
+void QmsTraceRecorder::writeInstance() {
+    QmsTraceRecorder *recorder{traceRecorder.load()};
+    if (recorder) {
+        recorder->writeTrace();
+    }
+}
+
+/* recordSpan() : The first span of a thread registers a buffer for it, which the
+ * thread then finds again through a thread local pointer, without taking the registry lock */
+void QmsTraceRecorder::recordSpan(const char *name, const char *category,
+                                  std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    QmsTraceRecorder *recorder{traceRecorder.load(std::memory_order_acquire)};
+    if ((!QmsTraceRecorder::isEnabled()) || (recorder == nullptr)) {
+        return;
+    }
+    ThreadBuffer *buffer{QmsTraceRecorder::s_currentThreadBuffer};
+    if (buffer == nullptr) {
+        buffer = recorder->registerCurrentThread();
+        QmsTraceRecorder::s_currentThreadBuffer = buffer;
+    }
+    std::lock_guard<std::mutex> bufferLock{buffer->mutex};
+    if (buffer->events.size() >= QmsTraceRecorder::s_MAXIMUM_EVENTS_PER_THREAD) {
+        buffer->droppedCount++;
+        return;
+    }
+    buffer->events.push_back(TraceEvent{name, category,
+                                        std::chrono::duration_cast<std::chrono::nanoseconds>(begin - recorder->m_startTime).count(),
+                                        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()});
+}
+
+QmsTraceRecorder::ThreadBuffer *QmsTraceRecorder::registerCurrentThread() {
+    std::unique_ptr<ThreadBuffer> buffer{new ThreadBuffer{}};
+    QThread *currentThread{QThread::currentThread()};
+    const bool isGuiThread{(QCoreApplication::instance() != nullptr) && (currentThread == QCoreApplication::instance()->thread())};
+    std::lock_guard<std::mutex> buffersLock{this->m_buffersMutex};
+    buffer->threadId = static_cast<int>(this->m_buffers.size()) + 1;
+    if (isGuiThread) {
+        buffer->threadName = "GUI thread";
+    } else if ((currentThread != nullptr) && (!currentThread->objectName().isEmpty())) {
+        buffer->threadName = currentThread->objectName().toStdString();
+    } else {
+        buffer->threadName = QString{"Thread %1"}.arg(QS_NUMBER(buffer->threadId)).toStdString();
+    }
+    buffer->droppedCount = 0;
+    this->m_buffers.push_back(std::move(buffer));
+    return this->m_buffers.back().get();
+}
+
+/* writeTrace() : Writes everything recorded so far as complete ("X") events, timestamps and
+ * durations in microseconds, with a metadata event naming each thread. Each buffer is copied
+ * under its lock and written after, so the threads are only held up for the copy */
+bool QmsTraceRecorder::writeTrace() {
+    std::lock_guard<std::mutex> writeLock{this->m_writeMutex};
+    std::FILE *file{std::fopen(this->m_traceFilePath.c_str(), "wb")};
+    if (file == nullptr) {
+        LOG_WARNING() << QString{"Could not open trace file %1 for writing"}.arg(QFile::decodeName(this->m_traceFilePath.c_str()));
+        return false;
+    }
+    const auto processId = static_cast<long long>(QCoreApplication::applicationPid());
+    std::vector<ThreadBuffer *> buffers{};
+    {
+        std::lock_guard<std::mutex> buffersLock{this->m_buffersMutex};
+        for (const auto &it : this->m_buffers) {
+            buffers.push_back(it.get());
+        }
+    }
+    std::fputs("{\"traceEvents\":[", file);
+    bool isFirstEvent{true};
+    size_t eventCount{0};
+    uint64_t droppedCount{0};
+    std::vector<TraceEvent> events{};
+    for (const auto &buffer : buffers) {
+        {
+            std::lock_guard<std::mutex> bufferLock{buffer->mutex};
+            events = buffer->events;
+            droppedCount += buffer->droppedCount;
+        }
+        std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lld,\"tid\":%d,\"args\":{\"name\":\"",
+                     (isFirstEvent ? "" : ","), processId, buffer->threadId);
+        QmsTraceRecorder::writeEscaped(file, buffer->threadName.c_str());
+        std::fputs("\"}}", file);
+        isFirstEvent = false;
+        for (const auto &event : events) {
+            std::fputs(",\n{\"name\":\"", file);
+            QmsTraceRecorder::writeEscaped(file, event.name);
+            std::fputs("\",\"cat\":\"", file);
+            QmsTraceRecorder::writeEscaped(file, event.category);
+            std::fprintf(file, "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lld,\"tid\":%d}",
+                         static_cast<double>(event.beginNanoseconds) / 1000.0,
+                         static_cast<double>(event.durationNanoseconds) / 1000.0, processId, buffer->threadId);
+        }
+        eventCount += events.size();
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+    const bool isWritten{(std::ferror(file) == 0)};
+    std::fclose(file);
+    if (isWritten) {
+        LOG_INFO() << QString{"Wrote %1 trace events to %2"}.arg(QS_NUMBER(eventCount), QFile::decodeName(this->m_traceFilePath.c_str()));
+    } else {
+        LOG_WARNING() << QString{"Could not write trace file %1"}.arg(QFile::decodeName(this->m_traceFilePath.c_str()));
+    }
+    if (droppedCount != 0) {
+        LOG_WARNING() << QString{"%1 trace events were dropped after reaching %2 events on a thread"}.arg(
+                QS_NUMBER(droppedCount), QS_NUMBER(QmsTraceRecorder::s_MAXIMUM_EVENTS_PER_THREAD));
+    }
+    return isWritten;
+}
+
+void QmsTraceRecorder::writeEscaped(std::FILE *file, const char *text) {
+    for (const char *it = (text ? text : ""); *it != '\0'; it++) {
+        const auto character = static_cast<unsigned char>(*it);
+        if ((character == '"') || (character == '\\')) {
+            std::fputc('\\', file);
+            std::fputc(character, file);
+        } else if (character < 0x20) {
+            std::fprintf(file, "\\u%04x", character);
+        } else {
+            std::fputc(character, file);
+        }
+    }
+}
+
+size_t QmsTraceRecorder::MAXIMUM_EVENTS_PER_THREAD() {
+    return QmsTraceRecorder::s_MAXIMUM_EVENTS_PER_THREAD;
+}
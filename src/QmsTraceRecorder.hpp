@@ -0,0 +1,75 @@
+#ifndef QMINESWEEPER_QMSTRACERECORDER_HPP
+#define QMINESWEEPER_QMSTRACERECORDER_HPP
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* QmsTraceRecorder : Records spans of work (game controller handlers, reveal cascades, saves and
+ * loads, paints, event loop dispatches) when the program is started with --trace, and writes them
+ * out in the Chrome Trace Event format, which chrome://tracing and Perfetto open directly. Each
+ * thread appends to a buffer of its own, so a span costs a clock read and an uncontended lock.
+ * The trace is written when the event loop returns, and (outside of Windows) whenever the process
+ * receives SIGUSR1 (see QmsApplication::postSignal()), without stopping the recording. When
+ * tracing is off, a span costs one relaxed load */
+class QmsTraceRecorder {
+public:
+    ~QmsTraceRecorder() = default;
+    QmsTraceRecorder(const QmsTraceRecorder &rhs) = delete;
+    QmsTraceRecorder &operator=(const QmsTraceRecorder &rhs) = delete;
+
+    static void initializeInstance(const QString &traceFilePath);
+    static void shutdownInstance();
+    static void writeInstance();
+
+    static inline bool isEnabled() { return QmsTraceRecorder::s_enabled.load(std::memory_order_relaxed); }
+    static void recordSpan(const char *name, const char *category,
+                           std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    bool writeTrace();
+
+    static size_t MAXIMUM_EVENTS_PER_THREAD();
+
+private:
+    struct TraceEvent {
+        const char *name;
+        const char *category;
+        int64_t beginNanoseconds;
+        int64_t durationNanoseconds;
+    };
+
+    struct ThreadBuffer {
+        int threadId;
+        std::string threadName;
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        uint64_t droppedCount;
+    };
+
+    std::string m_traceFilePath;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::mutex m_buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::mutex m_writeMutex;
+
+    explicit QmsTraceRecorder(const QString &traceFilePath);
+
+    ThreadBuffer *registerCurrentThread();
+
+    static void writeEscaped(std::FILE *file, const char *text);
+
+    static std::atomic<bool> s_enabled;
+    static thread_local ThreadBuffer *s_currentThreadBuffer;
+    static const size_t s_MAXIMUM_EVENTS_PER_THREAD;
+};
+
+extern std::atomic<QmsTraceRecorder *> traceRecorder;
+
+#endif //QMINESWEEPER_QMSTRACERECORDER_HPP
@@ -0,0 +1,174 @@
+#include "QmsUndoLog.hpp"
+
+#include <utility>
+
+QmsStateDelta::QmsStateDelta(const QmsGameCounters &counters) :
+        m_counters(counters),
+        m_bytes{},
+        m_lastCellIndex{0},
+        m_cellCount{0} {
+
+}
+
+void QmsStateDelta::appendCell(int cellIndex, QmsCellState cellState) {
+    QmsVarInt::encodeSigned(this->m_bytes, static_cast<int64_t>(cellIndex) - this->m_lastCellIndex);
+    this->m_bytes.push_back(cellState.bits());
+    this->m_lastCellIndex = cellIndex;
+    this->m_cellCount++;
+}
+
+void QmsStateDelta::shrinkToFit() {
+    this->m_bytes.shrink_to_fit();
+}
+
+const QmsGameCounters &QmsStateDelta::counters() const {
+    return this->m_counters;
+}
+
+int QmsStateDelta::cellCount() const {
+    return this->m_cellCount;
+}
+
+size_t QmsStateDelta::byteCount() const {
+    return sizeof(QmsStateDelta) + this->m_bytes.capacity();
+}
+
+bool QmsStateDelta::isEmpty() const {
+    return this->m_cellCount == 0;
+}
+
+QmsUndoLog::QmsUndoLog() :
+        m_undoStack{},
+        m_redoStack{},
+        m_pendingAction{QmsGameCounters{0, 0, 0}},
+        m_isRecording{false} {
+
+}
+
+QmsUndoLog &QmsUndoLog::operator=(const QmsUndoLog &rhs) {
+    if (this != &rhs) {
+        QmsUndoLog::release(this->m_undoStack);
+        QmsUndoLog::release(this->m_redoStack);
+        this->m_undoStack = rhs.m_undoStack;
+        this->m_redoStack = rhs.m_redoStack;
+        this->m_pendingAction = rhs.m_pendingAction;
+        this->m_isRecording = rhs.m_isRecording;
+    }
+    return *this;
+}
+
+QmsUndoLog &QmsUndoLog::operator=(QmsUndoLog &&rhs) noexcept {
+    if (this != &rhs) {
+        QmsUndoLog::release(this->m_undoStack);
+        QmsUndoLog::release(this->m_redoStack);
+        this->m_undoStack = std::move(rhs.m_undoStack);
+        this->m_redoStack = std::move(rhs.m_redoStack);
+        this->m_pendingAction = std::move(rhs.m_pendingAction);
+        this->m_isRecording = rhs.m_isRecording;
+    }
+    return *this;
+}
+
+QmsUndoLog::~QmsUndoLog() {
+    QmsUndoLog::release(this->m_undoStack);
+    QmsUndoLog::release(this->m_redoStack);
+}
+
+void QmsUndoLog::beginAction(const QmsGameCounters &counters) {
+    this->m_pendingAction = QmsStateDelta{counters};
+    this->m_isRecording = true;
+}
+
+void QmsUndoLog::recordCell(int cellIndex, QmsCellState previousState) {
+    if (this->m_isRecording) {
+        this->m_pendingAction.appendCell(cellIndex, previousState);
+    }
+}
+
+/* commitAction() : Closes the open action. Only an action that actually changed a cell
+ * is pushed (clicks on revealed cells, explosions, etc change nothing that can be undone),
+ * and pushing a new action invalidates everything that could have been redone */
+bool QmsUndoLog::commitAction() {
+    if (!this->m_isRecording) {
+        return false;
+    }
+    this->m_isRecording = false;
+    if (this->m_pendingAction.isEmpty()) {
+        return false;
+    }
+    this->m_pendingAction.shrinkToFit();
+    QmsUndoLog::push(this->m_undoStack, std::move(this->m_pendingAction));
+    QmsUndoLog::release(this->m_redoStack);
+    this->m_pendingAction = QmsStateDelta{QmsGameCounters{0, 0, 0}};
+    return true;
+}
+
+bool QmsUndoLog::isRecording() const {
+    return this->m_isRecording;
+}
+
+bool QmsUndoLog::canUndo() const {
+    return (this->m_undoStack != nullptr);
+}
+
+bool QmsUndoLog::canRedo() const {
+    return (this->m_redoStack != nullptr);
+}
+
+QmsStateDelta QmsUndoLog::takeUndo() {
+    return QmsUndoLog::pop(this->m_undoStack);
+}
+
+QmsStateDelta QmsUndoLog::takeRedo() {
+    return QmsUndoLog::pop(this->m_redoStack);
+}
+
+void QmsUndoLog::pushUndo(QmsStateDelta delta) {
+    QmsUndoLog::push(this->m_undoStack, std::move(delta));
+}
+
+void QmsUndoLog::pushRedo(QmsStateDelta delta) {
+    QmsUndoLog::push(this->m_redoStack, std::move(delta));
+}
+
+void QmsUndoLog::clear() {
+    QmsUndoLog::release(this->m_undoStack);
+    QmsUndoLog::release(this->m_redoStack);
+    this->m_isRecording = false;
+}
+
+/* byteCount() : Counts everything reachable from this log, including
+ * the entries it shares with snapshots of the game */
+size_t QmsUndoLog::byteCount() const {
+    size_t total{0};
+    for (const StackEntry *entry = this->m_undoStack.get(); entry != nullptr; entry = entry->below.get()) {
+        total += entry->delta.byteCount();
+    }
+    for (const StackEntry *entry = this->m_redoStack.get(); entry != nullptr; entry = entry->below.get()) {
+        total += entry->delta.byteCount();
+    }
+    return total;
+}
+
+/* pop() : The entry may still be on the stack of a snapshot, so its delta is copied,
+ * which costs no more than applying it does */
+QmsStateDelta QmsUndoLog::pop(std::shared_ptr<const StackEntry> &stack) {
+    QmsStateDelta delta{stack->delta};
+    std::shared_ptr<const StackEntry> below{stack->below};
+    stack = std::move(below);
+    return delta;
+}
+
+void QmsUndoLog::push(std::shared_ptr<const StackEntry> &stack, QmsStateDelta delta) {
+    stack = std::make_shared<const StackEntry>(StackEntry{std::move(delta), std::move(stack)});
+}
+
+/* release() : Drops a stack one entry at a time, stopping at the first entry a snapshot
+ * still holds, as letting the shared_ptrs free a long history would recurse once per move */
+void QmsUndoLog::release(std::shared_ptr<const StackEntry> &stack) {
+    while ((stack != nullptr) && (stack.use_count() == 1)) {
+        std::shared_ptr<const StackEntry> below{stack->below};
+        stack = std::move(below);
+    }
+    stack.reset();
+}
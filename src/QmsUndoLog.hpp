@@ -0,0 +1,106 @@
+#ifndef QMINESWEEPER_QMSUNDOLOG_HPP
+#define QMINESWEEPER_QMSUNDOLOG_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "QmsCellState.hpp"
+#include "QmsVarInt.hpp"
+
+/* QmsGameCounters : The counters that change along with the cells during a move */
+struct QmsGameCounters {
+    int userDisplayNumberOfMines;
+    int numberOfMovesMade;
+    int unopenedMineCount;
+};
+
+/* QmsStateDelta : One player action, stored as the counters and the cell states from
+ * before the action. Cells are a varint stream of (zigzag index delta, state byte) pairs,
+ * so a cascade, which walks neighboring cells, costs about two bytes per cell no matter
+ * how large the board is. Applying a delta yields its inverse with the same cell order */
+class QmsStateDelta {
+public:
+    explicit QmsStateDelta(const QmsGameCounters &counters);
+
+    QmsStateDelta(const QmsStateDelta &rhs) = default;
+    QmsStateDelta(QmsStateDelta &&rhs) noexcept = default;
+    QmsStateDelta &operator=(const QmsStateDelta &rhs) = default;
+    QmsStateDelta &operator=(QmsStateDelta &&rhs) noexcept = default;
+    ~QmsStateDelta() = default;
+
+    void appendCell(int cellIndex, QmsCellState cellState);
+    void shrinkToFit();
+    const QmsGameCounters &counters() const;
+    int cellCount() const;
+    size_t byteCount() const;
+    bool isEmpty() const;
+
+    template<typename Function>
+    void forEachCell(Function function) const {
+        const uint8_t *cursor{this->m_bytes.data()};
+        const uint8_t *end{cursor + this->m_bytes.size()};
+        int64_t cellIndex{0};
+        int64_t indexDelta{0};
+        while ((cursor != end) && QmsVarInt::decodeSigned(cursor, end, indexDelta) && (cursor != end)) {
+            cellIndex += indexDelta;
+            function(static_cast<int>(cellIndex), QmsCellState{*cursor++});
+        }
+    }
+
+private:
+    QmsGameCounters m_counters;
+    std::vector<uint8_t> m_bytes;
+    int m_lastCellIndex;
+    int m_cellCount;
+};
+
+/* QmsUndoLog : Unbounded undo and redo stacks of QmsStateDeltas. GameController opens an
+ * action before handling a click, every cell change made while it is open is recorded with
+ * the state it had before, and the action is committed (or dropped, if nothing changed)
+ * once the click has been fully handled, including any cascade it caused. The stacks are
+ * persistent lists whose entries never change once pushed, so copying a log (as every
+ * snapshot of the game does) is O(1) and shares the whole history, and a push or pop on
+ * one copy never copies what is below it */
+class QmsUndoLog {
+public:
+    QmsUndoLog();
+    QmsUndoLog(const QmsUndoLog &rhs) = default;
+    QmsUndoLog(QmsUndoLog &&rhs) noexcept = default;
+    QmsUndoLog &operator=(const QmsUndoLog &rhs);
+    QmsUndoLog &operator=(QmsUndoLog &&rhs) noexcept;
+    ~QmsUndoLog();
+
+    void beginAction(const QmsGameCounters &counters);
+    void recordCell(int cellIndex, QmsCellState previousState);
+    bool commitAction();
+    bool isRecording() const;
+
+    bool canUndo() const;
+    bool canRedo() const;
+    QmsStateDelta takeUndo();
+    QmsStateDelta takeRedo();
+    void pushUndo(QmsStateDelta delta);
+    void pushRedo(QmsStateDelta delta);
+    void clear();
+
+    size_t byteCount() const;
+
+private:
+    struct StackEntry {
+        QmsStateDelta delta;
+        std::shared_ptr<const StackEntry> below;
+    };
+
+    std::shared_ptr<const StackEntry> m_undoStack;
+    std::shared_ptr<const StackEntry> m_redoStack;
+    QmsStateDelta m_pendingAction;
+    bool m_isRecording;
+
+    static QmsStateDelta pop(std::shared_ptr<const StackEntry> &stack);
+    static void push(std::shared_ptr<const StackEntry> &stack, QmsStateDelta delta);
+    static void release(std::shared_ptr<const StackEntry> &stack);
+};
+
+#endif //QMINESWEEPER_QMSUNDOLOG_HPP
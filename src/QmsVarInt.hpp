@@ -0,0 +1,59 @@
+#ifndef QMINESWEEPER_QMSVARINT_HPP
+#define QMINESWEEPER_QMSVARINT_HPP
+
+#include <cstdint>
+#include <vector>
+
+/* QmsVarInt : LEB128 style variable length integers, 7 bits per byte with the high bit
+ * set on every byte but the last. Signed values go through a zigzag mapping first, so
+ * small negative numbers (like the distance back to a previous cell) stay small */
+namespace QmsVarInt {
+
+    inline uint64_t zigzagEncode(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t zigzagDecode(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    inline void encode(std::vector<uint8_t> &output, uint64_t value) {
+        while (value >= 0x80) {
+            output.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline void encodeSigned(std::vector<uint8_t> &output, int64_t value) {
+        encode(output, zigzagEncode(value));
+    }
+
+    /* decode() : Reads one value starting at cursor, and advances cursor past it.
+     * Returns false (leaving value untouched) if the input ends in the middle of a
+     * value or the value does not fit in 64 bits, so untrusted input is safe to read */
+    inline bool decode(const uint8_t *&cursor, const uint8_t *end, uint64_t &value) {
+        uint64_t result{0};
+        for (unsigned int shift = 0; (cursor != end) && (shift < 64); shift += 7) {
+            const uint8_t byte{*cursor++};
+            result |= (static_cast<uint64_t>(byte & 0x7F) << shift);
+            if ((byte & 0x80) == 0) {
+                value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool decodeSigned(const uint8_t *&cursor, const uint8_t *end, int64_t &value) {
+        uint64_t rawValue{0};
+        if (!decode(cursor, end, rawValue)) {
+            return false;
+        }
+        value = zigzagDecode(rawValue);
+        return true;
+    }
+
+}
+
+#endif //QMINESWEEPER_QMSVARINT_HPP
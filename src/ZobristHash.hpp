@@ -0,0 +1,62 @@
+#ifndef QMINESWEEPER_ZOBRISTHASH_HPP
+#define QMINESWEEPER_ZOBRISTHASH_HPP
+
+#include <cstdint>
+
+#include "QmsCellState.hpp"
+
+/* ZobristHash : Incrementally maintained 64-bit hash of a board position.
+ * Every (cell, visibility) pair and every (cell, mine) pair owns a pseudo-random key,
+ * and the hash is the XOR of the keys that are currently "on". Covered cells contribute
+ * nothing, so a fresh board always hashes to zero and every change is a pair of XORs.
+ * The keys are derived on the fly (splitmix64) instead of being stored in a table,
+ * so resizing the board never has to regenerate anything */
+class ZobristHash {
+public:
+    ZobristHash() :
+            m_value{0} {
+
+    }
+
+    inline uint64_t value() const {
+        return this->m_value;
+    }
+
+    inline void reset() {
+        this->m_value = 0;
+    }
+
+    inline void changeCell(int cellIndex, CellVisibility from, CellVisibility to) {
+        if (from == to) {
+            return;
+        }
+        this->toggleCell(cellIndex, from);
+        this->toggleCell(cellIndex, to);
+    }
+
+    inline void toggleCell(int cellIndex, CellVisibility visibility) {
+        if (visibility != CellVisibility::Covered) {
+            this->m_value ^= key(cellIndex, static_cast<uint64_t>(visibility));
+        }
+    }
+
+    inline void toggleMine(int cellIndex) {
+        this->m_value ^= key(cellIndex, MINE_KEY_SLOT);
+    }
+
+    static inline uint64_t key(int cellIndex, uint64_t slot) {
+        uint64_t z{((static_cast<uint64_t>(static_cast<uint32_t>(cellIndex)) << KEY_SLOT_BITS) | slot) + KEY_SEED};
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t m_value;
+
+    static const uint64_t constexpr KEY_SLOT_BITS{3};
+    static const uint64_t constexpr MINE_KEY_SLOT{4};
+    static const uint64_t constexpr KEY_SEED{0x9E3779B97F4A7C15ULL};
+};
+
+#endif //QMINESWEEPER_ZOBRISTHASH_HPP